@@ -0,0 +1,393 @@
+/**
+ * @file genesis.h
+ * @brief Host-native stand-in for SGDK's main header (`make host` builds only).
+ *
+ * Declares the subset of SGDK used by this project so the sources in src/ can
+ * be compiled for the build machine and run without an emulator. The VDP is
+ * modelled as plain memory (VRAM, CRAM, VSRAM, scroll tables and the sprite
+ * engine's sprite list) in host_vdp.c; `host_vdp_render()` turns that state
+ * into an RGB frame and host_png.c writes it out as a PNG.
+ *
+ * Types, constants and function signatures follow SGDK so code that builds
+ * here builds for the Mega Drive too. Timing-only features (DMA, interrupts,
+ * the Z80 sound drivers) are accepted and ignored; every transfer happens
+ * immediately. `SYS_doVBlankProcess()` and `VDP_waitVSync()` advance the
+ * simulated frame counter (see host_main.c).
+ */
+#ifndef HOST_GENESIS_H
+#define HOST_GENESIS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef HOST_BUILD
+#define HOST_BUILD
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Types
+//--------------------------------------------------------------------------------------------------
+
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef volatile u8 vu8;
+typedef volatile u16 vu16;
+typedef volatile u32 vu32;
+typedef u8 bool;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+/** @brief How data reaches VRAM/CRAM/VSRAM. The host always copies immediately. */
+typedef enum {
+    CPU,
+    DMA,
+    DMA_QUEUE,
+    DMA_QUEUE_COPY
+} TransferMethod;
+
+/** @brief Background planes. */
+typedef enum {
+    BG_A,
+    BG_B,
+    WINDOW
+} VDPPlane;
+
+typedef struct {
+    u16 length;
+    u16* data;
+} Palette;
+
+/** @brief Resource compression; host resources are never compressed. */
+#define COMPRESSION_NONE 0
+
+typedef struct {
+    u16 compression;
+    u16 numTile;
+    u32* tiles; // 8 u32 per tile, one per pixel row, leftmost pixel in the high nibble
+} TileSet;
+
+typedef struct {
+    u16 compression;
+    u16 w;
+    u16 h;
+    u16* tilemap; // Row-major tile attributes, added to the base tile when drawn
+} TileMap;
+
+typedef struct {
+    Palette* palette;
+    TileSet* tileset;
+    TileMap* tilemap;
+} Image;
+
+/** @brief PCM sample resource as used by pcm_player.c. */
+typedef struct {
+    const u8* data;
+    u32 len;
+    u16 rate;
+} PCM;
+
+//--------------------------------------------------------------------------------------------------
+// Sprite engine types (SGDK 1.7x layout, reduced to what the host renders)
+//--------------------------------------------------------------------------------------------------
+
+typedef struct {
+    u16 numSprite;
+    void* vdpSpritesInf;
+    void* collision;
+    TileSet* tileset; // Frame tiles, column-major like VDP sprite patterns
+    s16 w;            // Frame size in pixels
+    s16 h;
+    u16 timer;
+} AnimationFrame;
+
+typedef struct {
+    u16 numFrame;
+    AnimationFrame** frames;
+    u16 length;
+    u8* sequence;
+    s16 loop;
+} Animation;
+
+typedef struct {
+    Palette* palette;
+    u16 numAnimation;
+    Animation** animations;
+    u16 maxNumTile;
+    u16 maxNumSprite;
+} SpriteDefinition;
+
+typedef enum {
+    VISIBLE,
+    HIDDEN,
+    AUTO_FAST,
+    AUTO_SLOW
+} SpriteVisibility;
+
+typedef struct Sprite {
+    u16 status;       // SPR_FLAG_* plus internal bits
+    u16 visibility;
+    const SpriteDefinition* definition;
+    Animation* animation;
+    AnimationFrame* frame;
+    s16 animInd;
+    s16 frameInd;
+    u16 timer;
+    s16 x;            // Screen position in pixels
+    s16 y;
+    s16 depth;        // Lower depth is drawn in front
+    u16 attribut;     // TILE_ATTR_FULL(); the tile index is only used without SPR_FLAG_AUTO_TILE_UPLOAD
+    struct Sprite* next;
+} Sprite;
+
+#define SPR_FLAG_INSERT_HEAD                    0x4000
+#define SPR_FLAG_DISABLE_DELAYED_FRAME_UPDATE   0x2000
+#define SPR_FLAG_AUTO_VISIBILITY                0x1000
+#define SPR_FLAG_FAST_AUTO_VISIBILITY           0x0800
+#define SPR_FLAG_AUTO_VRAM_ALLOC                0x0400
+#define SPR_FLAG_AUTO_SPRITE_ALLOC              0x0200
+#define SPR_FLAG_AUTO_TILE_UPLOAD               0x0100
+#define SPR_FLAG_MASK                           0x7F00
+
+#define SPR_MIN_DEPTH (-0x8000)
+#define SPR_MAX_DEPTH 0x7FFF
+
+//--------------------------------------------------------------------------------------------------
+// Constants
+//--------------------------------------------------------------------------------------------------
+
+#define PAL0 0
+#define PAL1 1
+#define PAL2 2
+#define PAL3 3
+
+#define TILE_SIZE               32
+#define TILE_MAX_NUM            (0x10000 / TILE_SIZE)
+#define TILE_SYSTEM_INDEX       0x0000
+#define TILE_SYSTEM_LENGTH      16
+#define TILE_USER_INDEX         (TILE_SYSTEM_INDEX + TILE_SYSTEM_LENGTH)
+#define FONT_LEN                96
+/** @brief Font tiles sit just below the window plane (VRAM 0xB000). */
+#define TILE_FONT_INDEX         ((0xB000 / TILE_SIZE) - FONT_LEN)
+#define TILE_USER_MAX_INDEX     (TILE_FONT_INDEX - 1)
+
+#define TILE_ATTR_PRIORITY_MASK 0x8000
+#define TILE_ATTR_PALETTE_MASK  0x6000
+#define TILE_ATTR_VFLIP_MASK    0x1000
+#define TILE_ATTR_HFLIP_MASK    0x0800
+#define TILE_INDEX_MASK         0x07FF
+
+#define TILE_ATTR(pal, prio, flipV, flipH) \
+    (((flipH) << 11) + ((flipV) << 12) + ((pal) << 13) + ((prio) << 15))
+#define TILE_ATTR_FULL(pal, prio, flipV, flipH, index) \
+    (((flipH) << 11) + ((flipV) << 12) + ((pal) << 13) + ((prio) << 15) + (index))
+
+/** @brief Converts a 0xRRGGBB color to the VDP's 9-bit 0x0BGR format. */
+#define RGB24_TO_VDPCOLOR(color) \
+    ((((color) >> 20) & 0x00E) | ((((color) >> 12) & 0x00E) << 4) | ((((color) >> 4) & 0x00E) << 8))
+
+#define BUTTON_UP     0x0001
+#define BUTTON_DOWN   0x0002
+#define BUTTON_LEFT   0x0004
+#define BUTTON_RIGHT  0x0008
+#define BUTTON_B      0x0010
+#define BUTTON_C      0x0020
+#define BUTTON_A      0x0040
+#define BUTTON_START  0x0080
+#define BUTTON_Z      0x0100
+#define BUTTON_Y      0x0200
+#define BUTTON_X      0x0400
+#define BUTTON_MODE   0x0800
+#define BUTTON_DIR    0x000F
+#define BUTTON_BTN    0x0FF0
+#define BUTTON_ALL    0x0FFF
+
+#define JOY_1 0
+#define JOY_2 1
+
+/** @brief Ticks per second reported by getTick(). */
+#define TICKPERSECOND 300
+/** @brief Tick rate used by this project's `SYS_getTime()` calls (one tick per frame). */
+#define SGDK_TIMER_NORMAL_DIV 60
+
+#define SND_PAN_LEFT    0x80
+#define SND_PAN_RIGHT   0x40
+#define SND_PAN_CENTER  0xC0
+
+/** @brief The host always simulates an NTSC console. */
+#define IS_PALSYSTEM 0
+
+//--------------------------------------------------------------------------------------------------
+// System
+//--------------------------------------------------------------------------------------------------
+
+typedef void VoidCallback(void);
+
+/** @brief Frame counter, incremented once per simulated VBlank. */
+extern vu32 vtimer;
+
+/** @brief Simulated VDP V counter. The host has no beam, so it reports the line VBlank starts on. */
+u16 host_get_vcounter();
+#define GET_VCOUNTER host_get_vcounter()
+
+void SGDK_init();
+void SYS_doVBlankProcess();
+void SYS_disableInts();
+void SYS_enableInts();
+void SYS_setVIntCallback(VoidCallback* callback);
+void SYS_setVBlankCallback(VoidCallback* callback);
+void SYS_setHIntCallback(VoidCallback* callback);
+u32 SYS_getTime();
+u32 getTick();
+
+void KLog(const char* text);
+
+/**
+ * @brief SGDK-compatible sprintf: `%l` conversions take 32-bit arguments, as
+ *        they do on the 68000, so u32 values print correctly on 64-bit hosts.
+ */
+int host_sprintf(char* buffer, const char* format, ...);
+#define sprintf host_sprintf
+
+//--------------------------------------------------------------------------------------------------
+// Memory (dynamic allocation from a simulated heap of HOST_HEAP_SIZE bytes)
+//--------------------------------------------------------------------------------------------------
+
+/** @brief Heap size reported by MEM_getFree() after SGDK_init(), close to a real SGDK ROM's. */
+#define HOST_HEAP_SIZE 0xA000
+
+u16 MEM_getFree();
+u16 MEM_getAllocated();
+void* MEM_alloc(u16 size);
+void MEM_free(void* ptr);
+
+//--------------------------------------------------------------------------------------------------
+// Input
+//--------------------------------------------------------------------------------------------------
+
+void JOY_init();
+u16 JOY_readJoypad(u16 joy);
+
+//--------------------------------------------------------------------------------------------------
+// VDP
+//--------------------------------------------------------------------------------------------------
+
+void VDP_waitVSync();
+void VDP_waitDMACompletion();
+void VDP_setPlaneSize(u16 w, u16 h, u16 setupVram);
+u16 VDP_getPlaneWidth();
+u16 VDP_getPlaneHeight();
+void VDP_setHIntCounter(u16 value);
+void VDP_setHInterrupt(u16 value);
+void VDP_setBackgroundColor(u16 index);
+
+// Tiles and planes
+u16 VDP_loadTileSet(const TileSet* tileset, u16 index, TransferMethod tm);
+void VDP_loadTileData(const u32* data, u16 index, u16 num, TransferMethod tm);
+void VDP_fillTileData(u8 value, u16 index, u16 num, u16 wait);
+void VDP_clearPlane(VDPPlane plane, u16 wait);
+void VDP_setTileMapXY(VDPPlane plane, u16 tile, u16 x, u16 y);
+u16 VDP_getTileMapXY(VDPPlane plane, u16 x, u16 y);
+void VDP_fillTileMapRect(VDPPlane plane, u16 tile, u16 x, u16 y, u16 w, u16 h);
+void VDP_setTileMapData(u16 plane_addr, const u16* data, u16 index, u16 num, TransferMethod tm);
+void VDP_setTileMapDataRect(VDPPlane plane, const u16* data, u16 x, u16 y, u16 w, u16 h, u16 wm, TransferMethod tm);
+void VDP_setTileMapDataRectEx(VDPPlane plane, const u16* data, u16 basetile, u16 x, u16 y, u16 w, u16 h, u16 wm,
+                              TransferMethod tm);
+u16 VDP_setTileMapEx(VDPPlane plane, const TileMap* tilemap, u16 basetile, u16 x, u16 y, u16 xm, u16 ym, u16 w,
+                     u16 h, TransferMethod tm);
+
+/** @brief VRAM addresses of the planes, for VDP_setTileMapData(). */
+#define VDP_BG_A 0xC000
+#define VDP_BG_B 0xE000
+#define VDP_WINDOW 0xB000
+
+// Scrolling
+#define HSCROLL_PLANE 0
+#define HSCROLL_TILE 2
+#define HSCROLL_LINE 3
+#define VSCROLL_PLANE 0
+#define VSCROLL_COLUMN 1
+void VDP_setScrollingMode(u16 hscroll, u16 vscroll);
+u16 VDP_getHScrollTableAddress();
+void VDP_setHorizontalScroll(VDPPlane plane, s16 value);
+void VDP_setVerticalScroll(VDPPlane plane, s16 value);
+
+// Window plane
+void VDP_setWindowHPos(u16 right, u16 pos);
+void VDP_setWindowVPos(u16 down, u16 pos);
+
+// Text
+u16 VDP_getFontTileInd();
+void VDP_setTextPalette(u16 palette);
+void VDP_setTextPriority(u16 prio);
+void VDP_drawText(const char* str, u16 x, u16 y);
+void VDP_drawTextBG(VDPPlane plane, const char* str, u16 x, u16 y);
+void VDP_drawTextEx(VDPPlane plane, const char* str, u16 basetile, u16 x, u16 y, TransferMethod tm);
+void VDP_clearText(u16 x, u16 y, u16 w);
+void VDP_clearTextBG(VDPPlane plane, u16 x, u16 y, u16 w);
+
+// Palettes
+void VDP_setPalette(u16 num, const u16* pal);
+void VDP_getPalette(u16 num, u16* pal);
+void VDP_setPaletteColor(u16 index, u16 value);
+u16 VDP_getPaletteColor(u16 index);
+void VDP_setPaletteColors(u16 index, const u16* values, u16 count);
+void VDP_getPaletteColors(u16 index, u16* dest, u16 count);
+void VDP_fadeOutAll(u16 numframe, u8 async);
+void VDP_fadeInAll(const u16* pal, u16 numframe, u8 async);
+
+// DMA queue (transfers are immediate on the host, so the queue is always empty)
+#define DMA_VRAM  0
+#define DMA_CRAM  1
+#define DMA_VSRAM 2
+u16 DMA_getQueueTransferSize();
+/** @brief Copies `len` words at once; `from` is read as native u16 words (colors, tilemaps, scroll values). */
+bool DMA_queueDma(u8 location, void* from, u16 to, u16 len, u16 step);
+
+//--------------------------------------------------------------------------------------------------
+// Sprite engine
+//--------------------------------------------------------------------------------------------------
+
+void SPR_init();
+void SPR_end();
+Sprite* SPR_addSprite(const SpriteDefinition* spriteDef, s16 x, s16 y, u16 attribut);
+Sprite* SPR_addSpriteEx(const SpriteDefinition* spriteDef, s16 x, s16 y, u16 attribut, u16 spriteIndex, u16 flag);
+void SPR_releaseSprite(Sprite* sprite);
+void SPR_setPosition(Sprite* sprite, s16 x, s16 y);
+s16 SPR_getPositionX(const Sprite* sprite);
+s16 SPR_getPositionY(const Sprite* sprite);
+void SPR_setAnim(Sprite* sprite, s16 anim);
+void SPR_setFrame(Sprite* sprite, s16 frame);
+void SPR_setAnimAndFrame(Sprite* sprite, s16 anim, s16 frame);
+void SPR_setVisibility(Sprite* sprite, SpriteVisibility value);
+void SPR_setDepth(Sprite* sprite, s16 value);
+void SPR_setVRAMTileIndex(Sprite* sprite, s16 value);
+void SPR_setAutoTileUpload(Sprite* sprite, u16 value);
+u16 SPR_getNumActiveSprite();
+u16 SPR_getUsedVDPSprite();
+u16 SPR_getFreeVRAM();
+bool SPR_isInitialized();
+void SPR_update();
+
+//--------------------------------------------------------------------------------------------------
+// Sound (accepted and ignored)
+//--------------------------------------------------------------------------------------------------
+
+void SND_startPlay_PCM(const u8* sample, u32 len, u16 rate, u8 pan, u8 loop);
+void XGM_init();
+void XGM_startPlay(const u8* song);
+void XGM_stopPlay();
+u8 XGM_isPlaying();
+void XGM_update();
+
+#endif // HOST_GENESIS_H
@@ -0,0 +1,30 @@
+/**
+ * @file host_system.h
+ * @brief Simulated frame clock and joypad for the host build (`make host` builds only).
+ */
+#ifndef HOST_SYSTEM_H
+#define HOST_SYSTEM_H
+
+#include "genesis.h"
+
+/** @brief Called after every simulated VBlank, with `vtimer` already incremented. */
+typedef void HostFrameCallback(u32 frame);
+
+/**
+ * @brief Ends the current frame for VDP_waitVSync(): increments `vtimer`, steps
+ *        palette fades, runs the V-int callback, then the frame callback.
+ *        SYS_doVBlankProcess() does the same and also runs the VBlank process
+ *        callback (SYS_setVBlankCallback()) before the frame callback.
+ */
+void host_vblank();
+
+/** @brief Installs the host runner's per-frame callback (NULL to remove). */
+void host_set_frame_callback(HostFrameCallback* callback);
+
+/** @brief Sets the value JOY_readJoypad(JOY_1) returns from now on. */
+void host_set_joypad(u16 buttons);
+
+/** @brief When FALSE, KLog() output is discarded (e.g. for quiet benchmark runs). */
+void host_set_klog_enabled(u8 enabled);
+
+#endif // HOST_SYSTEM_H
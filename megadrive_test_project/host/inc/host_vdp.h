@@ -0,0 +1,95 @@
+/**
+ * @file host_vdp.h
+ * @brief Inspection and rendering of the simulated VDP (`make host` builds only).
+ *
+ * The SGDK calls declared in genesis.h operate on the state below. Host tools
+ * and the host runner use these functions to look at that state directly or
+ * to render the current frame.
+ */
+#ifndef HOST_VDP_H
+#define HOST_VDP_H
+
+#include "genesis.h"
+
+#define HOST_SCREEN_WIDTH 320
+#define HOST_SCREEN_HEIGHT 224
+
+/** @brief Maximum sprites the simulated sprite engine can hold (VDP limit). */
+#define HOST_SPR_MAX 80
+/** @brief Sprites the VDP can show on one scanline in H40 mode. */
+#define HOST_SPR_MAX_PER_LINE 20
+/** @brief Tiles of sprite VRAM SPR_init() reserves, as in SGDK. */
+#define HOST_SPR_VRAM_TILES 420
+/** @brief Heap bytes SPR_init() takes for the sprite bank (roughly what SGDK allocates). */
+#define HOST_SPR_HEAP_BYTES (HOST_SPR_MAX * 48)
+
+/** @brief Simulated VDP memories and registers. */
+typedef struct {
+    u16 vram[0x8000];        // 64KB, addressed in words (tile n starts at word n * 16)
+    u16 cram[64];            // 4 palettes of 16 colors, 0x0BGR
+    s16 vscroll[2][20];      // Per 2-tile column, for BG_A / BG_B
+    s16 hscroll[2][HOST_SCREEN_HEIGHT]; // Per line, for BG_A / BG_B, read from the VRAM table when rendering
+    u16 hscroll_mode;        // HSCROLL_PLANE, HSCROLL_TILE or HSCROLL_LINE
+    u16 window_down;         // Window covers the rows from `window_vpos` down (TRUE) or above it (FALSE)
+    u16 window_vpos;         // Window boundary in tile rows (0 and not down: no window)
+    u16 hint_enabled;        // H-interrupt on (VDP_setHInterrupt())
+    u16 hint_counter;        // H-int counter register: fires every (value + 1) lines
+    u16 port_code;           // Target of the last command written to the control port
+    u16 port_address;        // Byte address the next data port write goes to
+    u16 port_autoinc;        // Auto-increment register
+    u16 plane_w;             // Plane size in tiles (32, 64 or 128)
+    u16 plane_h;
+    u16 background_index;    // CRAM index of the backdrop color
+    u16 text_attr;           // Palette and priority used by VDP_drawText()
+} HostVdpState;
+
+/** @brief Restores power-on state and loads the font tiles. Called by SGDK_init(). */
+void host_vdp_reset();
+
+/** @brief Advances palette fades by one frame. Called on every simulated VBlank. */
+void host_vdp_vblank();
+
+/** @brief Direct access to the simulated VDP, e.g. for tests or custom dumps. */
+HostVdpState* host_vdp_state();
+
+/** @brief VRAM address of the simulated horizontal scroll table (224 BG_A/BG_B pairs). */
+#define HOST_HSCROLL_TABLE 0xF000
+
+/** @brief VRAM word address of a plane's tilemap. */
+u16 host_vdp_plane_address(VDPPlane plane);
+
+/**
+ * @brief Renders the current frame: backdrop, both planes and the sprite
+ *        engine's sprites, with priorities and the per-line sprite limit.
+ *        With the H-int on, this is the frame host_vdp_scan() rendered.
+ * @param rgb Output buffer of HOST_SCREEN_WIDTH * HOST_SCREEN_HEIGHT * 3 bytes.
+ */
+void host_vdp_render(u8* rgb);
+
+/**
+ * @brief With the H-int on, renders the frame line by line and calls the H-int
+ *        callback where the counter fires, so mid-frame changes show. Called on
+ *        every simulated VBlank; does nothing while the H-int is off.
+ */
+void host_vdp_scan();
+
+/** @brief Stores the callback SYS_setHIntCallback() installs. */
+void host_vdp_set_hint_callback(VoidCallback* callback);
+
+/**
+ * @brief Writes a word to the VDP control port: register writes (backdrop,
+ *        H-int counter, auto-increment) and CRAM/VSRAM/VRAM write commands.
+ *        For the host stand-ins of assembly interrupt handlers.
+ */
+void host_vdp_write_control(u16 word);
+
+/** @brief Writes a word to the VDP data port at the last command's address. */
+void host_vdp_write_data(u16 word);
+
+/**
+ * @brief Writes an 8-bit RGB image as an uncompressed PNG.
+ * @return TRUE on success.
+ */
+u8 host_png_write(const char* path, const u8* rgb, u16 width, u16 height);
+
+#endif // HOST_VDP_H
@@ -0,0 +1,24 @@
+/**
+ * @file resources.h
+ * @brief Host stand-ins for the rescomp resources (`make host` builds only).
+ *
+ * On the Mega Drive this header is generated by rescomp from res/resources.res.
+ * The host build cannot run rescomp, so host_resources.c provides small
+ * hand-made assets with the same names and types: a 4-tile map tileset,
+ * a two-frame 16x16 player sprite, a striped logo and silent sound data.
+ * The include path puts host/inc first, so this file wins over a generated
+ * inc/resources.h.
+ */
+#ifndef HOST_RESOURCES_H
+#define HOST_RESOURCES_H
+
+#include "genesis.h"
+
+extern const Image tileset_img;
+extern const TileSet my_tileset;
+extern const SpriteDefinition spr_player;
+extern const Image logo_minnka_img;
+extern const PCM sfx_ping_data;
+extern const u8 music_track_res[16];
+
+#endif // HOST_RESOURCES_H
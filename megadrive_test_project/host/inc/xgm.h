@@ -0,0 +1,11 @@
+/**
+ * @file xgm.h
+ * @brief Host stand-in for SGDK's XGM driver header (`make host` builds only).
+ * The XGM functions are declared, and stubbed, in the host genesis.h.
+ */
+#ifndef HOST_XGM_H
+#define HOST_XGM_H
+
+#include "genesis.h"
+
+#endif // HOST_XGM_H
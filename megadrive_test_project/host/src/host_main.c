@@ -0,0 +1,112 @@
+/**
+ * @file host_main.c
+ * @brief Command-line runner for the host build (`make host` builds only).
+ *
+ * The project's main.c is compiled with `-Dmain=host_game_main`, so this file
+ * owns the real `main()`. It parses options, installs a frame callback and
+ * starts the game loop, which never returns; the callback ends the process
+ * once the requested number of frames has run.
+ *
+ * Usage:
+ *   rom_host [--frames N] [--png FRAME:FILE]... [--joy FRAME:MASK]... [--quiet]
+ *
+ *   --frames N        Frames to simulate before exiting (default 600).
+ *   --png FRAME:FILE  Render the frame that just ended at FRAME to a PNG file.
+ *   --joy FRAME:MASK  From FRAME on, Joypad 1 reads MASK (BUTTON_* bits, hex or decimal).
+ *   --quiet           Discard KLog() output.
+ *
+ * At exit the runner prints the simulated frame count and frames per second to stderr.
+ */
+#include "host_system.h"
+#include "host_vdp.h"
+#include <stdlib.h>
+#include <time.h>
+
+#define HOST_MAX_EVENTS 64
+
+int host_game_main();
+
+typedef struct {
+    u32 frame;
+    u16 joypad;
+    const char* png_path; // NULL for joypad events
+} HostEvent;
+
+static HostEvent events[HOST_MAX_EVENTS];
+static u16 event_count = 0;
+static u32 frame_limit = 600;
+static struct timespec start_time;
+
+static double _host_elapsed_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start_time.tv_sec) + (now.tv_nsec - start_time.tv_nsec) / 1e9;
+}
+
+static void _host_write_png(const char* path) {
+    static u8 rgb[HOST_SCREEN_WIDTH * HOST_SCREEN_HEIGHT * 3];
+    host_vdp_render(rgb);
+    if (!host_png_write(path, rgb, HOST_SCREEN_WIDTH, HOST_SCREEN_HEIGHT)) {
+        fprintf(stderr, "host: could not write %s\n", path);
+    }
+}
+
+static void _host_on_frame(u32 frame) {
+    for (u16 i = 0; i < event_count; i++) {
+        if (events[i].frame != frame) continue;
+        if (events[i].png_path != NULL) _host_write_png(events[i].png_path);
+        else host_set_joypad(events[i].joypad);
+    }
+
+    if (frame >= frame_limit) {
+        double seconds = _host_elapsed_seconds();
+        fprintf(stderr, "host: %u frames in %.3fs (%.0f fps)\n", frame, seconds,
+                seconds > 0 ? frame / seconds : 0.0);
+        exit(0);
+    }
+}
+
+static void _host_usage(const char* program) {
+    fprintf(stderr, "usage: %s [--frames N] [--png FRAME:FILE]... [--joy FRAME:MASK]... [--quiet]\n", program);
+    exit(2);
+}
+
+// Parses "FRAME:VALUE" into an event. Returns the VALUE part.
+static const char* _host_parse_event(const char* arg, const char* program) {
+    char* rest;
+    if (event_count >= HOST_MAX_EVENTS) _host_usage(program);
+    events[event_count].frame = strtoul(arg, &rest, 10);
+    if (*rest != ':') _host_usage(program);
+    return rest + 1;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frame_limit = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+            events[event_count].png_path = _host_parse_event(argv[++i], argv[0]);
+            event_count++;
+        } else if (strcmp(argv[i], "--joy") == 0 && i + 1 < argc) {
+            const char* mask = _host_parse_event(argv[++i], argv[0]);
+            events[event_count].png_path = NULL;
+            events[event_count].joypad = strtoul(mask, NULL, 0);
+            event_count++;
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            host_set_klog_enabled(FALSE);
+        } else {
+            _host_usage(argv[0]);
+        }
+    }
+
+    host_vdp_reset();
+    host_set_frame_callback(_host_on_frame);
+    // Joypad events for frame 0 apply before the first input_update().
+    for (u16 i = 0; i < event_count; i++) {
+        if (events[i].frame == 0 && events[i].png_path == NULL) host_set_joypad(events[i].joypad);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    host_game_main();
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file host_png.c
+ * @brief Minimal PNG writer for host frame dumps (`make host` builds only).
+ *
+ * Writes 8-bit RGB images using stored (uncompressed) deflate blocks, so no
+ * zlib is needed. A 320x224 frame is about 210KB.
+ */
+#include "host_vdp.h"
+#include <stdlib.h> // For malloc, free
+
+#define PNG_STORED_BLOCK_MAX 65535
+
+static u32 crc_table[256];
+static u8 crc_table_ready = FALSE;
+
+static void _png_init_crc_table() {
+    for (u32 n = 0; n < 256; n++) {
+        u32 c = n;
+        for (u16 k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        crc_table[n] = c;
+    }
+    crc_table_ready = TRUE;
+}
+
+static u32 _png_crc_update(u32 crc, const u8* data, u32 length) {
+    for (u32 i = 0; i < length; i++) crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void _png_put_u32(u8* out, u32 value) {
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+static void _png_write_chunk(FILE* file, const char* type, const u8* data, u32 length) {
+    u8 header[8];
+    u8 footer[4];
+    _png_put_u32(header, length);
+    memcpy(&header[4], type, 4);
+    u32 crc = _png_crc_update(0xFFFFFFFFu, (const u8*)type, 4);
+    crc = _png_crc_update(crc, data, length) ^ 0xFFFFFFFFu;
+    _png_put_u32(footer, crc);
+    fwrite(header, 1, 8, file);
+    if (length > 0) fwrite(data, 1, length, file);
+    fwrite(footer, 1, 4, file);
+}
+
+u8 host_png_write(const char* path, const u8* rgb, u16 width, u16 height) {
+    static const u8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    u32 row_bytes = (u32)width * 3 + 1; // Filter byte + pixels
+    u32 raw_size = row_bytes * height;
+    u32 block_count = (raw_size + PNG_STORED_BLOCK_MAX - 1) / PNG_STORED_BLOCK_MAX;
+    u32 idat_size = 2 + raw_size + block_count * 5 + 4; // zlib header, blocks, Adler-32
+
+    if (!crc_table_ready) _png_init_crc_table();
+
+    u8* raw = (u8*)malloc(raw_size);
+    u8* idat = (u8*)malloc(idat_size);
+    FILE* file = fopen(path, "wb");
+    if (raw == NULL || idat == NULL || file == NULL) {
+        free(raw);
+        free(idat);
+        if (file != NULL) fclose(file);
+        return FALSE;
+    }
+
+    for (u16 y = 0; y < height; y++) {
+        raw[y * row_bytes] = 0; // Filter type None
+        memcpy(&raw[y * row_bytes + 1], &rgb[(u32)y * width * 3], (u32)width * 3);
+    }
+
+    // zlib stream of stored deflate blocks
+    u32 pos = 0;
+    idat[pos++] = 0x78;
+    idat[pos++] = 0x01;
+    for (u32 offset = 0; offset < raw_size; offset += PNG_STORED_BLOCK_MAX) {
+        u32 length = raw_size - offset;
+        if (length > PNG_STORED_BLOCK_MAX) length = PNG_STORED_BLOCK_MAX;
+        idat[pos++] = (offset + length >= raw_size) ? 1 : 0; // BFINAL on the last block, BTYPE 00
+        idat[pos++] = length & 0xFF;
+        idat[pos++] = length >> 8;
+        idat[pos++] = ~length & 0xFF;
+        idat[pos++] = (~length >> 8) & 0xFF;
+        memcpy(&idat[pos], &raw[offset], length);
+        pos += length;
+    }
+    u32 a = 1, b = 0;
+    for (u32 i = 0; i < raw_size; i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    _png_put_u32(&idat[pos], (b << 16) | a);
+    pos += 4;
+
+    u8 ihdr[13];
+    _png_put_u32(&ihdr[0], width);
+    _png_put_u32(&ihdr[4], height);
+    ihdr[8] = 8;  // Bit depth
+    ihdr[9] = 2;  // Color type: RGB
+    ihdr[10] = 0; // Compression
+    ihdr[11] = 0; // Filter
+    ihdr[12] = 0; // Interlace
+
+    fwrite(signature, 1, sizeof(signature), file);
+    _png_write_chunk(file, "IHDR", ihdr, sizeof(ihdr));
+    _png_write_chunk(file, "IDAT", idat, pos);
+    _png_write_chunk(file, "IEND", NULL, 0);
+
+    u8 ok = (ferror(file) == 0);
+    fclose(file);
+    free(raw);
+    free(idat);
+    return ok;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file host_raster_fx.c
+ * @brief C stand-in for src/raster_fx_hint.s (`make host` builds only).
+ *
+ * Walks the same table as the assembly handler, one record per call, writing
+ * through the simulated VDP ports. host_vdp_scan() calls it where the H-int
+ * counter fires while the frame is rendered line by line.
+ */
+#include "genesis.h"
+#include "host_vdp.h"
+
+extern const u16* volatile raster_fx_cursor;
+extern const u16* volatile raster_fx_live;
+extern const u16* volatile raster_fx_next;
+extern volatile u32 raster_fx_fires;
+
+void raster_fx_hint_handler(void) {
+    const u16* cursor = raster_fx_cursor;
+    if (cursor == NULL) return;
+
+    host_vdp_write_control(*cursor++); // H-int counter (register 10)
+    for (u16 regs = *cursor++; regs; regs--) host_vdp_write_control(*cursor++);
+    for (u16 runs = *cursor++; runs; runs--) {
+        host_vdp_write_control(*cursor++); // Write command
+        host_vdp_write_control(*cursor++);
+        for (u16 words = *cursor++; words; words--) host_vdp_write_data(*cursor++);
+    }
+
+    // A 0 after the record ends the table: move on to the next one, whose head
+    // record the fire at the end of line 223 runs.
+    if (*cursor == 0) {
+        cursor = raster_fx_next;
+        raster_fx_live = cursor;
+    }
+    raster_fx_cursor = cursor;
+    raster_fx_fires++;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file host_resources.c
+ * @brief Hand-made stand-ins for the rescomp resources (`make host` builds only).
+ *
+ * See host/inc/resources.h. Tile rows are 8 pixels, one nibble per pixel with
+ * the leftmost pixel in the high nibble; sprite tiles are column-major.
+ */
+#include "resources.h"
+
+//--------------------------------------------------------------------------------------------------
+// Map tileset: 0 empty, 1 solid, 2 smiley, 3 diagonal cross
+//--------------------------------------------------------------------------------------------------
+
+static u16 tileset_palette_data[16] = {
+    0x0000, 0x0EEE, 0x00EE, 0x0EE0, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0EEE
+};
+static Palette tileset_palette = { 16, tileset_palette_data };
+
+static u32 tileset_tiles[4 * 8] = {
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+    0x00222200, 0x02222220, 0x22322322, 0x22222222, 0x23222232, 0x22333322, 0x02222220, 0x00222200,
+    0x30000003, 0x03000030, 0x00300300, 0x00033000, 0x00033000, 0x00300300, 0x03000030, 0x30000003
+};
+const TileSet my_tileset = { 0, 4, tileset_tiles };
+static TileSet tileset_img_tileset = { 0, 4, tileset_tiles };
+static u16 tileset_img_map[4] = { 0, 1, 2, 3 };
+static TileMap tileset_img_tilemap = { 0, 4, 1, tileset_img_map };
+const Image tileset_img = { &tileset_palette, &tileset_img_tileset, &tileset_img_tilemap };
+
+//--------------------------------------------------------------------------------------------------
+// Player sprite: 16x16, one animation of two frames
+//--------------------------------------------------------------------------------------------------
+
+static u16 player_palette_data[16] = {
+    0x0000, 0x00AE, 0x0222, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0EEE
+};
+static Palette player_palette = { 16, player_palette_data };
+
+static u32 player_frame0_tiles[4 * 8] = {
+    0x00001111, 0x00011111, 0x00111111, 0x00112211, 0x00112211, 0x00111111, 0x00111111, 0x00111122,
+    0x00111111, 0x00011111, 0x00001111, 0x00001000, 0x00011000, 0x00011000, 0x00111000, 0x00111000,
+    0x11110000, 0x11111000, 0x11111100, 0x11221100, 0x11221100, 0x11111100, 0x11111100, 0x22111100,
+    0x11111100, 0x11111000, 0x11110000, 0x00010000, 0x00011000, 0x00011000, 0x00011100, 0x00011100
+};
+static TileSet player_frame0_tileset = { 0, 4, player_frame0_tiles };
+static AnimationFrame player_frame0 = { 1, NULL, NULL, &player_frame0_tileset, 16, 16, 0 };
+static u32 player_frame1_tiles[4 * 8] = {
+    0x00001111, 0x00011111, 0x00111111, 0x00112211, 0x00112211, 0x00111111, 0x00111111, 0x00111122,
+    0x00111111, 0x00011111, 0x00001111, 0x00000100, 0x00000110, 0x00000010, 0x00000110, 0x00000110,
+    0x11110000, 0x11111000, 0x11111100, 0x11221100, 0x11221100, 0x11111100, 0x11111100, 0x22111100,
+    0x11111100, 0x11111000, 0x11110000, 0x00100000, 0x01100000, 0x01000000, 0x01100000, 0x01100000
+};
+static TileSet player_frame1_tileset = { 0, 4, player_frame1_tiles };
+static AnimationFrame player_frame1 = { 1, NULL, NULL, &player_frame1_tileset, 16, 16, 0 };
+static AnimationFrame* player_frames[2] = { &player_frame0, &player_frame1 };
+static u8 player_sequence[2] = { 0, 1 };
+static Animation player_animation = { 2, player_frames, 2, player_sequence, 0 };
+static Animation* player_animations[1] = { &player_animation };
+const SpriteDefinition spr_player = { &player_palette, 1, player_animations, 4, 1 };
+
+//--------------------------------------------------------------------------------------------------
+// Logo: 16x4 tiles of stripes and frames
+//--------------------------------------------------------------------------------------------------
+
+static u16 logo_palette_data[16] = {
+    0x0000, 0x0E80, 0x0A40, 0x0EEE, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0EEE
+};
+static Palette logo_palette = { 16, logo_palette_data };
+static u32 logo_tiles[2 * 8] = {
+    0x11111111, 0x11111111, 0x22222222, 0x22222222, 0x11111111, 0x11111111, 0x22222222, 0x22222222,
+    0x33333333, 0x30000003, 0x30000003, 0x30000003, 0x30000003, 0x30000003, 0x30000003, 0x33333333
+};
+static TileSet logo_tileset = { 0, 2, logo_tiles };
+static u16 logo_map[16 * 4] = {
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0
+};
+static TileMap logo_tilemap = { 0, 16, 4, logo_map };
+const Image logo_minnka_img = { &logo_palette, &logo_tileset, &logo_tilemap };
+
+//--------------------------------------------------------------------------------------------------
+// Sound: silent data (the host ignores playback)
+//--------------------------------------------------------------------------------------------------
+
+static const u8 sfx_ping_samples[16] = { 0 };
+const PCM sfx_ping_data = { sfx_ping_samples, sizeof(sfx_ping_samples), 8000 };
+const u8 music_track_res[16] = { 0 };
@@ -0,0 +1,171 @@
+/**
+ * @file host_system.c
+ * @brief System, joypad, debug output and sound stubs for the host build (`make host` builds only).
+ */
+#include "host_system.h"
+#include "host_vdp.h"
+#include <stdarg.h>
+#include <stdlib.h> // For malloc, free
+
+vu32 vtimer = 0;
+
+static HostFrameCallback* frame_callback = NULL;
+static VoidCallback* vint_callback = NULL;
+static VoidCallback* vblank_callback = NULL;
+static u16 joypad_state = 0;
+static u8 klog_enabled = TRUE;
+static u8 xgm_playing = FALSE;
+static u32 heap_allocated = 0;
+
+static void _host_end_frame(u8 vblank_process) {
+    vtimer++;
+    host_vdp_vblank();
+    if (vint_callback != NULL) vint_callback();
+    if (vblank_process && vblank_callback != NULL) vblank_callback();
+    host_vdp_scan(); // The next frame's lines, if an H-int handler needs them
+    if (frame_callback != NULL) frame_callback(vtimer);
+}
+
+void host_vblank() {
+    _host_end_frame(FALSE);
+}
+
+void host_set_frame_callback(HostFrameCallback* callback) {
+    frame_callback = callback;
+}
+
+void host_set_joypad(u16 buttons) {
+    joypad_state = buttons;
+}
+
+void host_set_klog_enabled(u8 enabled) {
+    klog_enabled = enabled;
+}
+
+u16 host_get_vcounter() {
+    return HOST_SCREEN_HEIGHT; // Start of VBlank; the host has no beam position
+}
+
+void SGDK_init() {
+    vtimer = 0;
+    vint_callback = NULL;
+    vblank_callback = NULL;
+    xgm_playing = FALSE;
+    host_vdp_reset();
+}
+
+void SYS_doVBlankProcess() {
+    _host_end_frame(TRUE);
+}
+
+void SYS_disableInts() {
+}
+
+void SYS_enableInts() {
+}
+
+void SYS_setVIntCallback(VoidCallback* callback) {
+    vint_callback = callback;
+}
+
+void SYS_setVBlankCallback(VoidCallback* callback) {
+    vblank_callback = callback;
+}
+
+void SYS_setHIntCallback(VoidCallback* callback) {
+    host_vdp_set_hint_callback(callback); // Called by host_vdp_scan() as the lines are rendered
+}
+
+u32 SYS_getTime() {
+    return vtimer; // SGDK_TIMER_NORMAL_DIV ticks per second at 60Hz
+}
+
+u32 getTick() {
+    return vtimer * (TICKPERSECOND / 60);
+}
+
+void KLog(const char* text) {
+    if (klog_enabled) printf("%s\n", text);
+}
+
+// Each block is prefixed with its size so MEM_free() can return it to the simulated heap.
+// The prefix is 16 bytes to keep the returned pointer aligned for any host type.
+#define HOST_MEM_HEADER 16
+
+void* MEM_alloc(u16 size) {
+    if (size == 0 || heap_allocated + size + HOST_MEM_HEADER > HOST_HEAP_SIZE) return NULL;
+    u8* block = (u8*)malloc(size + HOST_MEM_HEADER);
+    if (block == NULL) return NULL;
+    *(u32*)block = size + HOST_MEM_HEADER;
+    heap_allocated += size + HOST_MEM_HEADER;
+    return block + HOST_MEM_HEADER;
+}
+
+void MEM_free(void* ptr) {
+    if (ptr == NULL) return;
+    u8* block = (u8*)ptr - HOST_MEM_HEADER;
+    heap_allocated -= *(u32*)block;
+    free(block);
+}
+
+u16 MEM_getFree() {
+    return HOST_HEAP_SIZE - heap_allocated;
+}
+
+u16 MEM_getAllocated() {
+    return heap_allocated;
+}
+
+int host_sprintf(char* buffer, const char* format, ...) {
+    // Drop 'l' length modifiers: u32/s32 are 32-bit here, as `long` is on the 68000.
+    char host_format[256];
+    u16 out = 0;
+    u8 in_conversion = FALSE;
+    for (const char* p = format; *p != '\0' && out < sizeof(host_format) - 1; p++) {
+        if (in_conversion && *p == 'l') continue;
+        if (*p == '%') in_conversion = !in_conversion;
+        else if (in_conversion && strchr("diouxXcspfeEgG", *p) != NULL) in_conversion = FALSE;
+        host_format[out++] = *p;
+    }
+    host_format[out] = '\0';
+
+    va_list args;
+    va_start(args, format);
+    int length = vsprintf(buffer, host_format, args);
+    va_end(args);
+    return length;
+}
+
+void JOY_init() {
+}
+
+u16 JOY_readJoypad(u16 joy) {
+    return (joy == JOY_1) ? joypad_state : 0;
+}
+
+void SND_startPlay_PCM(const u8* sample, u32 len, u16 rate, u8 pan, u8 loop) {
+    (void)sample;
+    (void)len;
+    (void)rate;
+    (void)pan;
+    (void)loop;
+}
+
+void XGM_init() {
+}
+
+void XGM_startPlay(const u8* song) {
+    (void)song;
+    xgm_playing = TRUE;
+}
+
+void XGM_stopPlay() {
+    xgm_playing = FALSE;
+}
+
+u8 XGM_isPlaying() {
+    return xgm_playing;
+}
+
+void XGM_update() {
+}
@@ -0,0 +1,756 @@
+/**
+ * @file host_vdp.c
+ * @brief In-memory VDP and sprite engine behind the host genesis.h (`make host` builds only).
+ *
+ * Every VDP call writes straight into `HostVdpState`; there is no DMA timing.
+ * The sprite engine keeps SGDK's model: sprites are changed freely during the
+ * frame and only `SPR_update()` commits them to the sprite list that gets
+ * rendered. Palette fades advance once per simulated VBlank through
+ * `host_vdp_vblank()`.
+ */
+#include "host_vdp.h"
+#include "host_system.h"
+
+extern const u8 host_font_5x7[FONT_LEN][5];
+
+/** @brief Sprite as committed by SPR_update(). */
+typedef struct {
+    const AnimationFrame* frame;
+    s16 x;
+    s16 y;
+    u16 attribut;
+    u8 from_vram; // TRUE: patterns come from VRAM at the attribute's tile index
+} HostSpriteEntry;
+
+static HostVdpState vdp;
+
+static Sprite sprite_pool[HOST_SPR_MAX];
+static Sprite* sprite_list = NULL; // Active sprites, sorted by depth (front first)
+static u8 sprite_engine_active = FALSE;
+static void* sprite_engine_heap = NULL; // Taken from the simulated heap while the engine is active
+static VoidCallback* hint_callback = NULL;
+static u8 scanned = FALSE;               // scan_rgb holds this frame, rendered with H-ints
+static u8 scan_rgb[HOST_SCREEN_WIDTH * HOST_SCREEN_HEIGHT * 3];
+static u8 port_pending = FALSE;          // First word of a two-word command written
+static HostSpriteEntry sprite_table[HOST_SPR_MAX];
+static u16 sprite_table_count = 0;
+
+// Palette fade in progress (advanced by host_vdp_vblank())
+static u16 fade_from[64];
+static u16 fade_to[64];
+static u16 fade_length = 0;
+static u16 fade_step = 0;
+
+//--------------------------------------------------------------------------------------------------
+// Internal helpers
+//--------------------------------------------------------------------------------------------------
+
+static void _host_load_font() {
+    for (u16 c = 0; c < FONT_LEN; c++) {
+        u16* tile = &vdp.vram[(TILE_FONT_INDEX + c) * 16];
+        for (u16 row = 0; row < 8; row++) {
+            u32 bits = 0;
+            for (u16 col = 0; col < 5; col++) {
+                if (host_font_5x7[c][col] & (1 << row)) bits |= 0xFu << (4 * (6 - col)); // Columns 1-5
+            }
+            tile[row * 2] = bits >> 16;
+            tile[row * 2 + 1] = bits & 0xFFFF;
+        }
+    }
+}
+
+static u16 _host_plane_width(VDPPlane plane) {
+    return (plane == WINDOW) ? 64 : vdp.plane_w;
+}
+
+static u16 _host_plane_height(VDPPlane plane) {
+    return (plane == WINDOW) ? 32 : vdp.plane_h;
+}
+
+// Returns the VRAM word holding the plane cell at (x, y), wrapping like the VDP does.
+static u16* _host_plane_cell(VDPPlane plane, u16 x, u16 y) {
+    u16 w = _host_plane_width(plane);
+    u16 h = _host_plane_height(plane);
+    return &vdp.vram[host_vdp_plane_address(plane) + (y % h) * w + (x % w)];
+}
+
+// Returns the 4-bit color index of pixel (px, py) of the tile stored at `tile` in VRAM.
+static u8 _host_vram_tile_pixel(u16 tile, u16 px, u16 py) {
+    u16 word = vdp.vram[((tile & TILE_INDEX_MASK) * 16 + py * 2 + (px >> 2)) & 0x7FFF];
+    return (word >> (12 - 4 * (px & 3))) & 0xF;
+}
+
+static u8 _host_tileset_pixel(const TileSet* tileset, u16 tile, u16 px, u16 py) {
+    if (tileset == NULL || tile >= tileset->numTile) return 0;
+    return (tileset->tiles[tile * 8 + py] >> (28 - 4 * px)) & 0xF;
+}
+
+static u16 _host_color_to_rgb_component(u16 color, u16 shift) {
+    // 3-bit channel to 8 bits, so 0xE maps to 0xFF
+    u16 value = (color >> shift) & 0xE;
+    return (value * 255) / 14;
+}
+
+// Looks up one plane pixel. Returns CRAM index (0 = transparent) and sets *priority.
+static u16 _host_plane_pixel(VDPPlane plane, u16 sx, u16 sy, u8* priority) {
+    u16 w_px = _host_plane_width(plane) * 8;
+    u16 h_px = _host_plane_height(plane) * 8;
+    s32 px = ((s32)sx - vdp.hscroll[plane][sy]) % w_px;
+    s32 py = ((s32)sy + vdp.vscroll[plane][sx >> 4]) % h_px;
+    if (px < 0) px += w_px;
+    if (py < 0) py += h_px;
+
+    u16 cell = *_host_plane_cell(plane, px >> 3, py >> 3);
+    u16 tx = px & 7;
+    u16 ty = py & 7;
+    if (cell & TILE_ATTR_HFLIP_MASK) tx = 7 - tx;
+    if (cell & TILE_ATTR_VFLIP_MASK) ty = 7 - ty;
+
+    *priority = (cell & TILE_ATTR_PRIORITY_MASK) ? 1 : 0;
+    u8 index = _host_vram_tile_pixel(cell, tx, ty);
+    return index ? (((cell & TILE_ATTR_PALETTE_MASK) >> 13) * 16 + index) : 0;
+}
+
+// Looks up one window pixel. The window does not scroll. Returns CRAM index and sets *priority.
+static u16 _host_window_pixel(u16 sx, u16 sy, u8* priority) {
+    u16 cell = *_host_plane_cell(WINDOW, sx >> 3, sy >> 3);
+    u16 tx = sx & 7;
+    u16 ty = sy & 7;
+    if (cell & TILE_ATTR_HFLIP_MASK) tx = 7 - tx;
+    if (cell & TILE_ATTR_VFLIP_MASK) ty = 7 - ty;
+
+    *priority = (cell & TILE_ATTR_PRIORITY_MASK) ? 1 : 0;
+    u8 index = _host_vram_tile_pixel(cell, tx, ty);
+    return index ? (((cell & TILE_ATTR_PALETTE_MASK) >> 13) * 16 + index) : 0;
+}
+
+static u8 _host_window_line(u16 sy) {
+    u16 row = sy >> 3;
+    return vdp.window_down ? (row >= vdp.window_vpos) : (row < vdp.window_vpos);
+}
+
+// Fills vdp.hscroll from the VRAM table the way the current mode reads it:
+// entry 0 for every line, the entry of each line's tile row, or one per line.
+static void _host_resolve_hscroll() {
+    const u16* table = &vdp.vram[HOST_HSCROLL_TABLE / 2];
+    for (u16 y = 0; y < HOST_SCREEN_HEIGHT; y++) {
+        u16 entry = 0;
+        if (vdp.hscroll_mode == HSCROLL_LINE) entry = y;
+        else if (vdp.hscroll_mode == HSCROLL_TILE) entry = y & ~7;
+        vdp.hscroll[0][y] = table[entry * 2];
+        vdp.hscroll[1][y] = table[entry * 2 + 1];
+    }
+}
+
+// Looks up one pixel of a committed sprite. Returns CRAM index (0 = transparent).
+static u16 _host_sprite_pixel(const HostSpriteEntry* entry, u16 lx, u16 ly) {
+    const AnimationFrame* frame = entry->frame;
+    u16 tiles_h = frame->h >> 3;
+    if (entry->attribut & TILE_ATTR_HFLIP_MASK) lx = frame->w - 1 - lx;
+    if (entry->attribut & TILE_ATTR_VFLIP_MASK) ly = frame->h - 1 - ly;
+
+    // Sprite patterns are column-major, like VDP hardware sprites.
+    u16 tile = (lx >> 3) * tiles_h + (ly >> 3);
+    u8 index = entry->from_vram ? _host_vram_tile_pixel((entry->attribut & TILE_INDEX_MASK) + tile, lx & 7, ly & 7)
+                                : _host_tileset_pixel(frame->tileset, tile, lx & 7, ly & 7);
+    return index ? (((entry->attribut & TILE_ATTR_PALETTE_MASK) >> 13) * 16 + index) : 0;
+}
+
+static void _host_sprite_set_frame(Sprite* sprite) {
+    const SpriteDefinition* def = sprite->definition;
+    sprite->animation = NULL;
+    sprite->frame = NULL;
+    if (def == NULL || sprite->animInd < 0 || sprite->animInd >= def->numAnimation) return;
+    sprite->animation = def->animations[sprite->animInd];
+    if (sprite->frameInd < 0 || sprite->frameInd >= sprite->animation->numFrame) sprite->frameInd = 0;
+    sprite->frame = sprite->animation->frames[sprite->frameInd];
+    sprite->timer = sprite->frame->timer;
+}
+
+// Re-inserts `sprite` into the depth-sorted list (stable: after sprites of equal depth).
+static void _host_sprite_link(Sprite* sprite) {
+    Sprite** link = &sprite_list;
+    if (sprite->status & SPR_FLAG_INSERT_HEAD) {
+        while (*link != NULL && (*link)->depth < sprite->depth) link = &(*link)->next;
+    } else {
+        while (*link != NULL && (*link)->depth <= sprite->depth) link = &(*link)->next;
+    }
+    sprite->next = *link;
+    *link = sprite;
+}
+
+static void _host_sprite_unlink(Sprite* sprite) {
+    for (Sprite** link = &sprite_list; *link != NULL; link = &(*link)->next) {
+        if (*link == sprite) {
+            *link = sprite->next;
+            sprite->next = NULL;
+            return;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Host API
+//--------------------------------------------------------------------------------------------------
+
+void host_vdp_reset() {
+    memset(&vdp, 0, sizeof(vdp));
+    vdp.plane_w = 64;
+    vdp.plane_h = 32;
+    vdp.cram[15] = 0x0EEE; // SGDK's default palette has white at PAL0[15] for the font
+    vdp.port_autoinc = 2;
+    vdp.hint_counter = 0xFF;
+    _host_load_font();
+    sprite_list = NULL;
+    sprite_table_count = 0;
+    sprite_engine_active = FALSE;
+    fade_length = 0;
+    hint_callback = NULL;
+    scanned = FALSE;
+    port_pending = FALSE;
+}
+
+HostVdpState* host_vdp_state() {
+    return &vdp;
+}
+
+u16 host_vdp_plane_address(VDPPlane plane) {
+    switch (plane) {
+        case BG_A: return VDP_BG_A / 2;
+        case BG_B: return VDP_BG_B / 2;
+        default: return VDP_WINDOW / 2;
+    }
+}
+
+void host_vdp_vblank() {
+    if (fade_length == 0) return;
+    fade_step++;
+    for (u16 i = 0; i < 64; i++) {
+        u16 color = 0;
+        for (u16 shift = 0; shift < 12; shift += 4) {
+            s16 from = (fade_from[i] >> shift) & 0xE;
+            s16 to = (fade_to[i] >> shift) & 0xE;
+            s16 value = from + ((to - from) * (s16)fade_step) / (s16)fade_length;
+            color |= (value & 0xE) << shift;
+        }
+        vdp.cram[i] = color;
+    }
+    if (fade_step >= fade_length) fade_length = 0;
+}
+
+// Renders line `y` into `rgb` (a whole frame buffer).
+static void _host_render_line(u16 y, u8* rgb) {
+    const HostSpriteEntry* line_sprites[HOST_SPR_MAX_PER_LINE];
+
+    // Sprites on this line in list order, stopping at the hardware limit.
+    u16 line_count = 0;
+    u16 hw_sprites = 0;
+    for (u16 i = 0; i < sprite_table_count && hw_sprites < HOST_SPR_MAX_PER_LINE; i++) {
+        const HostSpriteEntry* entry = &sprite_table[i];
+        if (y < entry->y || y >= entry->y + entry->frame->h) continue;
+        line_sprites[line_count++] = entry;
+        hw_sprites += (entry->frame->w + 31) >> 5; // SGDK splits wide frames into 32px hardware sprites
+    }
+
+    u8 window = _host_window_line(y);
+    for (u16 x = 0; x < HOST_SCREEN_WIDTH; x++) {
+        u8 prio_a, prio_b, prio_s = 0;
+        u16 pixel_b = _host_plane_pixel(BG_B, x, y, &prio_b);
+        // The window replaces BG_A where it is shown.
+        u16 pixel_a = window ? _host_window_pixel(x, y, &prio_a) : _host_plane_pixel(BG_A, x, y, &prio_a);
+        u16 pixel_s = 0;
+        for (u16 i = 0; i < line_count && pixel_s == 0; i++) {
+            const HostSpriteEntry* entry = line_sprites[i];
+            if (x < entry->x || x >= entry->x + entry->frame->w) continue;
+            pixel_s = _host_sprite_pixel(entry, x - entry->x, y - entry->y);
+            prio_s = (entry->attribut & TILE_ATTR_PRIORITY_MASK) ? 1 : 0;
+        }
+
+        // High priority layers above low ones; within a priority: sprites, A, B.
+        u16 index = vdp.background_index;
+        if (pixel_s && prio_s) index = pixel_s;
+        else if (pixel_a && prio_a) index = pixel_a;
+        else if (pixel_b && prio_b) index = pixel_b;
+        else if (pixel_s) index = pixel_s;
+        else if (pixel_a) index = pixel_a;
+        else if (pixel_b) index = pixel_b;
+
+        u16 color = vdp.cram[index & 63];
+        u8* out = &rgb[(y * HOST_SCREEN_WIDTH + x) * 3];
+        out[0] = _host_color_to_rgb_component(color, 0);
+        out[1] = _host_color_to_rgb_component(color, 4);
+        out[2] = _host_color_to_rgb_component(color, 8);
+    }
+}
+
+void host_vdp_scan() {
+    if (!vdp.hint_enabled || hint_callback == NULL) {
+        scanned = FALSE;
+        return;
+    }
+    // The counter is reloaded during VBlank, then counts down once per line and
+    // fires when it would go below 0, reloading from the register first.
+    _host_resolve_hscroll();
+    u16 counter = vdp.hint_counter;
+    for (u16 y = 0; y < HOST_SCREEN_HEIGHT; y++) {
+        _host_render_line(y, scan_rgb);
+        if (counter == 0) {
+            counter = vdp.hint_counter;
+            hint_callback();
+        } else {
+            counter--;
+        }
+    }
+    scanned = TRUE;
+}
+
+void host_vdp_render(u8* rgb) {
+    if (scanned) {
+        memcpy(rgb, scan_rgb, sizeof(scan_rgb));
+        return;
+    }
+    _host_resolve_hscroll();
+    for (u16 y = 0; y < HOST_SCREEN_HEIGHT; y++) _host_render_line(y, rgb);
+}
+
+void host_vdp_set_hint_callback(VoidCallback* callback) {
+    hint_callback = callback;
+}
+
+void host_vdp_write_control(u16 word) {
+    if (port_pending) {
+        // Second word of a command: address bits 15-14 and code bits 5-2.
+        vdp.port_address = (vdp.port_address & 0x3FFF) | ((word & 3) << 14);
+        vdp.port_code = (vdp.port_code & 3) | ((word >> 2) & 0x3C);
+        port_pending = FALSE;
+    } else if ((word & 0xC000) == 0x8000) {
+        // Register write
+        u16 value = word & 0xFF;
+        switch ((word >> 8) & 0x1F) {
+            case 7: vdp.background_index = value & 63; break;
+            case 10: vdp.hint_counter = value; break;
+            case 15: vdp.port_autoinc = value; break;
+            default: break;
+        }
+    } else {
+        vdp.port_address = word & 0x3FFF;
+        vdp.port_code = word >> 14;
+        port_pending = TRUE;
+    }
+}
+
+void host_vdp_write_data(u16 word) {
+    port_pending = FALSE;
+    switch (vdp.port_code & 0xF) {
+        case 1: vdp.vram[(vdp.port_address >> 1) & 0x7FFF] = word; break;
+        case 3: vdp.cram[(vdp.port_address >> 1) & 63] = word; break;
+        case 5: {
+            // VSRAM interleaves BG_A and BG_B; in plane mode entries 0 and 1 scroll the whole plane.
+            u16 entry = (vdp.port_address >> 1) % 40;
+            if (entry < 2) {
+                for (u16 i = 0; i < 20; i++) vdp.vscroll[entry][i] = word;
+            } else {
+                vdp.vscroll[entry & 1][entry >> 1] = word;
+            }
+            break;
+        }
+        default: break;
+    }
+    vdp.port_address += vdp.port_autoinc;
+}
+
+//--------------------------------------------------------------------------------------------------
+// VDP
+//--------------------------------------------------------------------------------------------------
+
+void VDP_waitVSync() {
+    host_vblank();
+}
+
+void VDP_waitDMACompletion() {
+}
+
+void VDP_setPlaneSize(u16 w, u16 h, u16 setupVram) {
+    (void)setupVram;
+    vdp.plane_w = w;
+    vdp.plane_h = h;
+}
+
+u16 VDP_getPlaneWidth() {
+    return vdp.plane_w;
+}
+
+u16 VDP_getPlaneHeight() {
+    return vdp.plane_h;
+}
+
+void VDP_setHIntCounter(u16 value) {
+    vdp.hint_counter = value & 0xFF;
+}
+
+void VDP_setHInterrupt(u16 value) {
+    vdp.hint_enabled = value ? TRUE : FALSE;
+}
+
+void VDP_setBackgroundColor(u16 index) {
+    vdp.background_index = index & 63;
+}
+
+u16 VDP_loadTileSet(const TileSet* tileset, u16 index, TransferMethod tm) {
+    if (tileset == NULL) return FALSE;
+    VDP_loadTileData(tileset->tiles, index, tileset->numTile, tm);
+    return TRUE;
+}
+
+void VDP_loadTileData(const u32* data, u16 index, u16 num, TransferMethod tm) {
+    (void)tm;
+    for (u32 i = 0; i < (u32)num * 8; i++) {
+        u32 word = (index * 16 + i * 2) & 0x7FFF;
+        vdp.vram[word] = data[i] >> 16;
+        vdp.vram[word + 1] = data[i] & 0xFFFF;
+    }
+}
+
+void VDP_fillTileData(u8 value, u16 index, u16 num, u16 wait) {
+    (void)wait;
+    u16 word = (value << 8) | value;
+    for (u32 i = 0; i < (u32)num * 16; i++) vdp.vram[(index * 16 + i) & 0x7FFF] = word;
+}
+
+void VDP_clearPlane(VDPPlane plane, u16 wait) {
+    (void)wait;
+    u32 cells = (u32)_host_plane_width(plane) * _host_plane_height(plane);
+    memset(&vdp.vram[host_vdp_plane_address(plane)], 0, cells * sizeof(u16));
+}
+
+void VDP_setTileMapXY(VDPPlane plane, u16 tile, u16 x, u16 y) {
+    *_host_plane_cell(plane, x, y) = tile;
+}
+
+u16 VDP_getTileMapXY(VDPPlane plane, u16 x, u16 y) {
+    return *_host_plane_cell(plane, x, y);
+}
+
+void VDP_fillTileMapRect(VDPPlane plane, u16 tile, u16 x, u16 y, u16 w, u16 h) {
+    for (u16 j = 0; j < h; j++) {
+        for (u16 i = 0; i < w; i++) *_host_plane_cell(plane, x + i, y + j) = tile;
+    }
+}
+
+void VDP_setTileMapData(u16 plane_addr, const u16* data, u16 index, u16 num, TransferMethod tm) {
+    (void)tm;
+    for (u16 i = 0; i < num; i++) vdp.vram[((plane_addr / 2) + index + i) & 0x7FFF] = data[i];
+}
+
+void VDP_setTileMapDataRect(VDPPlane plane, const u16* data, u16 x, u16 y, u16 w, u16 h, u16 wm, TransferMethod tm) {
+    VDP_setTileMapDataRectEx(plane, data, 0, x, y, w, h, wm, tm);
+}
+
+void VDP_setTileMapDataRectEx(VDPPlane plane, const u16* data, u16 basetile, u16 x, u16 y, u16 w, u16 h, u16 wm,
+                              TransferMethod tm) {
+    (void)tm;
+    for (u16 j = 0; j < h; j++) {
+        for (u16 i = 0; i < w; i++) *_host_plane_cell(plane, x + i, y + j) = data[j * wm + i] + basetile;
+    }
+}
+
+u16 VDP_setTileMapEx(VDPPlane plane, const TileMap* tilemap, u16 basetile, u16 x, u16 y, u16 xm, u16 ym, u16 w,
+                     u16 h, TransferMethod tm) {
+    if (tilemap == NULL) return FALSE;
+    VDP_setTileMapDataRectEx(plane, &tilemap->tilemap[ym * tilemap->w + xm], basetile, x, y, w, h, tilemap->w, tm);
+    return TRUE;
+}
+
+void VDP_setScrollingMode(u16 hscroll, u16 vscroll) {
+    (void)vscroll; // Vertical scroll is always per plane here
+    vdp.hscroll_mode = hscroll;
+}
+
+u16 VDP_getHScrollTableAddress() {
+    return HOST_HSCROLL_TABLE;
+}
+
+void VDP_setHorizontalScroll(VDPPlane plane, s16 value) {
+    if (plane > BG_B) return;
+    vdp.vram[HOST_HSCROLL_TABLE / 2 + plane] = value; // Entry 0, as SGDK writes it
+}
+
+void VDP_setVerticalScroll(VDPPlane plane, s16 value) {
+    if (plane > BG_B) return;
+    for (u16 i = 0; i < 20; i++) vdp.vscroll[plane][i] = value;
+}
+
+void VDP_setWindowHPos(u16 right, u16 pos) {
+    (void)right; // Only full-width windows are rendered
+    (void)pos;
+}
+
+void VDP_setWindowVPos(u16 down, u16 pos) {
+    vdp.window_down = down;
+    vdp.window_vpos = pos;
+}
+
+u16 VDP_getFontTileInd() {
+    return TILE_FONT_INDEX;
+}
+
+void VDP_setTextPalette(u16 palette) {
+    vdp.text_attr = (vdp.text_attr & TILE_ATTR_PRIORITY_MASK) | TILE_ATTR(palette & 3, 0, 0, 0);
+}
+
+void VDP_setTextPriority(u16 prio) {
+    vdp.text_attr = (vdp.text_attr & TILE_ATTR_PALETTE_MASK) | (prio ? TILE_ATTR_PRIORITY_MASK : 0);
+}
+
+void VDP_drawText(const char* str, u16 x, u16 y) {
+    VDP_drawTextBG(BG_A, str, x, y);
+}
+
+void VDP_drawTextBG(VDPPlane plane, const char* str, u16 x, u16 y) {
+    VDP_drawTextEx(plane, str, vdp.text_attr + TILE_FONT_INDEX, x, y, CPU);
+}
+
+void VDP_drawTextEx(VDPPlane plane, const char* str, u16 basetile, u16 x, u16 y, TransferMethod tm) {
+    (void)tm;
+    // Like SGDK, `basetile` carries the attributes; characters index into the font.
+    u16 attr = basetile & ~TILE_INDEX_MASK;
+    u16 font = basetile & TILE_INDEX_MASK;
+    if ((font < TILE_FONT_INDEX) || (font >= TILE_FONT_INDEX + FONT_LEN)) font = TILE_FONT_INDEX;
+    for (; *str != '\0' && x < _host_plane_width(plane); str++, x++) {
+        u8 c = (u8)*str;
+        u16 glyph = (c >= 32 && c < 32 + FONT_LEN) ? (c - 32) : 0;
+        *_host_plane_cell(plane, x, y) = attr + font + glyph;
+    }
+}
+
+void VDP_clearText(u16 x, u16 y, u16 w) {
+    VDP_clearTextBG(BG_A, x, y, w);
+}
+
+void VDP_clearTextBG(VDPPlane plane, u16 x, u16 y, u16 w) {
+    for (u16 i = 0; i < w; i++) *_host_plane_cell(plane, x + i, y) = 0;
+}
+
+void VDP_setPalette(u16 num, const u16* pal) {
+    memcpy(&vdp.cram[(num & 3) * 16], pal, 16 * sizeof(u16));
+}
+
+void VDP_getPalette(u16 num, u16* pal) {
+    memcpy(pal, &vdp.cram[(num & 3) * 16], 16 * sizeof(u16));
+}
+
+void VDP_setPaletteColor(u16 index, u16 value) {
+    vdp.cram[index & 63] = value;
+}
+
+u16 VDP_getPaletteColor(u16 index) {
+    return vdp.cram[index & 63];
+}
+
+void VDP_setPaletteColors(u16 index, const u16* values, u16 count) {
+    for (u16 i = 0; i < count; i++) vdp.cram[(index + i) & 63] = values[i];
+}
+
+void VDP_getPaletteColors(u16 index, u16* dest, u16 count) {
+    for (u16 i = 0; i < count; i++) dest[i] = vdp.cram[(index + i) & 63];
+}
+
+static void _host_fade(const u16* to, u16 numframe, u8 async) {
+    memcpy(fade_from, vdp.cram, sizeof(fade_from));
+    memcpy(fade_to, to, sizeof(fade_to));
+    fade_step = 0;
+    fade_length = numframe;
+    if (numframe == 0) {
+        memcpy(vdp.cram, to, sizeof(vdp.cram));
+        return;
+    }
+    if (!async) {
+        while (fade_length != 0) VDP_waitVSync();
+    }
+}
+
+void VDP_fadeOutAll(u16 numframe, u8 async) {
+    static const u16 black[64] = {0};
+    _host_fade(black, numframe, async);
+}
+
+void VDP_fadeInAll(const u16* pal, u16 numframe, u8 async) {
+    _host_fade(pal, numframe, async);
+}
+
+u16 DMA_getQueueTransferSize() {
+    return 0;
+}
+
+bool DMA_queueDma(u8 location, void* from, u16 to, u16 len, u16 step) {
+    const u16* src = (const u16*)from;
+    u16 word = to / 2;
+    for (u16 i = 0; i < len; i++, word += step / 2) {
+        switch (location) {
+            case DMA_VRAM: vdp.vram[word & 0x7FFF] = src[i]; break;
+            case DMA_CRAM: vdp.cram[word & 63] = src[i]; break;
+            // VSRAM interleaves BG_A and BG_B per 2-tile column.
+            case DMA_VSRAM: if (word < 40) vdp.vscroll[word & 1][word >> 1] = src[i]; break;
+            default: break;
+        }
+    }
+    return TRUE;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Sprite engine
+//--------------------------------------------------------------------------------------------------
+
+void SPR_init() {
+    if (sprite_engine_active) SPR_end(); // SGDK also ends a running engine first
+    sprite_engine_heap = MEM_alloc(HOST_SPR_HEAP_BYTES);
+    memset(sprite_pool, 0, sizeof(sprite_pool));
+    sprite_list = NULL;
+    sprite_table_count = 0;
+    sprite_engine_active = TRUE;
+}
+
+void SPR_end() {
+    MEM_free(sprite_engine_heap);
+    sprite_engine_heap = NULL;
+    sprite_list = NULL;
+    sprite_table_count = 0;
+    sprite_engine_active = FALSE;
+}
+
+Sprite* SPR_addSpriteEx(const SpriteDefinition* spriteDef, s16 x, s16 y, u16 attribut, u16 spriteIndex, u16 flag) {
+    (void)spriteIndex;
+    if (!sprite_engine_active) return NULL;
+    for (u16 i = 0; i < HOST_SPR_MAX; i++) {
+        Sprite* sprite = &sprite_pool[i];
+        if (sprite->definition != NULL) continue;
+        memset(sprite, 0, sizeof(Sprite));
+        sprite->status = flag & SPR_FLAG_MASK;
+        sprite->visibility = VISIBLE;
+        sprite->definition = spriteDef;
+        sprite->x = x;
+        sprite->y = y;
+        sprite->attribut = attribut;
+        _host_sprite_set_frame(sprite);
+        _host_sprite_link(sprite);
+        return sprite;
+    }
+    return NULL;
+}
+
+Sprite* SPR_addSprite(const SpriteDefinition* spriteDef, s16 x, s16 y, u16 attribut) {
+    return SPR_addSpriteEx(spriteDef, x, y, attribut, 0,
+                           SPR_FLAG_AUTO_VISIBILITY | SPR_FLAG_AUTO_VRAM_ALLOC | SPR_FLAG_AUTO_SPRITE_ALLOC |
+                               SPR_FLAG_AUTO_TILE_UPLOAD);
+}
+
+void SPR_releaseSprite(Sprite* sprite) {
+    if (sprite == NULL || sprite->definition == NULL) return;
+    _host_sprite_unlink(sprite);
+    sprite->definition = NULL;
+}
+
+void SPR_setPosition(Sprite* sprite, s16 x, s16 y) {
+    sprite->x = x;
+    sprite->y = y;
+}
+
+s16 SPR_getPositionX(const Sprite* sprite) {
+    return sprite->x;
+}
+
+s16 SPR_getPositionY(const Sprite* sprite) {
+    return sprite->y;
+}
+
+void SPR_setAnim(Sprite* sprite, s16 anim) {
+    SPR_setAnimAndFrame(sprite, anim, 0);
+}
+
+void SPR_setFrame(Sprite* sprite, s16 frame) {
+    SPR_setAnimAndFrame(sprite, sprite->animInd, frame);
+}
+
+void SPR_setAnimAndFrame(Sprite* sprite, s16 anim, s16 frame) {
+    sprite->animInd = anim;
+    sprite->frameInd = frame;
+    _host_sprite_set_frame(sprite);
+}
+
+void SPR_setVisibility(Sprite* sprite, SpriteVisibility value) {
+    sprite->visibility = value;
+}
+
+void SPR_setDepth(Sprite* sprite, s16 value) {
+    if (sprite->depth == value) return;
+    sprite->depth = value;
+    _host_sprite_unlink(sprite);
+    _host_sprite_link(sprite);
+}
+
+void SPR_setVRAMTileIndex(Sprite* sprite, s16 value) {
+    if (value < 0) {
+        sprite->status |= SPR_FLAG_AUTO_VRAM_ALLOC;
+    } else {
+        sprite->status &= ~SPR_FLAG_AUTO_VRAM_ALLOC;
+        sprite->attribut = (sprite->attribut & ~TILE_INDEX_MASK) | (value & TILE_INDEX_MASK);
+    }
+}
+
+void SPR_setAutoTileUpload(Sprite* sprite, u16 value) {
+    if (value) sprite->status |= SPR_FLAG_AUTO_TILE_UPLOAD;
+    else sprite->status &= ~SPR_FLAG_AUTO_TILE_UPLOAD;
+}
+
+u16 SPR_getNumActiveSprite() {
+    u16 count = 0;
+    for (Sprite* sprite = sprite_list; sprite != NULL; sprite = sprite->next) count++;
+    return count;
+}
+
+u16 SPR_getUsedVDPSprite() {
+    u16 count = 0;
+    for (Sprite* sprite = sprite_list; sprite != NULL; sprite = sprite->next) {
+        if (sprite->status & SPR_FLAG_AUTO_SPRITE_ALLOC) count += sprite->definition->maxNumSprite;
+    }
+    return count;
+}
+
+u16 SPR_getFreeVRAM() {
+    u16 used = 0;
+    for (Sprite* sprite = sprite_list; sprite != NULL; sprite = sprite->next) {
+        if (sprite->status & SPR_FLAG_AUTO_VRAM_ALLOC) used += sprite->definition->maxNumTile;
+    }
+    return (used < HOST_SPR_VRAM_TILES) ? HOST_SPR_VRAM_TILES - used : 0;
+}
+
+bool SPR_isInitialized() {
+    return sprite_engine_active;
+}
+
+void SPR_update() {
+    sprite_table_count = 0;
+    if (!sprite_engine_active) return;
+
+    for (Sprite* sprite = sprite_list; sprite != NULL; sprite = sprite->next) {
+        // Automatic animation, as SGDK does for frames with a non-zero timer.
+        if (sprite->frame != NULL && sprite->frame->timer != 0 && --sprite->timer == 0) {
+            sprite->frameInd = (sprite->frameInd + 1) % sprite->animation->numFrame;
+            _host_sprite_set_frame(sprite);
+        }
+
+        if (sprite->frame == NULL || sprite->visibility == HIDDEN) continue;
+        if (sprite->x >= HOST_SCREEN_WIDTH || sprite->y >= HOST_SCREEN_HEIGHT || sprite->x + sprite->frame->w <= 0 ||
+            sprite->y + sprite->frame->h <= 0) {
+            continue;
+        }
+        if (sprite_table_count >= HOST_SPR_MAX) break;
+
+        HostSpriteEntry* entry = &sprite_table[sprite_table_count++];
+        entry->frame = sprite->frame;
+        entry->x = sprite->x;
+        entry->y = sprite->y;
+        entry->attribut = sprite->attribut;
+        entry->from_vram = (sprite->status & SPR_FLAG_AUTO_TILE_UPLOAD) ? FALSE : TRUE;
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file bench.h
+ * @brief Headless benchmark driver for the `make bench` ROM.
+ *
+ * The benchmark ROM skips the loading screen and drives the test menu by
+ * itself through a scripted input provider (see `input_set_provider()`). For
+ * every benchmarked menu entry it navigates to the entry, starts it, plays a
+ * short looping input script for a fixed number of frames, then exits back to
+ * the menu with Start. While a test runs it collects:
+ * - frame time: scanlines from the top of the main loop to `SYS_doVBlankProcess()`,
+ * - lag: VBlanks that passed before the loop reached `SYS_doVBlankProcess()`,
+ * - VRAM traffic: bytes pending in SGDK's DMA queue at the end of the frame,
+ *   and bytes the DMA scheduler carried over to a later frame.
+ *
+ * Results go to the emulator debug port (KLog) as one line per test:
+ * `BENCH test=<name> frames=<n> avg_lines=<n> max_lines=<n> lag=<n> dma_avg=<n> dma_max=<n> dma_deferred_max=<n>`
+ * framed by `BENCH_BEGIN` and `BENCH_END` lines. `tools/run_bench.py` launches
+ * an emulator headlessly, collects these lines and writes a JSON report.
+ *
+ * Only compiled when `BENCH_ENABLED` (see `debug_config.h`).
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Frames each test runs for once entered (10 seconds at 60Hz). */
+#define BENCH_FRAMES_PER_TEST 600
+/** @brief Idle frames in the menu before navigating to the next test. */
+#define BENCH_SETTLE_FRAMES 30
+
+#if BENCH_ENABLED
+
+/** @brief Resets the benchmark sequence and installs the scripted input provider. */
+void bench_init();
+
+/** @brief Call at the top of the main loop, before `input_update()`. */
+void bench_frame_begin();
+
+/**
+ * @brief Call right before `SYS_doVBlankProcess()`. Records the frame's metrics
+ *        and decides the scripted input for the next frame.
+ * @param in_menu TRUE if the game is currently in the test menu.
+ */
+void bench_frame_end(u8 in_menu);
+
+#define BENCH_INIT()              bench_init()
+#define BENCH_FRAME_BEGIN()       bench_frame_begin()
+#define BENCH_FRAME_END(in_menu)  bench_frame_end(in_menu)
+
+#else
+
+#define BENCH_INIT()              ((void)0)
+#define BENCH_FRAME_BEGIN()       ((void)0)
+#define BENCH_FRAME_END(in_menu)  ((void)(in_menu))
+
+#endif // BENCH_ENABLED
+
+#endif // BENCH_H
@@ -0,0 +1,66 @@
+/**
+ * @file camera.h
+ * @brief World-space camera: follows a target with a dead zone and look-ahead, and culls entities.
+ *
+ * The camera is the world position (in 32-bit pixels, as the scroll engine's)
+ * of the screen's top-left corner, kept inside the world set with camera_init(). Every move is passed
+ * on to the entity pool (entity_pool_set_view()), which places sprites
+ * relative to it and culls entities farther than the margin outside the
+ * screen: their sprite is hidden once, and then neither their sprite nor their
+ * animation is touched until they come back, so the engine neither draws nor
+ * uploads tiles for them. They keep moving in the world.
+ *
+ * camera_follow() leaves the camera alone while the target is inside the dead
+ * zone (a screen rectangle) and pushes it when the target leaves it. The dead
+ * zone is shifted against the target's direction by a look-ahead that eases
+ * towards `distance` pixels, so more of the screen shows where the target is
+ * heading. Pass the camera to the scroll engine (or to parallax bands) after
+ * moving it.
+ */
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Pixels outside the screen an entity may be before it is culled, unless set. */
+#define CAMERA_DEFAULT_MARGIN 32
+
+/**
+ * @brief Sets the world size in pixels and puts the camera at (0, 0), with the
+ *        dead zone the whole screen, no look-ahead and the default margin.
+ */
+void camera_init(u32 world_w, u32 world_h);
+
+/** @brief Sets the dead zone, in screen pixels. The target's position is kept inside it. */
+void camera_set_dead_zone(s16 left, s16 top, s16 right, s16 bottom);
+
+/**
+ * @brief Sets the look-ahead: the dead zone shifts up to `distance` pixels
+ *        against the target's direction, by `step` pixels per frame.
+ */
+void camera_set_look_ahead(s16 distance, s16 step);
+
+/** @brief Sets how far outside the screen entities stay active. */
+void camera_set_margin(s16 margin);
+
+/**
+ * @brief Moves the camera so the target at world (`x`, `y`), moving by
+ *        (`vx`, `vy`) this frame, stays in the dead zone. Call once per frame.
+ */
+void camera_follow(s32 x, s32 y, s16 vx, s16 vy);
+
+/** @brief Puts the camera at world (`x`, `y`), clamped to the world. */
+void camera_set_position(s32 x, s32 y);
+
+/** @brief Camera position: the world coordinates of the screen's top-left corner. */
+s32 camera_get_x();
+s32 camera_get_y();
+
+/** @brief Converts world coordinates to screen coordinates. */
+s32 camera_to_screen_x(s32 world_x);
+s32 camera_to_screen_y(s32 world_y);
+
+/** @brief TRUE if a `w` x `h` box at world (`x`, `y`) is on screen or within the margin. */
+u8 camera_is_visible(s32 x, s32 y, s16 w, s16 h);
+
+#endif // CAMERA_H
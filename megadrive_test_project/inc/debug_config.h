@@ -0,0 +1,80 @@
+/**
+ * @file debug_config.h
+ * @brief Compile-time switches for the on-target debug instrumentation.
+ *
+ * The makefile defines `DEBUG_TOOLS` for every non-release build (see the
+ * `RELEASE` variable in the makefile). Each instrumentation module has its own
+ * `*_ENABLED` switch that defaults to the value of `DEBUG_TOOLS` and can be
+ * overridden individually from the command line, e.g.
+ * `make EXTRA_CFLAGS=-DPROFILER_ENABLED=0`.
+ * When a switch is 0 the module's macros expand to nothing, so release ROMs
+ * carry no code, data or strings for it.
+ */
+#ifndef DEBUG_CONFIG_H
+#define DEBUG_CONFIG_H
+
+#ifdef DEBUG_TOOLS
+#define DEBUG_TOOLS_ENABLED 1
+#else
+#define DEBUG_TOOLS_ENABLED 0
+#endif
+
+/** @brief Per-state frame-budget profiler (profiler.c). */
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED DEBUG_TOOLS_ENABLED
+#endif
+
+/** @brief Lag-frame and VBlank-overrun accounting (lag_monitor.c). */
+#ifndef LAG_MONITOR_ENABLED
+#define LAG_MONITOR_ENABLED DEBUG_TOOLS_ENABLED
+#endif
+
+/** @brief Stack, heap and VRAM high-water marks (watermark.c). */
+#ifndef WATERMARK_ENABLED
+#define WATERMARK_ENABLED DEBUG_TOOLS_ENABLED
+#endif
+
+/**
+ * @brief Headless benchmark driver (bench.c).
+ * Defined by `make bench` (BENCH=1 passes -DBENCH_MODE); never part of the normal ROM.
+ */
+#ifdef BENCH_MODE
+#define BENCH_ENABLED 1
+#else
+#define BENCH_ENABLED 0
+#endif
+
+/**
+ * @brief Long-running soak test (soak.c).
+ * Defined by `make soak` (SOAK=1 passes -DSOAK_MODE); never part of the normal ROM.
+ * Like the benchmark driver it replaces the controller, so the two cannot be combined.
+ */
+#ifdef SOAK_MODE
+#define SOAK_ENABLED 1
+#else
+#define SOAK_ENABLED 0
+#endif
+
+#if SOAK_ENABLED && BENCH_ENABLED
+#error "The soak test and the benchmark driver both drive the menu; build them separately."
+#endif
+
+/**
+ * @brief Statistical PC-sampling profiler (pc_sampler.c).
+ * Opt-in only: it takes over the H-int vector, so it is enabled by `make profile`
+ * (which passes PC_SAMPLER=1) rather than by DEBUG_TOOLS.
+ */
+#ifndef PC_SAMPLER_ENABLED
+#define PC_SAMPLER_ENABLED 0
+#endif
+
+/**
+ * @brief Per-module VDP traffic accounting (vdp_stats.c).
+ * Opt-in only: its wrappers add a call to every VDP write and would skew the
+ * profiler, so it is enabled by `make VDP_STATS=1` rather than by DEBUG_TOOLS.
+ */
+#ifndef VDP_STATS_ENABLED
+#define VDP_STATS_ENABLED 0
+#endif
+
+#endif // DEBUG_CONFIG_H
@@ -0,0 +1,15 @@
+#ifndef DEBUG_STATS_SCREEN_H
+#define DEBUG_STATS_SCREEN_H
+
+// "Debug: Frame Stats" screen. Shows the totals collected by the debug
+// instrumentation (lag per state, transition costs) on pages selected with
+// D-Pad Left/Right. Pressing A writes the same totals to the debug port (KLog).
+// B starts/stops an input recording (see input_record_start()); stopping it
+// writes the recording to KLog as a C array for the benchmark ROM.
+// In release builds the screen only reports that debug tools are disabled.
+
+void debug_stats_screen_init();
+void debug_stats_screen_update();
+void debug_stats_screen_on_exit();
+
+#endif // DEBUG_STATS_SCREEN_H
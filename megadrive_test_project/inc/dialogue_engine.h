@@ -22,6 +22,10 @@ typedef struct {
 void dialogue_engine_init(); // Initializes the dialogue state
 void dialogue_engine_draw_box(VDPPlane plane, u16 x, u16 y, u16 width, u16 height, const char* title);
 
+// Draws one line of text at tile (x, y), using the box's palette.
+// Coordinates are absolute plane coordinates, e.g. (box_x + 1, box_y + 1) for the first line.
+void dialogue_engine_draw_text_line_inside_box(VDPPlane plane, const char* text, u16 x, u16 y);
+
 // Starts displaying a new message. Parses first page.
 void dialogue_engine_start_message(const char* message, u16 box_char_width, u16 box_max_lines);
 
@@ -0,0 +1,148 @@
+/**
+ * @file dma_scheduler.h
+ * @brief Project-wide DMA scheduler with a per-frame byte budget and priorities.
+ *
+ * Modules submit VRAM, CRAM and VSRAM transfers here instead of starting a DMA
+ * themselves. Once per frame, right before `SYS_doVBlankProcess()`,
+ * `dma_scheduler_flush()` moves as many bytes as fit in the VBlank window into
+ * SGDK's DMA queue, which SGDK then runs during VBlank. Whatever does not fit
+ * is carried over to the next frame, so a big load is spread over several
+ * frames instead of overrunning VBlank.
+ *
+ * Transfers are taken in priority order (sprites, scroll edges, palettes, bulk
+ * tiles) and first-in first-out within a priority. Bulk transfers are split to
+ * fill the remaining budget; transfers of every other priority are moved whole
+ * or not at all, so a palette or a scroll edge never shows up half-written.
+ * One larger than a whole frame's budget goes out alone when nothing else is
+ * queued, or regardless after waiting one frame, overrunning that VBlank.
+ *
+ * The budget is `DMA_SCHEDULER_BUDGET_NTSC` or `DMA_SCHEDULER_BUDGET_PAL`
+ * bytes, minus whatever is already in SGDK's DMA queue when the flush runs
+ * (the sprite engine queues its own tile and sprite table uploads in
+ * `SPR_update()`).
+ *
+ * The source data is read when the DMA runs, not when it is submitted: keep it
+ * in ROM or in a buffer that stays unchanged until `dma_scheduler_get_stats()`
+ * shows nothing pending. Direct VDP writes made after a submission land first,
+ * so do not mix both for the same VRAM or CRAM area.
+ *
+ * The "Debug: Frame Stats" screen has a page with the stats below, and its A
+ * button writes them to `KLog()` as a `DMAS` line.
+ */
+#ifndef DMA_SCHEDULER_H
+#define DMA_SCHEDULER_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Bytes the VDP can take by DMA during an NTSC VBlank in H40 (SGDK's own default limit). */
+#define DMA_SCHEDULER_BUDGET_NTSC 7200
+/** @brief Bytes the VDP can take by DMA during a PAL VBlank in H40 (longer VBlank). */
+#define DMA_SCHEDULER_BUDGET_PAL 15000
+/** @brief Pending transfers per priority. Submitting to a full priority fails. */
+#define DMA_SCHEDULER_QUEUE_SIZE 16
+
+/** @brief Transfer priorities, highest first. */
+typedef enum {
+    DMA_PRIORITY_SPRITES,  ///< Sprite tiles that must match this frame's sprite list.
+    DMA_PRIORITY_SCROLL,   ///< Tilemap edges uncovered by scrolling.
+    DMA_PRIORITY_PALETTE,  ///< Palette changes.
+    DMA_PRIORITY_BULK,     ///< Tile sets and full tilemaps; split across frames as needed.
+    DMA_PRIORITY_COUNT
+} DmaPriority;
+
+/** @brief Queue and budget figures for profiling. */
+typedef struct {
+    u16 budget;               ///< Bytes per frame for the scheduler, before subtracting SGDK's own queue.
+    u16 queued;               ///< Transfers pending right now.
+    u16 peak_queued;          ///< Most transfers pending at once since dma_scheduler_init().
+    u32 pending_bytes;        ///< Bytes pending right now (deferred, after the last flush).
+    u32 peak_pending_bytes;   ///< Most bytes left pending after a flush.
+    u32 last_flushed_bytes;   ///< Bytes moved to SGDK's queue by the last flush.
+    u32 flushed_bytes;        ///< Bytes moved to SGDK's queue since dma_scheduler_init().
+    u32 deferred_frames;      ///< Flushes that left bytes pending.
+    u16 rejected;             ///< Submissions refused because their priority was full.
+} DmaSchedulerStats;
+
+/** @brief Empties the queues, clears the stats and picks the budget for the video mode. Call once at startup. */
+void dma_scheduler_init();
+
+/**
+ * @brief Queues a transfer.
+ * @param priority Transfer priority.
+ * @param location DMA_VRAM, DMA_CRAM or DMA_VSRAM.
+ * @param from Source data (must stay valid and unchanged until transferred).
+ * @param to Destination address in bytes.
+ * @param len Length in words.
+ * @return TRUE if queued, FALSE if that priority's queue is full (the transfer is dropped and counted in `rejected`).
+ */
+u8 dma_scheduler_queue(DmaPriority priority, u8 location, const void* from, u16 to, u16 len);
+
+/**
+ * @brief Queues a transfer whose destination advances by `step` bytes per word,
+ *        e.g. a tilemap column (step = plane width * 2). Split like any other
+ *        transfer of its priority, so do not use it at DMA_PRIORITY_BULK.
+ * @return TRUE if queued, see dma_scheduler_queue().
+ */
+u8 dma_scheduler_queue_step(DmaPriority priority, u8 location, const void* from, u16 to, u16 len, u16 step);
+
+/**
+ * @brief Queues tile data for upload.
+ * @param priority Transfer priority.
+ * @param tiles Tile data, 8 u32 per tile.
+ * @param index First VRAM tile index.
+ * @param num Number of tiles.
+ * @return TRUE if queued, see dma_scheduler_queue().
+ */
+u8 dma_scheduler_queue_tiles(DmaPriority priority, const u32* tiles, u16 index, u16 num);
+
+/**
+ * @brief Queues a tile set at DMA_PRIORITY_BULK. Compressed tile sets have to be
+ *        unpacked first, so they are loaded at once with `VDP_loadTileSet()` instead.
+ * @param tileset Tile set resource.
+ * @param index First VRAM tile index.
+ * @return TRUE if queued or loaded, see dma_scheduler_queue().
+ */
+u8 dma_scheduler_load_tileset(const TileSet* tileset, u16 index);
+
+/**
+ * @brief Queues colors at DMA_PRIORITY_PALETTE.
+ * @param index First CRAM color index (0-63).
+ * @param colors Colors to write.
+ * @param count Number of colors.
+ * @return TRUE if queued, see dma_scheduler_queue().
+ */
+u8 dma_scheduler_queue_colors(u16 index, const u16* colors, u16 count);
+
+/** @brief Moves up to one frame's budget into SGDK's DMA queue. Call once per frame, right before SYS_doVBlankProcess(). */
+void dma_scheduler_flush();
+
+/**
+ * @brief Flushes and waits for VBlank until nothing is pending. For loading code
+ *        that runs its own frames, e.g. before drawing a tilemap that uses the tiles.
+ */
+void dma_scheduler_drain();
+
+/** @brief Overrides the per-frame budget in bytes (0 restores the video mode's default). */
+void dma_scheduler_set_budget(u16 bytes);
+
+/** @brief Transfers pending at `priority` right now. */
+u16 dma_scheduler_get_queued(DmaPriority priority);
+
+/** @brief TRUE if a transfer pending at `priority` reads from the `bytes` bytes at `from`. */
+u8 dma_scheduler_is_pending(DmaPriority priority, const void* from, u32 bytes);
+
+/**
+ * @brief Drops the transfers pending at `priority` that read from the `bytes`
+ *        bytes at `from`, keeping the others in order. For data about to be
+ *        replaced before it was sent, e.g. when a buffer is refilled.
+ * @return Number of transfers dropped.
+ */
+u16 dma_scheduler_cancel(DmaPriority priority, const void* from, u32 bytes);
+
+/** @brief Queue and budget figures. */
+const DmaSchedulerStats* dma_scheduler_get_stats();
+
+/** @brief Writes the stats to `KLog()` as one `DMAS` line. */
+void dma_scheduler_dump_klog();
+
+#endif // DMA_SCHEDULER_H
@@ -0,0 +1,118 @@
+/**
+ * @file entity_pool.h
+ * @brief Fixed-size pool of moving, animated objects stored as parallel arrays.
+ *
+ * Every field of an entity (position, velocity, animation timer and frame,
+ * `Sprite*`) lives in its own array, and live entities are kept packed at the
+ * front of those arrays. entity_pool_update() is then a few short loops, each
+ * walking one or two arrays with post-incremented pointers, instead of one
+ * loop over structs that pulls every field of every entity through the same
+ * registers.
+ *
+ * Entities are named by an id that stays valid until it is despawned. Ids map
+ * to packed slots through a small table; despawning moves the last live entity
+ * into the freed slot and puts the id back on a free list, so spawn and
+ * despawn are O(1) and nothing is allocated per entity. The `Sprite` comes
+ * from SGDK's sprite engine, which has its own fixed pool.
+ *
+ * Positions are 24.8 fixed point and velocities 8.8 (pixels per frame), so
+ * entities can move slower than a pixel per frame. Entities bounce off the
+ * bounds set with entity_pool_set_bounds().
+ *
+ * Positions are in world pixels; sprites are placed relative to the view
+ * (entity_pool_set_view(), which camera.h calls as the camera moves). An
+ * entity more than the view's margin outside the screen is culled: its sprite
+ * is hidden when it leaves, and its animation and sprite are then skipped
+ * until it comes back, so it costs no engine calls or tile uploads. The view
+ * starts at (0, 0), where world and screen coordinates are the same.
+ */
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most entities at once. More than the VDP's 80 sprites: entities need not have one. */
+#define ENTITY_POOL_MAX 128
+
+/** @brief Returned by entity_pool_spawn() when the pool is full. */
+#define ENTITY_POOL_NONE 0xFFFF
+
+/** @brief Frames each animation frame is shown for, unless set per entity. */
+#define ENTITY_POOL_DEFAULT_ANIM_SPEED 15
+
+/** @brief Pool counts for profiling. */
+typedef struct {
+    u16 live;       ///< Entities in use.
+    u16 peak_live;  ///< Most entities in use at once.
+    u32 spawns;     ///< Successful entity_pool_spawn() calls.
+    u32 despawns;   ///< entity_pool_despawn() calls.
+    u16 culled;     ///< Entities culled in the last entity_pool_update().
+    u16 last_lines; ///< Scanlines spent in the last entity_pool_update().
+    u16 peak_lines; ///< Most scanlines spent in one entity_pool_update().
+} EntityPoolStats;
+
+/**
+ * @brief Empties the pool without releasing sprites, sets the bounds to the
+ *        screen for a 16x16 sprite and the view to (0, 0). Call after `SPR_init()`.
+ */
+void entity_pool_init();
+
+/** @brief Despawns every entity, releasing their sprites. */
+void entity_pool_clear();
+
+/**
+ * @brief Sets the area entities bounce in: a position (the top left of the
+ *        sprite) stays within [min, max] in pixels on both axes.
+ */
+void entity_pool_set_bounds(s32 min_x, s32 min_y, s32 max_x, s32 max_y);
+
+/**
+ * @brief Sets the world position of the screen's top-left corner, and how far
+ *        outside the screen (in pixels) entities stay active. Applied by the
+ *        next entity_pool_update().
+ */
+void entity_pool_set_view(s32 x, s32 y, s16 margin);
+
+/**
+ * @brief Adds an entity at world (x, y) pixels with velocity (vx, vy) in 8.8 pixels
+ *        per frame, cycling through the first animation of `def`.
+ * @param def Sprite to show, or NULL for an entity without one.
+ * @param attr Sprite attributes, as for `SPR_addSprite()`.
+ * @return The entity's id, or ENTITY_POOL_NONE if the pool is full. An entity
+ *         whose sprite cannot be added (sprite engine full) is kept without one.
+ */
+u16 entity_pool_spawn(const SpriteDefinition* def, u16 attr, s32 x, s32 y, s16 vx, s16 vy);
+
+/** @brief Removes an entity and releases its sprite. Its id may be reused by the next spawn. */
+void entity_pool_despawn(u16 id);
+
+/** @brief Sets an entity's velocity in 8.8 pixels per frame. */
+void entity_pool_set_velocity(u16 id, s16 vx, s16 vy);
+
+/** @brief Sets the frames each animation frame of an entity is shown for (0 stops it). */
+void entity_pool_set_anim_speed(u16 id, u16 frames);
+
+/** @brief An entity's world position in whole pixels. */
+s32 entity_pool_get_x(u16 id);
+s32 entity_pool_get_y(u16 id);
+
+/** @brief An entity's sprite, or NULL if it has none. */
+Sprite* entity_pool_get_sprite(u16 id);
+
+/** @brief Number of live entities. */
+u16 entity_pool_count();
+
+/**
+ * @brief Moves every entity by its velocity and bounces it off the bounds,
+ *        then culls it against the view or advances its animation and updates
+ *        its sprite. Call once per frame, before `SPR_update()`.
+ */
+void entity_pool_update();
+
+/** @brief Pool counts. */
+const EntityPoolStats* entity_pool_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `ENTITY` line. */
+void entity_pool_dump_klog();
+
+#endif // ENTITY_POOL_H
@@ -26,16 +26,24 @@
  * This function loads tile data (defined in `my_tileset` from `resources.h`,
  * which is compiled from `res/gfx/tileset.png`) into the VDP's VRAM.
  * It also loads the associated palette for the tileset.
- * The tiles are loaded starting at `TILE_USER_INDEX`.
+ * The VRAM allocator picks where the tiles go and skips the upload when they are
+ * still resident from an earlier call.
  */
 void load_simple_tileset();
 
+/**
+ * @brief Releases the tiles loaded by `load_simple_tileset()`.
+ *
+ * They stay in VRAM, so the next `load_simple_tileset()` can reuse them, until
+ * the VRAM allocator evicts them to make room.
+ */
+void release_simple_tileset();
+
 /**
  * @brief Displays a predefined simple tilemap on background plane A (BG_A).
  *
- * This function clears BG_A and then iterates through a 2D array (`simple_map`
- * defined in `graphics.c`) to draw tiles onto the screen.
- * It uses `VDP_setTileMapXY` to place individual tiles.
+ * This function clears BG_A and then writes the compiled `simple_map` map asset
+ * (res/maps/simple_map.csv) with `map_asset_load()`.
  */
 void display_simple_tilemap();
 
@@ -48,8 +56,7 @@ void display_simple_tilemap();
  * This function performs the following:
  * - Initializes the SGDK sprite engine (`SPR_init()`).
  * - Loads the palette for the player sprite (`spr_player.palette`) into `PAL1`.
- * - Adds the player sprite (`spr_player`) to the display list using `SPR_addSprite()`.
- * - Sets the initial animation frame for the player sprite.
+ * - Spawns the player (`spr_player`) in the entity pool, which adds its sprite.
  * - Calls `init_sound_system()` to prepare the sound module (can also be called from main).
  * - Calls `input_init()` to prepare the input module (can also be called from main).
  */
@@ -59,10 +66,9 @@ void setup_sprites();
  * @brief Updates sprite logic, including player movement and animation.
  *
  * This function should be called once per game loop. It handles:
- * - Reading controller input to move the player sprite (`player_x`, `player_y`).
- * - Keeping the player sprite within screen boundaries.
+ * - Reading controller input to set the player entity's velocity.
  * - Triggering a sound effect if Button A is pressed.
- * - Calling `update_player_animation()` to advance the player's animation frame.
+ * - Calling `entity_pool_update()` to move and animate the player within the screen.
  * - Calling `SPR_update()` to commit all sprite changes to the VDP.
  */
 void update_sprites_example();
@@ -0,0 +1,50 @@
+/**
+ * @file hv_timer.h
+ * @brief Scanline-resolution timestamps built from the VDP HV counter.
+ *
+ * The 68000 has no cycle counter, so time inside a frame is measured in
+ * scanlines using the VDP V counter, and whole frames are counted with SGDK's
+ * `vtimer` (incremented by the VBlank interrupt). One NTSC scanline is roughly
+ * 488 CPU cycles, so a 262-line NTSC frame is ~127,800 cycles.
+ *
+ * This module is always compiled in: it is tiny and is used both by the debug
+ * profiler and by test states that print their own timings.
+ */
+#ifndef HV_TIMER_H
+#define HV_TIMER_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Number of active display lines (V28 mode, 224 lines). */
+#define HV_TIMER_ACTIVE_LINES 224
+
+/**
+ * @brief Returns the total number of scanlines in one frame.
+ * @return 262 on NTSC systems, 313 on PAL systems.
+ */
+u16 hv_timer_lines_per_frame();
+
+/**
+ * @brief Returns a monotonically increasing scanline timestamp.
+ *
+ * The timestamp counts scanlines since reset, with the frame boundary placed at
+ * the start of VBlank (where `vtimer` ticks). The difference between two
+ * timestamps is the number of scanlines elapsed between the two calls.
+ *
+ * Readings are exact during active display. During vertical blank the V counter
+ * jumps back (NTSC: 0xEA -> 0xE5, PAL: 0x02 -> 0xCA), so a reading taken there
+ * is only approximate; this only matters for measurements that start or end
+ * inside VBlank.
+ *
+ * @return u32 Scanline timestamp.
+ */
+u32 hv_timer_now();
+
+/**
+ * @brief Converts a scanline count into an approximate 68000 cycle count.
+ * @param lines Number of scanlines.
+ * @return u32 Approximate CPU cycles (488 cycles per line, H40 mode).
+ */
+u32 hv_timer_lines_to_cycles(u32 lines);
+
+#endif // HV_TIMER_H
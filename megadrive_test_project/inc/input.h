@@ -6,6 +6,46 @@
 void input_init();    // Call once at startup
 void input_update();  // Call once per frame in the main loop
 
+// Source of the raw Joypad 1 state read by input_update().
+// Returns a mask of BUTTON_* values, like JOY_readJoypad().
+typedef u16 InputProviderCallback(void);
+
+// Replaces the Joypad 1 reader with `provider` (e.g. the benchmark ROM's scripted input).
+// Pass NULL to go back to reading the real controller.
+void input_set_provider(InputProviderCallback* provider);
+
+// --- Record / Replay ---
+// A recording is a list of runs: `buttons` was the Joypad 1 state for `frames`
+// consecutive frames. Held directions and idle stretches collapse into a single
+// run, so a minute of play usually fits in a few hundred bytes.
+typedef struct {
+    u16 buttons; // BUTTON_* mask, as returned by JOY_readJoypad()
+    u16 frames;  // Number of frames (1-65535) the mask was held
+} InputRun;
+
+typedef enum {
+    INPUT_MODE_LIVE,   // Read the joypad (or the provider set with input_set_provider())
+    INPUT_MODE_RECORD, // Read live input and append it to the recording buffer
+    INPUT_MODE_REPLAY  // Feed a recording back instead of reading live input
+} InputMode;
+
+// Starts recording every frame's state into `buffer` (up to `capacity` runs).
+// Recording stops by itself when the buffer is full.
+void input_record_start(InputRun* buffer, u16 capacity);
+// Stops recording and returns the number of runs written to the buffer.
+u16 input_record_stop();
+// Writes the last recording to the debug port (KLog) as a C array named `name`,
+// ready to be pasted into a source file and linked into a benchmark ROM.
+void input_record_export_klog(const char* name);
+
+// Replays `run_count` runs from `runs` through the normal input_is_* API,
+// starting with the next input_update(). With `loop` set the recording restarts
+// when it ends; otherwise input goes back to live once it is exhausted.
+void input_replay_start(const InputRun* runs, u16 run_count, u8 loop);
+void input_replay_stop();
+
+InputMode input_get_mode();
+
 // Helper functions to check specific buttons/directions on Joypad 1
 u8 input_is_held(u16 button_mask); // True if button is currently down
 u8 input_is_just_pressed(u16 button_mask); // True if button was just pressed this frame
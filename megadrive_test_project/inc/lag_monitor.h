@@ -0,0 +1,120 @@
+/**
+ * @file lag_monitor.h
+ * @brief Lag-frame and VBlank-overrun accounting per game state.
+ *
+ * The main loop brackets every iteration with `LAG_MONITOR_FRAME_BEGIN()` and
+ * `LAG_MONITOR_FRAME_END()`. An on-time iteration sees exactly one VBlank
+ * (the one `SYS_doVBlankProcess()` waits for); every extra VBlank counted by
+ * `vtimer` is a lag frame, i.e. a frame the display repeated because the loop
+ * reached `SYS_doVBlankProcess()` too late.
+ *
+ * Lag is attributed to the state that ran the iteration. When the iteration
+ * changed state, its lag is attributed to entering the new state instead.
+ * Explicit transitions (e.g. `return_to_menu()`) can also be timed on their own
+ * with `LAG_MONITOR_TRANSITION_BEGIN()` / `LAG_MONITOR_TRANSITION_END()`.
+ *
+ * Totals are shown by the "Debug: Frame Stats" screen (`debug_stats_screen.c`)
+ * and written to the emulator debug port by `lag_monitor_dump_klog()`.
+ * Controlled by `LAG_MONITOR_ENABLED` (see `debug_config.h`).
+ */
+#ifndef LAG_MONITOR_H
+#define LAG_MONITOR_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Maximum number of game states tracked. */
+#define LAG_MONITOR_MAX_STATES 24
+/** @brief Maximum number of explicitly timed transitions. */
+#define LAG_MONITOR_MAX_TRANSITIONS 8
+
+/** @brief Lag totals for one game state. */
+typedef struct {
+    const char* name;       ///< State name.
+    u32 frames;             ///< Loop iterations run in this state.
+    u32 lag_frames;         ///< Extra VBlanks that passed during those iterations.
+    u16 worst_lag;          ///< Most lag frames caused by a single iteration.
+    u16 entries;            ///< Times this state was entered.
+    u32 entry_lag_frames;   ///< Lag frames caused by the iterations that entered this state.
+} LagStateStats;
+
+/** @brief Cost of one explicitly timed transition. */
+typedef struct {
+    const char* name;       ///< Transition name.
+    u16 count;              ///< Times the transition ran.
+    u32 last_lines;         ///< Scanlines taken by the most recent run.
+    u32 max_lines;          ///< Most scanlines taken by a single run.
+    u32 total_lines;        ///< Scanlines taken by all runs.
+    u32 total_vblanks;      ///< VBlanks that passed during all runs.
+} LagTransitionStats;
+
+#if LAG_MONITOR_ENABLED
+
+/**
+ * @brief Clears all totals. Call once at startup.
+ * @param state_names Display names indexed by state value (8 characters or fewer).
+ * @param state_count Number of entries in `state_names`.
+ */
+void lag_monitor_init(const char* const* state_names, u16 state_count);
+
+/** @brief Marks the start of a main loop iteration. */
+void lag_monitor_frame_begin();
+
+/**
+ * @brief Marks the end of a main loop iteration, after `SYS_doVBlankProcess()`.
+ * @param state_before State at the start of the iteration.
+ * @param state_after State at the end of the iteration.
+ */
+void lag_monitor_frame_end(u16 state_before, u16 state_after);
+
+/**
+ * @brief Starts timing a transition. Transitions may nest if their IDs differ.
+ * @param transition_id Transition number, 0 to LAG_MONITOR_MAX_TRANSITIONS - 1.
+ * @param name Transition name (a string literal; only the pointer is stored).
+ */
+void lag_monitor_transition_begin(u16 transition_id, const char* name);
+
+/**
+ * @brief Stops timing a transition and records its cost.
+ * @param transition_id Transition number passed to the matching begin call.
+ */
+void lag_monitor_transition_end(u16 transition_id);
+
+/**
+ * @brief Returns the totals for one state.
+ * @return const LagStateStats* The totals, or NULL if `state` is out of range.
+ */
+const LagStateStats* lag_monitor_get_state_stats(u16 state);
+
+/**
+ * @brief Returns the cost of one transition.
+ * @return const LagTransitionStats* The totals, or NULL if never run or out of range.
+ */
+const LagTransitionStats* lag_monitor_get_transition_stats(u16 transition_id);
+
+/** @brief Returns the number of states passed to `lag_monitor_init()`. */
+u16 lag_monitor_get_state_count();
+
+/** @brief Returns the lag frames summed over all states and state entries. */
+u32 lag_monitor_get_total_lag();
+
+/** @brief Writes all state and transition totals to `KLog()`. */
+void lag_monitor_dump_klog();
+
+#define LAG_MONITOR_INIT(names, count)             lag_monitor_init((names), (count))
+#define LAG_MONITOR_FRAME_BEGIN()                  lag_monitor_frame_begin()
+#define LAG_MONITOR_FRAME_END(before, after)       lag_monitor_frame_end((before), (after))
+#define LAG_MONITOR_TRANSITION_BEGIN(id, name)     lag_monitor_transition_begin((id), (name))
+#define LAG_MONITOR_TRANSITION_END(id)             lag_monitor_transition_end(id)
+
+#else
+
+#define LAG_MONITOR_INIT(names, count)             ((void)0)
+#define LAG_MONITOR_FRAME_BEGIN()                  ((void)0)
+#define LAG_MONITOR_FRAME_END(before, after)       ((void)(before), (void)(after))
+#define LAG_MONITOR_TRANSITION_BEGIN(id, name)     ((void)0)
+#define LAG_MONITOR_TRANSITION_END(id)             ((void)0)
+
+#endif // LAG_MONITOR_ENABLED
+
+#endif // LAG_MONITOR_H
@@ -0,0 +1,54 @@
+/**
+ * @file map_asset.h
+ * @brief Loads the tilemaps compiled by tools/map_compiler.py from res/maps.res.
+ *
+ * Map sources (CSV or Tiled) are turned into full tilemap entries at build
+ * time - palette, priority, flips and tile index already in each word - and
+ * optionally packed. `make` generates inc/maps.h and src/maps.c with one
+ * `MapAsset` per map; include "maps.h" to use them.
+ *
+ * `map_asset_load()` unpacks a map into a temporary heap buffer and writes it
+ * with DMA, one transfer for the whole map when it spans the plane's width.
+ * An unpacked map whose tiles sit at the base it was compiled for is DMA'd
+ * straight from ROM.
+ *
+ * The base index is the only thing that can differ at run time, since the VRAM
+ * allocator decides where the tileset goes; the difference is added while
+ * unpacking, so it costs no separate pass.
+ */
+#ifndef MAP_ASSET_H
+#define MAP_ASSET_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief How `MapAsset.data` is stored. */
+typedef enum {
+    MAP_ASSET_NONE, ///< The words themselves.
+    MAP_ASSET_WLZ   ///< Word LZ stream (format in tools/map_compiler.py).
+} MapAssetCompression;
+
+/** @brief A compiled map. Generated; see inc/maps.h. */
+typedef struct {
+    u16 w;            ///< Width in tiles.
+    u16 h;            ///< Height in tiles.
+    u16 base;         ///< Tile index the words were compiled for.
+    u16 compression;  ///< MapAssetCompression.
+    u16 size;         ///< Words in `data`.
+    const u16* data;
+} MapAsset;
+
+/**
+ * @brief Unpacks all `w * h` words of a map into `dest`, with the tile indices
+ *        moved from the compiled base to `base_index`.
+ */
+void map_asset_unpack(const MapAsset* map, u16* dest, u16 base_index);
+
+/**
+ * @brief Writes a map to BG_A or BG_B with its top-left tile at (`x`, `y`).
+ * @param base_index First VRAM tile of the map's tileset.
+ * @return FALSE (reported) if the plane is invalid, the map does not fit or the
+ *         heap has no room for the unpacked words.
+ */
+u8 map_asset_load(const MapAsset* map, VDPPlane plane, u16 x, u16 y, u16 base_index);
+
+#endif // MAP_ASSET_H
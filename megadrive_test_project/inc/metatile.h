@@ -0,0 +1,56 @@
+/**
+ * @file metatile.h
+ * @brief Maps stored as 16x16 or 32x32 pixel blocks, decoded a row or column at a time.
+ *
+ * A `METATILE` entry in res/maps.res is compiled by tools/map_compiler.py into
+ * a dictionary of unique blocks (full tilemap entries, row-major within each
+ * block) and a layout of one u8 block index per block. Repeated scenery is then
+ * stored once: the 256x64 scrolling map takes 4600 bytes instead of 32KB.
+ *
+ * Nothing is expanded up front. The decoders write just the tilemap entries of
+ * one stretch of a tile row or column, so a scrolling view only pays for the
+ * row or column that comes into view. Coordinates are in tiles.
+ */
+#ifndef METATILE_H
+#define METATILE_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief A compiled metatile map. Generated; see inc/maps.h. */
+typedef struct {
+    u16 w;            ///< Width in blocks.
+    u16 h;            ///< Height in blocks.
+    u16 block_shift;  ///< log2 of the block side in tiles (1: 16x16 pixels, 2: 32x32).
+    u16 base;         ///< Tile index the blocks were compiled for.
+    u16 num_blocks;   ///< Entries in the dictionary.
+    const u16* blocks; ///< `num_blocks` blocks of (1 << block_shift)^2 tilemap entries.
+    const u8* layout;  ///< `w * h` block indices, row-major.
+} MetatileMap;
+
+/** @brief Width of a metatile map in tiles. */
+#define METATILE_MAP_TILE_W(map) ((map)->w << (map)->block_shift)
+/** @brief Height of a metatile map in tiles. */
+#define METATILE_MAP_TILE_H(map) ((map)->h << (map)->block_shift)
+
+/**
+ * @brief Writes the `count` tilemap entries of tile row `y` from column `x` on
+ *        into `dest`, with the tile indices moved to `base_index`.
+ */
+void metatile_decode_row(const MetatileMap* map, u16 x, u16 y, u16 count, u16* dest, u16 base_index);
+
+/**
+ * @brief Writes the `count` tilemap entries of tile column `x` from row `y` on
+ *        into `dest`, with the tile indices moved to `base_index`.
+ */
+void metatile_decode_column(const MetatileMap* map, u16 x, u16 y, u16 count, u16* dest, u16 base_index);
+
+/**
+ * @brief Decodes the `w` x `h` tile area at (`x`, `y`) of the map and writes it
+ *        to the same cells of BG_A or BG_B, wrapped to the plane size, one DMA
+ *        per row (two where a row wraps).
+ * @param base_index First VRAM tile of the map's tileset.
+ * @return FALSE (reported) if the plane is invalid or the area is not inside the map.
+ */
+u8 metatile_load(const MetatileMap* map, VDPPlane plane, u16 x, u16 y, u16 w, u16 h, u16 base_index);
+
+#endif // METATILE_H
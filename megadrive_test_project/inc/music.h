@@ -6,8 +6,8 @@
 // Initializes the XGM music driver
 void music_init_driver(); // Renamed to avoid conflict if sound.c has init_sound_system
 
-// Starts playing an XGM track by its resource ID
-void music_start(u8 xgm_track_res_id);
+// Starts playing an XGM track (an XGM_MUSIC resource from resources.h)
+void music_start(const u8* xgm_track);
 
 // Stops XGM music playback
 void music_stop();
@@ -0,0 +1,65 @@
+/**
+ * @file palette_manager.h
+ * @brief RAM shadow of CRAM with one batched palette upload per frame.
+ *
+ * Every palette write in the project goes to a 64-color copy in RAM, and every
+ * palette read comes from it; CRAM is only read once, by
+ * `palette_manager_init()`. Writes widen a dirty range, and
+ * `palette_manager_commit()`, called once per frame right before
+ * `dma_scheduler_flush()`, queues that range as a single transfer at
+ * `DMA_PRIORITY_PALETTE`. Three colors changed in one frame therefore cost one
+ * DMA during VBlank instead of three CPU writes at random points of the frame.
+ *
+ * A color written now shows on screen after the next VBlank. Do not write CRAM
+ * with `VDP_setPalette*()` or SGDK's fades directly, or the shadow stops
+ * matching it; use `palette_manager_fade_to()` for fades.
+ */
+#ifndef PALETTE_MANAGER_H
+#define PALETTE_MANAGER_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Colors in CRAM (4 palettes of 16). */
+#define PALETTE_MANAGER_COLORS 64
+
+/** @brief Copies CRAM into the shadow and clears the dirty range. Call once at startup. */
+void palette_manager_init();
+
+/** @brief Sets one color (0-63). */
+void palette_manager_set_color(u16 index, u16 color);
+
+/** @brief Sets `count` colors starting at `index` (0-63). */
+void palette_manager_set_colors(u16 index, const u16* colors, u16 count);
+
+/** @brief Sets the 16 colors of palette `num` (PAL0-PAL3). */
+void palette_manager_set_palette(u16 num, const u16* colors);
+
+/** @brief Color `index` (0-63) as last written, committed or not. */
+u16 palette_manager_get_color(u16 index);
+
+/** @brief Copies the 16 colors of palette `num` (PAL0-PAL3) into `dest`. */
+void palette_manager_get_palette(u16 num, u16* dest);
+
+/**
+ * @brief Queues the colors written since the last commit as one CRAM transfer.
+ *        Call once per frame, right before `dma_scheduler_flush()`.
+ */
+void palette_manager_commit();
+
+/**
+ * @brief Writes the colors written since the last commit to CRAM right away, by CPU.
+ *        For code that no longer runs the main loop, such as the fatal error screen,
+ *        or that runs during VBlank.
+ */
+void palette_manager_commit_now();
+
+/**
+ * @brief Fades all 64 colors from their current values to `target` over `frames`
+ *        frames. Blocks, running one frame per step; returns once the last step
+ *        has reached CRAM.
+ * @param target 64 colors.
+ * @param frames Duration in frames (0 sets the colors at once).
+ */
+void palette_manager_fade_to(const u16* target, u16 frames);
+
+#endif // PALETTE_MANAGER_H
@@ -0,0 +1,76 @@
+/**
+ * @file parallax.h
+ * @brief Horizontal parallax bands on BG_A and BG_B through the line or tile-row scroll table.
+ *
+ * Each plane is split into horizontal bands, each moving at its own fraction
+ * of the camera speed, optionally with a per-line speed ramp (a floor seen in
+ * perspective) and a constant drift (clouds). The VDP reads one horizontal
+ * scroll value per line (`HSCROLL_LINE`, 224 entries) or per tile row
+ * (`HSCROLL_TILE`, 28 entries) from its VRAM table.
+ *
+ * The tables are not recomputed from the camera each frame. Every entry keeps
+ * a 16.16 position, and a camera move of `dx` pixels adds `dx * speed + drift`
+ * to it: one multiply per band, then one addition per entry (two along a ramp).
+ * A plane whose table changed is uploaded as one stepped DMA at
+ * `DMA_PRIORITY_SCROLL` (the VDP interleaves the BG_A and BG_B entries), and a
+ * plane that did not move is not uploaded at all.
+ *
+ * The mode switch goes through the scroll cache (vdp_cache.h), which stops
+ * writing its own horizontal values while the table is in use. Vertical scroll
+ * stays per plane and is still set through the cache.
+ */
+#ifndef PARALLAX_H
+#define PARALLAX_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most bands per plane. */
+#define PARALLAX_MAX_BANDS 8
+
+/** @brief A run of lines (or tile rows) scrolling together. Speeds are 8.8 fixed point. */
+typedef struct {
+    u16 first;  ///< First line (`HSCROLL_LINE`) or tile row (`HSCROLL_TILE`).
+    u16 count;  ///< Lines or tile rows in the band.
+    s16 speed;  ///< Pixels moved per camera pixel at the first entry (0x100: with the camera).
+    s16 ramp;   ///< Added to `speed` for each further entry of the band.
+    s16 drift;  ///< Pixels moved per frame whatever the camera does.
+} ParallaxBand;
+
+/** @brief Table generation counts for profiling. */
+typedef struct {
+    u32 updates;    ///< parallax_update() calls.
+    u32 uploads;    ///< Plane tables queued for upload.
+    u16 last_lines; ///< Scanlines spent updating the tables in the last call.
+    u16 peak_lines; ///< Most scanlines spent in one call.
+} ParallaxStats;
+
+/**
+ * @brief Switches the horizontal scroll mode to `HSCROLL_LINE` or `HSCROLL_TILE`
+ *        (from the next VBlank) with both planes at scroll 0 and no bands.
+ *        The camera is at 0.
+ */
+void parallax_init(u16 mode);
+
+/**
+ * @brief Replaces the bands of BG_A or BG_B. Entries outside every band keep
+ *        their current value. Positions restart at 0, as if the camera were at
+ *        0, so call this before moving the camera.
+ */
+void parallax_set_bands(VDPPlane plane, const ParallaxBand* bands, u16 count);
+
+/**
+ * @brief Moves the camera to `camera_x` and applies the drift of one frame,
+ *        then queues the tables that changed. Call once per frame.
+ */
+void parallax_update(s32 camera_x);
+
+/** @brief Returns the horizontal scroll mode to `HSCROLL_PLANE` (from the next VBlank). */
+void parallax_end();
+
+/** @brief Table generation counts. */
+const ParallaxStats* parallax_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `PLX` line. */
+void parallax_dump_klog();
+
+#endif // PARALLAX_H
@@ -0,0 +1,68 @@
+/**
+ * @file pc_sampler.h
+ * @brief Statistical PC-sampling profiler.
+ *
+ * A raw H-interrupt handler (`pc_sampler_hint.s`) reads the program counter of
+ * the code it interrupted straight from the 68000 exception frame and bumps a
+ * counter in a RAM histogram of ROM address buckets. By default the interrupt
+ * fires once per frame on the last active line, right before VBlank; lowering
+ * `PC_SAMPLER_LINES_PER_SAMPLE` samples several times per frame.
+ *
+ * The histogram is written to `KLog()` every `PC_SAMPLER_DUMP_INTERVAL` frames
+ * as a block of `PCS` lines. `tools/pc_symbolize.py` resolves the buckets
+ * against the ELF symbols kept by `make profile` and prints a per-function hot
+ * list (`make hotlist LOG=<captured debug log>`).
+ *
+ * The sampler owns the H-int vector while it runs, so it is opt-in
+ * (`PC_SAMPLER_ENABLED`, see `debug_config.h`) and compiles out otherwise.
+ */
+#ifndef PC_SAMPLER_H
+#define PC_SAMPLER_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief log2 of the histogram bucket size in bytes (64-byte buckets). */
+#define PC_SAMPLER_BUCKET_SHIFT 6
+/** @brief Size of the ROM area covered by the histogram, starting at address 0. */
+#define PC_SAMPLER_ROM_SPAN 0x20000
+/** @brief Number of histogram buckets (2048 buckets = 4KB of RAM). */
+#define PC_SAMPLER_BUCKET_COUNT (PC_SAMPLER_ROM_SPAN >> PC_SAMPLER_BUCKET_SHIFT)
+/**
+ * @brief Scanlines between samples. 224 samples once per frame at the end of
+ * active display; e.g. 16 gives 14 samples per frame.
+ */
+#ifndef PC_SAMPLER_LINES_PER_SAMPLE
+#define PC_SAMPLER_LINES_PER_SAMPLE 224
+#endif
+/** @brief Frames between automatic KLog dumps (30 seconds at 60Hz). */
+#define PC_SAMPLER_DUMP_INTERVAL 1800
+
+#if PC_SAMPLER_ENABLED
+
+/** @brief Clears the histogram and installs the H-int sampling handler. */
+void pc_sampler_init();
+
+/**
+ * @brief Records one sample. Called from the H-int handler only.
+ * @param pc Program counter of the interrupted code.
+ */
+void pc_sampler_record(u32 pc);
+
+/** @brief Counts frames and dumps the histogram every PC_SAMPLER_DUMP_INTERVAL frames. */
+void pc_sampler_end_frame();
+
+/** @brief Writes every non-empty bucket to `KLog()` as a PCS_BEGIN/PCS/PCS_END block. */
+void pc_sampler_dump_klog();
+
+#define PC_SAMPLER_INIT()       pc_sampler_init()
+#define PC_SAMPLER_END_FRAME()  pc_sampler_end_frame()
+
+#else
+
+#define PC_SAMPLER_INIT()       ((void)0)
+#define PC_SAMPLER_END_FRAME()  ((void)0)
+
+#endif // PC_SAMPLER_ENABLED
+
+#endif // PC_SAMPLER_H
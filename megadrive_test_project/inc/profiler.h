@@ -0,0 +1,99 @@
+/**
+ * @file profiler.h
+ * @brief Frame-budget profiler with named zones, measured in scanlines.
+ *
+ * A zone is a numbered, named section of code bracketed by
+ * `PROFILER_ZONE_BEGIN()` / `PROFILER_ZONE_END()`. Each time a zone ends, the
+ * number of scanlines it consumed (see `hv_timer.h`) is pushed into a small RAM
+ * ring buffer for that zone, from which min/avg/max are computed on demand.
+ *
+ * `main.c` uses the `GameState` value as the zone ID, so zones
+ * 0..(number of states - 1) are the per-state update zones. Other modules may
+ * use the IDs above that.
+ *
+ * In debug builds, pressing C toggles an overlay on text row 0 showing the
+ * statistics of the zone that ran last; each toggle also dumps every zone via
+ * `KLog()` to the emulator debug console.
+ *
+ * All of this is controlled by `PROFILER_ENABLED` (see `debug_config.h`). When
+ * it is 0 the macros below expand to nothing and `profiler.c` compiles to an
+ * empty object, so release ROMs carry no profiler code or data.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Maximum number of distinct zones. */
+#define PROFILER_MAX_ZONES 24
+/** @brief Number of samples kept per zone (one sample per zone per frame). */
+#define PROFILER_HISTORY_LENGTH 32
+/** @brief Button that toggles the overlay and triggers a KLog dump. */
+#define PROFILER_OVERLAY_BUTTON BUTTON_C
+
+/**
+ * @brief Statistics for one zone over the samples currently in its ring buffer.
+ * All values are in scanlines.
+ */
+typedef struct {
+    const char* name;  ///< Zone name given to `PROFILER_ZONE_BEGIN()`.
+    u16 min_lines;     ///< Fewest lines seen.
+    u16 avg_lines;     ///< Average lines.
+    u16 max_lines;     ///< Most lines seen.
+    u16 last_lines;    ///< Lines consumed by the most recent sample.
+    u16 sample_count;  ///< Number of valid samples (up to PROFILER_HISTORY_LENGTH).
+} ProfilerZoneStats;
+
+#if PROFILER_ENABLED
+
+/** @brief Clears all zones. Call once at startup. */
+void profiler_init();
+
+/**
+ * @brief Marks the start of a zone.
+ * @param zone_id Zone number, 0 to PROFILER_MAX_ZONES - 1.
+ * @param name Zone name (a string literal; only the pointer is stored).
+ */
+void profiler_zone_begin(u16 zone_id, const char* name);
+
+/**
+ * @brief Marks the end of a zone and records the elapsed scanlines.
+ * @param zone_id Zone number passed to the matching `profiler_zone_begin()`.
+ */
+void profiler_zone_end(u16 zone_id);
+
+/**
+ * @brief Computes min/avg/max for a zone.
+ * @param zone_id Zone number.
+ * @param stats Output structure.
+ * @return u8 TRUE if the zone has at least one sample, FALSE otherwise.
+ */
+u8 profiler_get_zone_stats(u16 zone_id, ProfilerZoneStats* stats);
+
+/**
+ * @brief Per-frame housekeeping: handles the overlay toggle button and redraws
+ *        the overlay. Call once per frame, after input_update().
+ */
+void profiler_end_frame();
+
+/** @brief Writes the statistics of every zone with samples to `KLog()`. */
+void profiler_dump_klog();
+
+#define PROFILER_INIT()                profiler_init()
+#define PROFILER_ZONE_BEGIN(id, name)  profiler_zone_begin((id), (name))
+#define PROFILER_ZONE_END(id)          profiler_zone_end(id)
+#define PROFILER_END_FRAME()           profiler_end_frame()
+#define PROFILER_DUMP()                profiler_dump_klog()
+
+#else
+
+#define PROFILER_INIT()                ((void)0)
+#define PROFILER_ZONE_BEGIN(id, name)  ((void)(id))  // `name` is dropped so its string never reaches the ROM
+#define PROFILER_ZONE_END(id)          ((void)(id))
+#define PROFILER_END_FRAME()           ((void)0)
+#define PROFILER_DUMP()                ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,88 @@
+/**
+ * @file raster_fx.h
+ * @brief Mid-frame palette, backdrop and vertical scroll changes from the H-interrupt.
+ *
+ * A state lists (line, action) entries: from line N on, color C is X, the
+ * backdrop is color B, or plane P is scrolled to Y. The list is sorted and
+ * compiled into a table of interrupt "fires", each holding ready-made VDP
+ * commands and the H-int counter value the VDP needs one fire ahead, so the
+ * handler (`raster_fx_hint.s`) only copies words to the VDP ports. That
+ * allows sky gradients, water lines and more than 64 colors on screen.
+ *
+ * A change for line N is made by the interrupt at the end of line N - 1,
+ * during its horizontal blank. Entries for line 0 set the top of the frame:
+ * they are applied again at the end of every frame (line 223), so give
+ * everything the list changes a line-0 entry holding its value above the first
+ * change. The line-0 colors and scroll are also handed to the palette manager
+ * and the scroll cache when effects start and stop, so their shadows hold the
+ * top of the frame; changes further down bypass them. Do not set a color or
+ * scroll the list changes through them while effects run.
+ *
+ * The handler's cost is computed from its instruction timings for every fire
+ * of the table (see `RasterFxStats`), not counting VDP wait states; a whole
+ * palette is 16 writes and outlasts the horizontal blank, so it shows CRAM
+ * dots on that line. Main-loop code that writes the VDP ports during active
+ * display while effects run must do so with interrupts disabled
+ * (`SYS_disableInts()`), or a fire can land between its address and data
+ * writes. Transfers made during VBlank are safe: the H-int never fires there.
+ * The profiler and VDP statistics overlays, which any state can show, already
+ * draw with interrupts disabled.
+ *
+ * The PC sampler (`make profile`) owns the H-int too; effects refuse to start
+ * in those builds.
+ */
+#ifndef RASTER_FX_H
+#define RASTER_FX_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most entries in one list. */
+#define RASTER_FX_MAX_ENTRIES 48
+
+/** @brief What an entry changes. */
+typedef enum {
+    RASTER_FX_COLOR,    ///< CRAM entry `target` (0-63) becomes `value`.
+    RASTER_FX_PALETTE,  ///< Palette `target` (PAL0-PAL3) becomes the 16 colors at `data`.
+    RASTER_FX_BACKDROP, ///< The backdrop becomes CRAM entry `value`.
+    RASTER_FX_VSCROLL   ///< Plane `target` (BG_A or BG_B) is scrolled vertically to `value`.
+} RasterFxAction;
+
+/** @brief One change. */
+typedef struct {
+    u16 line;        ///< First line (0-223) showing the change.
+    u16 action;      ///< A RasterFxAction.
+    u16 target;      ///< Color, palette or plane, depending on `action`.
+    u16 value;       ///< Color, backdrop index or scroll value, depending on `action`.
+    const u16* data; ///< Colors for RASTER_FX_PALETTE; must stay valid while the list is in use.
+} RasterFxEntry;
+
+/** @brief Cost of the current table, from the handler's instruction timings. */
+typedef struct {
+    u16 fires;          ///< Interrupts per frame (the list's lines, plus the fixed ones at lines 0, 1 and 223).
+    u16 peak_cycles;    ///< Cycles of the most expensive fire, interrupt entry and exit included.
+    u32 frame_cycles;   ///< Cycles of all fires of one frame.
+    u32 fired;          ///< Fires counted by the handler since startup.
+} RasterFxStats;
+
+/**
+ * @brief Replaces the list. The new table takes over at the end of a frame, so
+ *        a list can be rebuilt every frame (e.g. a moving water line). The first
+ *        call waits for VBlank, applies the line-0 entries and enables the H-int.
+ * @return FALSE (reported) if an entry is invalid, the list is too long, or
+ *         the H-int is owned by the PC sampler.
+ */
+u8 raster_fx_set(const RasterFxEntry* entries, u16 count);
+
+/**
+ * @brief Waits for VBlank, disables the H-int and applies the line-0 entries
+ *        of the last list through the palette manager and the scroll cache.
+ */
+void raster_fx_stop();
+
+/** @brief Cost of the current table. */
+const RasterFxStats* raster_fx_get_stats();
+
+/** @brief Writes the cost to `KLog()` as one `RFX` line. */
+void raster_fx_dump_klog();
+
+#endif // RASTER_FX_H
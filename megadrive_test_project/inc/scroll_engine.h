@@ -0,0 +1,79 @@
+/**
+ * @file scroll_engine.h
+ * @brief Camera over a metatile map of any size, streaming plane edges as it moves.
+ *
+ * The plane is used as a ring buffer: map tile (x, y) always lives in plane
+ * cell (x mod plane width, y mod plane height), and the plane's own wrap-around
+ * does the rest. Only the tiles under the screen (41x29 with the partly
+ * visible ones) are kept valid. When the camera crosses a tile boundary, the
+ * column or row that comes into view is decoded from the metatile map and
+ * queued on the DMA scheduler at `DMA_PRIORITY_SCROLL`, so it is written during
+ * VBlank, together with the scroll values set through the scroll cache.
+ *
+ * The cost per frame depends on the camera speed, not on the map size: one
+ * 29-tile column and/or one 41-tile row per 8 pixels moved. A move of more than
+ * `SCROLL_ENGINE_MAX_EDGES` tiles in one frame (a jump) reloads the whole view
+ * instead, also through the DMA scheduler: about 3.7KB, sent whole.
+ *
+ * The screen is assumed to be 320x224 (H40, V28), and the plane 64x32 or 64x64.
+ * There is a single camera. Camera positions are 32-bit world pixels, so a map
+ * can be up to `SCROLL_ENGINE_MAX_MAP_TILES` tiles on each side.
+ */
+#ifndef SCROLL_ENGINE_H
+#define SCROLL_ENGINE_H
+
+#include <genesis.h> // SGDK general header
+#include "metatile.h" // For MetatileMap
+
+/** @brief Visible area in pixels. */
+#define SCROLL_ENGINE_SCREEN_W 320
+#define SCROLL_ENGINE_SCREEN_H 224
+
+/** @brief Largest map side in tiles: the engine keeps tile coordinates in 16 bits. */
+#define SCROLL_ENGINE_MAX_MAP_TILES 0xFFFF
+
+/** @brief Plane width in tiles the engine works with. */
+#define SCROLL_ENGINE_PLANE_WIDTH 64
+
+/** @brief Most columns (and, separately, rows) streamed in one frame; a longer move reloads the view. */
+#define SCROLL_ENGINE_MAX_EDGES 4
+
+/** @brief Streaming counts for profiling. */
+typedef struct {
+    u32 columns;    ///< Columns streamed.
+    u32 rows;       ///< Rows streamed.
+    u32 reloads;    ///< Whole-view loads (init and jumps).
+    u16 overruns;   ///< Reloads made because the edge buffers an update needed were still queued.
+    u16 last_lines; ///< Scanlines spent decoding and queueing edges in the last camera update.
+    u16 peak_lines; ///< Most scanlines spent in one camera update.
+} ScrollEngineStats;
+
+/**
+ * @brief Shows `map` on `plane` with the camera at (`x`, `y`), clamped to the map.
+ *        Queues the visible tiles, which show from the next flush. A map larger than
+ *        `SCROLL_ENGINE_MAX_MAP_TILES` on a side is reported and not shown.
+ * @param base_index First VRAM tile of the map's tileset.
+ */
+void scroll_engine_init(VDPPlane plane, const MetatileMap* map, u16 base_index, s32 x, s32 y);
+
+/**
+ * @brief Moves the camera to (`x`, `y`) pixels, clamped to the map, queues the
+ *        tiles that came into view and sets the plane scroll. Call once per frame.
+ */
+void scroll_engine_set_camera(s32 x, s32 y);
+
+/** @brief Camera position after clamping. */
+s32 scroll_engine_get_x();
+s32 scroll_engine_get_y();
+
+/** @brief Largest camera position: map size minus screen size, in pixels. */
+s32 scroll_engine_get_max_x();
+s32 scroll_engine_get_max_y();
+
+/** @brief Streaming counts. */
+const ScrollEngineStats* scroll_engine_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `SCRL` line. */
+void scroll_engine_dump_klog();
+
+#endif // SCROLL_ENGINE_H
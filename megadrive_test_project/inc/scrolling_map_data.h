@@ -1,11 +0,0 @@
-#ifndef SCROLLING_MAP_DATA_H
-#define SCROLLING_MAP_DATA_H
-
-#include <genesis.h> // For u16
-
-#define SCROLLING_MAP_WIDTH 64
-#define SCROLLING_MAP_HEIGHT 32
-
-extern const u16 scrolling_map_data[SCROLLING_MAP_HEIGHT][SCROLLING_MAP_WIDTH];
-
-#endif // SCROLLING_MAP_DATA_H
@@ -0,0 +1,86 @@
+/**
+ * @file soak.h
+ * @brief Long-running soak test for the `make soak` ROM.
+ *
+ * The soak ROM skips the loading screen and drives the test menu by itself
+ * through a scripted input provider, like the benchmark ROM (see `bench.h`).
+ * One cycle enters every menu entry in turn, runs it for `SOAK_FRAMES_PER_TEST`
+ * frames without input and exits back to the menu with Start. The ROM runs
+ * `SOAK_CYCLES` cycles.
+ *
+ * After each cycle, back in the menu, it checks:
+ * - per state, the free heap lost over all its visits so far (`MEM_getFree()`
+ *   in the menu before entering, minus after exiting),
+ * - the plane size, which every test should leave as it found it,
+ * - per state, the sprite engine at the end of the visit: active sprites,
+ *   hardware sprites in use and free sprite VRAM (states that leave the sprite
+ *   engine off are skipped),
+ * - per state, the average frame time in scanlines.
+ *
+ * The value at the end of cycle `SOAK_WARMUP_CYCLES` is the baseline. A metric
+ * is flagged once it has been worse than the baseline and has not improved for
+ * `SOAK_TREND_CYCLES` cycles in a row, i.e. it grows (or shrinks) monotonically.
+ * A changed plane size is flagged at once.
+ *
+ * Results go to the emulator debug port (KLog):
+ * `SOAK cycle=<n> heap_free=<n> flags=<n>` after each cycle,
+ * `SOAK_FLAG cycle=<n> metric=<name> state=<name> baseline=<n> now=<n>` for
+ * each flagged metric (once per metric), framed by `SOAK_BEGIN` and
+ * `SOAK_END cycles=<n> flags=<n>` lines.
+ *
+ * Only compiled when `SOAK_ENABLED` (see `debug_config.h`).
+ */
+#ifndef SOAK_H
+#define SOAK_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Cycles through the whole menu before the ROM reports SOAK_END (about 16 hours at 60Hz). */
+#ifndef SOAK_CYCLES
+#define SOAK_CYCLES 2000
+#endif
+/** @brief Frames each test runs for once entered. */
+#define SOAK_FRAMES_PER_TEST 120
+/** @brief Idle frames in the menu before navigating to the next test. */
+#define SOAK_SETTLE_FRAMES 10
+/** @brief Cycles run before the baseline is taken, so one-time allocations are not counted. */
+#define SOAK_WARMUP_CYCLES 2
+/** @brief Cycles a metric must stay worse than the baseline without improving before it is flagged. */
+#define SOAK_TREND_CYCLES 8
+/** @brief Maximum number of states tracked (must cover every GameState). */
+#define SOAK_MAX_STATES 24
+
+#if SOAK_ENABLED
+
+/**
+ * @brief Resets the soak sequence, records the starting plane size and installs the scripted input provider.
+ * @param state_names Display name per state, indexed by state value (only the pointers are stored).
+ * @param count Number of states.
+ */
+void soak_init(const char* const* state_names, u16 count);
+
+/** @brief Call at the top of the main loop, before `input_update()`. */
+void soak_frame_begin();
+
+/**
+ * @brief Call right before `SYS_doVBlankProcess()`. Records the frame time, runs
+ *        the checks at the end of a cycle and decides the scripted input for the next frame.
+ * @param state State that ran this iteration.
+ * @param in_menu TRUE if the game is currently in the test menu.
+ */
+void soak_frame_end(u16 state, u8 in_menu);
+
+#define SOAK_INIT(names, count)          soak_init((names), (count))
+#define SOAK_FRAME_BEGIN()               soak_frame_begin()
+#define SOAK_FRAME_END(state, in_menu)   soak_frame_end((state), (in_menu))
+
+#else
+
+#define SOAK_INIT(names, count)          ((void)(count))
+#define SOAK_FRAME_BEGIN()               ((void)0)
+#define SOAK_FRAME_END(state, in_menu)   ((void)(state), (void)(in_menu))
+
+#endif // SOAK_ENABLED
+
+#endif // SOAK_H
@@ -0,0 +1,74 @@
+/**
+ * @file sprite_flicker.h
+ * @brief Detects sprite overflow per scanline band and rotates which sprites are dropped.
+ *
+ * In H40 the VDP shows at most 20 hardware sprites on a line and 80 in all;
+ * past that, sprites later in the list silently vanish, and always the same
+ * ones. This manager tracks the sprites registered with it, and each frame,
+ * before `SPR_update()`:
+ *
+ * 1. counts the hardware sprites (one per 32 pixels of frame width) each
+ *    sprite puts on every 8-line band it covers;
+ * 2. if a band, or the total, is over the limit, walks the sprites once
+ *    starting from a rotating position, keeps each sprite whose bands still
+ *    have room and hides the others (`SPR_setVisibility()`);
+ * 3. starts the next frame's walk at the first sprite it hid, so the sprites
+ *    dropped this frame are kept next frame and the dropped set cycles.
+ *
+ * Overflowing objects therefore flicker instead of disappearing. Both passes
+ * are linear in the number of sprites (a sprite covers at most 5 bands), and
+ * a frame without overflow only costs the counting pass.
+ *
+ * Bands are coarser than lines: two sprites in one band count against each
+ * other even if they share no line, so the manager drops a sprite slightly
+ * earlier than the VDP would. Sprites fully off screen are hidden too, so
+ * they do not use up the 80 hardware sprites.
+ *
+ * The manager owns the visibility of registered sprites. With flicker
+ * disabled it still counts and reports, but shows every on-screen sprite,
+ * which shows what the VDP does on its own.
+ */
+#ifndef SPRITE_FLICKER_H
+#define SPRITE_FLICKER_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most sprites the manager tracks (the VDP's sprite limit in H40). */
+#define SPRITE_FLICKER_MAX 80
+/** @brief Hardware sprites the VDP shows on one line in H40. */
+#define SPRITE_FLICKER_LINE_LIMIT 20
+/** @brief Lines per counting band. */
+#define SPRITE_FLICKER_BAND_LINES 8
+
+/** @brief Overflow counts for profiling. */
+typedef struct {
+    u32 frames;          ///< sprite_flicker_update() calls.
+    u32 overflow_frames; ///< Frames with at least one band, or the total, over the limit.
+    u32 hidden_total;    ///< Sprites hidden to make room, summed over all frames.
+    u16 last_bands;      ///< Bands over the limit in the last frame.
+    u16 last_hidden;     ///< Sprites hidden to make room in the last frame.
+    u16 peak_band;       ///< Most hardware sprites ever asked for in one band.
+} SpriteFlickerStats;
+
+/** @brief Forgets every sprite and clears the counts. Call after `SPR_init()`. */
+void sprite_flicker_init();
+
+/** @brief Starts managing `sprite`. Does nothing (reported) once SPRITE_FLICKER_MAX are tracked. */
+void sprite_flicker_add(Sprite* sprite);
+
+/** @brief Stops managing `sprite`; call before releasing it. Its visibility is left as it is. */
+void sprite_flicker_remove(Sprite* sprite);
+
+/** @brief Turns the rotation on (default) or off. Counting and stats go on either way. */
+void sprite_flicker_set_enabled(u8 enabled);
+
+/** @brief Counts, and hides sprites where needed. Call once per frame, after moving sprites and before `SPR_update()`. */
+void sprite_flicker_update();
+
+/** @brief Overflow counts. */
+const SpriteFlickerStats* sprite_flicker_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `FLICKER` line. */
+void sprite_flicker_dump_klog();
+
+#endif // SPRITE_FLICKER_H
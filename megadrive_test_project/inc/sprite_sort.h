@@ -0,0 +1,65 @@
+/**
+ * @file sprite_sort.h
+ * @brief Keeps registered sprites in Y order (lower on screen drawn in front) incrementally.
+ *
+ * Top-down and beat-'em-up scenes draw a sprite in front of another when its
+ * feet are lower on screen. The sprite engine draws in depth order, keeping
+ * its sprites in a linked list sorted by `SPR_setDepth()`; every depth change
+ * moves that sprite through the list.
+ *
+ * This layer keeps its own array of the registered sprites in the order of
+ * the last frame, with each sprite's key (the bottom edge of its frame).
+ * Sprites move a few pixels per frame, so that array is nearly sorted for the
+ * new keys, and an insertion sort restores it in about n comparisons plus one
+ * move per pair of sprites that crossed. Each sprite's depth is its rank in
+ * the array, and `SPR_setDepth()` is only called for sprites whose rank
+ * changed: only the engine's list links around sprites that crossed are
+ * rewritten, instead of re-sorting all 80 sprites every frame.
+ *
+ * Registered sprites use depths 0 to count - 1 (0 in front). Give sprites
+ * that must stay in front of them, such as a HUD, negative depths.
+ */
+#ifndef SPRITE_SORT_H
+#define SPRITE_SORT_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most sprites the layer orders. */
+#define SPRITE_SORT_MAX 80
+
+/** @brief Sorting counts for profiling. */
+typedef struct {
+    u32 updates;        ///< sprite_sort_update() calls.
+    u32 moves_total;    ///< Array moves made by the insertion sort, over all updates.
+    u32 depth_total;    ///< SPR_setDepth() calls, over all updates.
+    u16 last_moves;     ///< Array moves in the last update.
+    u16 last_depth;     ///< SPR_setDepth() calls in the last update.
+    u16 last_lines;     ///< Scanlines spent in the last update.
+    u16 peak_lines;     ///< Most scanlines spent in one update.
+} SpriteSortStats;
+
+/** @brief Forgets every sprite and clears the counts. */
+void sprite_sort_init();
+
+/** @brief Starts ordering `sprite`; it gets its place on the next update. Reported once SPRITE_SORT_MAX are tracked. */
+void sprite_sort_add(Sprite* sprite);
+
+/** @brief Stops ordering `sprite`; call before releasing it. The sprites behind it move up a depth on the next update. */
+void sprite_sort_remove(Sprite* sprite);
+
+/**
+ * @brief Forgets the depths given so far, so the next update sets every
+ *        sprite's depth again. Call after setting their depths some other way.
+ */
+void sprite_sort_invalidate();
+
+/** @brief Re-sorts by the sprites' current positions. Call once per frame, after moving them and before `SPR_update()`. */
+void sprite_sort_update();
+
+/** @brief Sorting counts. */
+const SpriteSortStats* sprite_sort_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `YSORT` line. */
+void sprite_sort_dump_klog();
+
+#endif // SPRITE_SORT_H
@@ -0,0 +1,85 @@
+/**
+ * @file sprite_stream.h
+ * @brief Streams sprite frames into a shared VRAM frame cache instead of keeping every frame resident.
+ *
+ * With automatic tile upload, the sprite engine reserves `maxNumTile` tiles
+ * of its VRAM for every sprite and uploads its frame there on each change.
+ * Characters with many large frames, or crowds of identical enemies, run out
+ * of that space quickly.
+ *
+ * This module owns a range of slots from the VRAM allocator, each large
+ * enough for one frame, and keys every slot by the `AnimationFrame` it holds.
+ * Registered sprites get auto tile upload turned off and point at the slot
+ * holding their current frame. When a sprite changes frame, the frame is
+ * looked up first: identical enemies showing the same frame share one slot
+ * and nothing is uploaded (a hit). Otherwise a free slot, or the least
+ * recently used slot no other sprite points at (possibly the sprite's own),
+ * receives the frame's tiles through the DMA scheduler at sprite priority (a
+ * miss). With at least as many slots as sprites, a sprite always finds one;
+ * with fewer, sprites sharing a slot can hold each other's changes off.
+ *
+ * Uploads are capped at a number of tiles per frame. A frame change past the
+ * cap, or with every slot in use, is deferred: the sprite keeps its old tiles
+ * and is retried on the next update.
+ *
+ * Frames are DMA'd straight from ROM, so streamed sprites must be declared
+ * with `NONE` compression in resources.res. Frame changes are picked up in
+ * sprite_stream_update(), so animate with `SPR_setFrame()` (as the entity pool
+ * does) rather than with rescomp frame timers, which SPR_update() applies.
+ */
+#ifndef SPRITE_STREAM_H
+#define SPRITE_STREAM_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Most sprites that can be streamed at once. */
+#define SPRITE_STREAM_MAX_SPRITES 80
+/** @brief Most frame slots in the cache. */
+#define SPRITE_STREAM_MAX_SLOTS 32
+/** @brief Tiles uploaded per frame at most, unless set (2KB of the VBlank DMA budget). */
+#define SPRITE_STREAM_DEFAULT_BUDGET 64
+
+/** @brief Cache counts for profiling. */
+typedef struct {
+    u32 hits;            ///< Frame changes served by a slot already holding the frame.
+    u32 misses;          ///< Frame changes that uploaded the frame.
+    u32 evictions;       ///< Misses that replaced another frame.
+    u32 deferred;        ///< Frame changes put off by the budget or a cache with every slot in use.
+    u32 tiles_uploaded;  ///< Tiles queued by misses.
+    u32 tiles_skipped;   ///< Tile uploads avoided by hits.
+    u16 last_tiles;      ///< Tiles queued by the last update.
+    u16 slots;           ///< Slots in the cache.
+    u16 slot_tiles;      ///< Tiles per slot.
+    u16 slots_used;      ///< Slots holding a frame.
+    u16 sprites;         ///< Sprites registered.
+} SpriteStreamStats;
+
+/**
+ * @brief Acquires `slots` slots of `slot_tiles` tiles each from the VRAM
+ *        allocator, forgets any registered sprite and clears the counts.
+ * @return TRUE on success, FALSE (reported) if the allocator has no room.
+ */
+u8 sprite_stream_init(u16 slots, u16 slot_tiles);
+
+/** @brief Gives every registered sprite back to the engine's own VRAM management and releases the cache's range. */
+void sprite_stream_end();
+
+/** @brief Streams `sprite`'s frames from now on; it is bound to a slot on the next update. */
+void sprite_stream_add(Sprite* sprite);
+
+/** @brief Stops streaming `sprite` and gives it back to automatic VRAM allocation and upload. Call before releasing it. */
+void sprite_stream_remove(Sprite* sprite);
+
+/** @brief Sets how many tiles one update may upload. */
+void sprite_stream_set_budget(u16 tiles);
+
+/** @brief Binds every sprite whose frame changed to a slot. Call once per frame, after animating and before `SPR_update()`. */
+void sprite_stream_update();
+
+/** @brief Cache counts. */
+const SpriteStreamStats* sprite_stream_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `SPRSTREAM` line. */
+void sprite_stream_dump_klog();
+
+#endif // SPRITE_STREAM_H
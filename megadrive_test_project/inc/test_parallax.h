@@ -0,0 +1,8 @@
+#ifndef TEST_PARALLAX_H
+#define TEST_PARALLAX_H
+
+void parallax_test_init();
+void parallax_test_update();
+void parallax_test_on_exit();
+
+#endif // TEST_PARALLAX_H
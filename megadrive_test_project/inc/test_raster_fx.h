@@ -0,0 +1,8 @@
+#ifndef TEST_RASTER_FX_H
+#define TEST_RASTER_FX_H
+
+void raster_fx_test_init();
+void raster_fx_test_update();
+void raster_fx_test_on_exit();
+
+#endif // TEST_RASTER_FX_H
@@ -0,0 +1,13 @@
+#ifndef TEST_SPRITE_FLICKER_H
+#define TEST_SPRITE_FLICKER_H
+
+// Sprite flicker demo: 32 entities crowd a horizontal strip, well past the 20
+// sprites a line can show, while 8 more roam the screen. A toggles the flicker
+// manager, to compare rotating drops with the VDP's own (always the same
+// sprites vanish).
+
+void test_sprite_flicker_init();
+void test_sprite_flicker_update();
+void test_sprite_flicker_on_exit();
+
+#endif // TEST_SPRITE_FLICKER_H
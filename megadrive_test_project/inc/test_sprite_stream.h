@@ -0,0 +1,13 @@
+#ifndef TEST_SPRITE_STREAM_H
+#define TEST_SPRITE_STREAM_H
+
+// Sprite streaming demo: 40 identical walkers animate out of step, their
+// frames streamed through the sprite_stream cache. A toggles streaming, to
+// compare the cache's VRAM and uploads with the sprite engine's automatic
+// per-sprite allocation.
+
+void test_sprite_stream_init();
+void test_sprite_stream_update();
+void test_sprite_stream_on_exit();
+
+#endif // TEST_SPRITE_STREAM_H
@@ -0,0 +1,16 @@
+#ifndef TEST_STRESS_DMA_H
+#define TEST_STRESS_DMA_H
+
+// VDP transfer throughput test: writes the same screen-sized block of words
+// (40x28 tilemap entries) with four methods - a VDP_setTileMapXY() loop,
+// VDP_setTileMapData() DMA per row, a tilemap_blit rectangle pushed by CPU per
+// row, and a DMA fill - and reports each method's cost in scanlines and the
+// words per frame it could sustain.
+// Transfers run during active display, where DMA is slowest, so the figures
+// are a lower bound for what fits into VBlank-heavy code.
+
+void test_stress_dma_init();
+void test_stress_dma_update();
+void test_stress_dma_on_exit();
+
+#endif // TEST_STRESS_DMA_H
@@ -0,0 +1,15 @@
+#ifndef TEST_STRESS_ENTITIES_H
+#define TEST_STRESS_ENTITIES_H
+
+// Entity pool stress test: ramps the entity pool from 8 to ENTITY_POOL_MAX
+// bouncing entities, 8 more every 8 frames, while one entity is despawned and
+// respawned every frame. The first 64 carry a `spr_player` sprite; the rest
+// run the same update without one. The update cost per entity, and the number
+// of entities that would fit in a frame at that cost, are shown on screen and
+// written to KLog.
+
+void test_stress_entities_init();
+void test_stress_entities_update();
+void test_stress_entities_on_exit();
+
+#endif // TEST_STRESS_ENTITIES_H
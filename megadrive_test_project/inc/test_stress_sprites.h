@@ -0,0 +1,12 @@
+#ifndef TEST_STRESS_SPRITES_H
+#define TEST_STRESS_SPRITES_H
+
+// Sprite stress test: adds moving `spr_player` sprites one at a time, from 1 up
+// to the VDP limit of 80, until a frame is dropped. The largest count that ran
+// without lag is shown on screen and written to KLog as the sustained capacity.
+
+void test_stress_sprites_init();
+void test_stress_sprites_update();
+void test_stress_sprites_on_exit();
+
+#endif // TEST_STRESS_SPRITES_H
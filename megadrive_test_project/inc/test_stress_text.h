@@ -0,0 +1,12 @@
+#ifndef TEST_STRESS_TEXT_H
+#define TEST_STRESS_TEXT_H
+
+// Text stress test: redraws a full screen of VDP_drawText() rows every frame
+// and reports the cost of one redraw in scanlines and the characters per frame
+// that could be drawn if nothing else ran.
+
+void test_stress_text_init();
+void test_stress_text_update();
+void test_stress_text_on_exit();
+
+#endif // TEST_STRESS_TEXT_H
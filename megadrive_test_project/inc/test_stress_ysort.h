@@ -0,0 +1,14 @@
+#ifndef TEST_STRESS_YSORT_H
+#define TEST_STRESS_YSORT_H
+
+// Y-sort stress test: moves 20, then 40, then 80 entities around the screen
+// and orders their sprites by Y each frame, first with sprite_sort's
+// incremental insertion sort, then with a full re-sort (Shell sort from the
+// registration order, every depth rewritten). The average cycles of each are
+// shown on screen and written to KLog as `STRESS ysort` lines.
+
+void test_stress_ysort_init();
+void test_stress_ysort_update();
+void test_stress_ysort_on_exit();
+
+#endif // TEST_STRESS_YSORT_H
@@ -0,0 +1,56 @@
+/**
+ * @file tilemap_blit.h
+ * @brief Rectangular tilemap writes built in RAM and pushed one row run at a time.
+ *
+ * Instead of one `VDP_setTileMapXY()` per cell - which sets the VDP address and
+ * writes a single word every time - a rectangle is first built in a RAM buffer
+ * with the full tile attributes already in each entry, then pushed with
+ * `tilemap_blit_push()`. Each row is written as one `VDP_setTileMapData()`
+ * transfer: the address is set once and the words follow through the VDP's
+ * auto-increment (CPU) or one DMA.
+ *
+ * Cells left at `TILEMAP_BLIT_SKIP` are not written, so a row with holes splits
+ * into several transfers and whatever the plane holds there stays.
+ *
+ * There is a single buffer: build and push one rectangle before starting the
+ * next. Only BG_A and BG_B are supported.
+ */
+#ifndef TILEMAP_BLIT_H
+#define TILEMAP_BLIT_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Largest rectangle, in cells (one H40 screen). */
+#define TILEMAP_BLIT_MAX_CELLS (40 * 28)
+
+/** @brief Cell value meaning "leave the plane as it is". */
+#define TILEMAP_BLIT_SKIP 0xFFFF
+
+/**
+ * @brief Starts a `w` x `h` rectangle with every cell set to `TILEMAP_BLIT_SKIP`.
+ * @return FALSE (reported) if the rectangle is empty or larger than `TILEMAP_BLIT_MAX_CELLS`.
+ */
+u8 tilemap_blit_begin(u16 w, u16 h);
+
+/** @brief Sets the cell at (`x`, `y`), relative to the rectangle, to `tile` (full attributes). */
+void tilemap_blit_set(u16 x, u16 y, u16 tile);
+
+/** @brief Sets a `w` x `h` area of cells, relative to the rectangle, to `tile` (full attributes). */
+void tilemap_blit_fill(u16 x, u16 y, u16 w, u16 h, u16 tile);
+
+/**
+ * @brief Writes the rectangle to `plane` with its top-left cell at (`x`, `y`),
+ *        one transfer per run of non-skipped cells in each row.
+ * @param tm `CPU` or `DMA`. `DMA_QUEUE` is refused, as the buffer is reused by
+ *           the next rectangle before the queue is flushed.
+ */
+void tilemap_blit_push(VDPPlane plane, u16 x, u16 y, TransferMethod tm);
+
+/**
+ * @brief VRAM address of `plane`'s tilemap, for `VDP_setTileMapData()` and
+ *        the other calls that take one.
+ * @return The address, or 0 (reported) for anything but BG_A and BG_B.
+ */
+u16 tilemap_blit_plane_address(VDPPlane plane);
+
+#endif // TILEMAP_BLIT_H
@@ -0,0 +1,69 @@
+/**
+ * @file vdp_cache.h
+ * @brief Cached plane scroll values, written to the VDP once per frame during VBlank.
+ *
+ * Modules set the scroll here instead of calling `VDP_setHorizontalScroll()` /
+ * `VDP_setVerticalScroll()`. A value equal to the one already requested is
+ * dropped. Changed values are latched and written from SGDK's VBlank process
+ * callback (`SYS_setVBlankCallback()`), which `SYS_doVBlankProcess()` runs once
+ * VBlank has started, and only if they differ from what the VDP already holds.
+ * A test that scrolls only while the D-Pad is held therefore writes nothing
+ * while it stands still, and a scroll change never lands mid-screen.
+ *
+ * The callback runs in the main loop's context, not in the V-int handler, so it
+ * cannot interrupt another VDP port access.
+ *
+ * A value set now is on screen from the next frame on. Calling the SGDK scroll
+ * functions directly bypasses the cache and is undone at the next commit.
+ *
+ * The horizontal scroll mode is switched here too, so the switch also lands in
+ * VBlank. In the line and tile modes the VRAM scroll table belongs to whoever
+ * fills it (see parallax.h); horizontal values set here are then only latched,
+ * and written once the plane mode is back.
+ */
+#ifndef VDP_CACHE_H
+#define VDP_CACHE_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Write counts for profiling. */
+typedef struct {
+    u32 requested;  ///< Set calls.
+    u32 dropped;    ///< Set calls that repeated the requested value.
+    u32 committed;  ///< Values written to the VDP during VBlank.
+} VdpCacheStats;
+
+/**
+ * @brief Installs the VBlank process callback and schedules a write of every
+ *        cached value (scroll 0) on the first commit. Call once at startup.
+ */
+void vdp_cache_init();
+
+/**
+ * @brief Requests the horizontal scroll mode: `HSCROLL_PLANE` (the default),
+ *        `HSCROLL_TILE` or `HSCROLL_LINE`. Vertical scroll stays per plane.
+ */
+void vdp_cache_set_hscroll_mode(u16 mode);
+
+/** @brief Horizontal scroll mode last requested. */
+u16 vdp_cache_get_hscroll_mode();
+
+/** @brief Requests the horizontal scroll of BG_A or BG_B (whole-plane scroll mode). */
+void vdp_cache_set_hscroll(VDPPlane plane, s16 value);
+
+/** @brief Requests the vertical scroll of BG_A or BG_B (whole-plane scroll mode). */
+void vdp_cache_set_vscroll(VDPPlane plane, s16 value);
+
+/** @brief Horizontal scroll last requested for BG_A or BG_B. */
+s16 vdp_cache_get_hscroll(VDPPlane plane);
+
+/** @brief Vertical scroll last requested for BG_A or BG_B. */
+s16 vdp_cache_get_vscroll(VDPPlane plane);
+
+/** @brief Write counts. */
+const VdpCacheStats* vdp_cache_get_stats();
+
+/** @brief Writes the counts to `KLog()` as one `VDPC` line. */
+void vdp_cache_dump_klog();
+
+#endif // VDP_CACHE_H
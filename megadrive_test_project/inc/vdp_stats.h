@@ -0,0 +1,265 @@
+/**
+ * @file vdp_stats.h
+ * @brief Per-frame VDP traffic accounting, broken down by calling module.
+ *
+ * When enabled, this header replaces the SGDK VDP write functions the project
+ * uses (tilemap, text, tile upload, palette and scroll calls) with inline
+ * wrappers that count the call, the words it writes to VRAM, CRAM or VSRAM and,
+ * for `DMA_QUEUE` transfers, the bytes it queues, before calling the real
+ * function. Counts are charged to the source file the call was compiled in
+ * (`__BASE_FILE__`), so no call site has to be changed.
+ *
+ * The makefile force-includes this header into every project source when it is
+ * built with `make VDP_STATS=1`, which also sets `VDP_STATS_ENABLED` (see
+ * `debug_config.h`). It is opt-in because the wrappers add a function call to
+ * every VDP write, which skews the profiler's timings.
+ *
+ * Word counts are what the call asks the VDP to write. Work SGDK does on its
+ * own (the sprite engine's SAT upload, palette fades running asynchronously) is
+ * not attributed to a module; the total bytes in SGDK's DMA queue at the end of
+ * the frame are recorded separately.
+ *
+ * Viewing the numbers:
+ * - Pressing `VDP_STATS_OVERLAY_BUTTON` toggles an overlay on text row 1 with
+ *   the last frame's totals and the module that wrote the most words; each
+ *   toggle also dumps every module via `KLog()`.
+ * - The "Debug: Frame Stats" screen has a page with per-module averages and
+ *   peaks, and its A button writes the totals to `KLog()` as `VDPS` lines.
+ */
+#ifndef VDP_STATS_H
+#define VDP_STATS_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Source files tracked, the last slot being "other" for any file past the rest. */
+#define VDP_STATS_MAX_MODULES 48
+/** @brief Same button as the profiler overlay, so C shows both overlays (rows 0 and 1). */
+#define VDP_STATS_OVERLAY_BUTTON BUTTON_C
+/** @brief Marks a source file whose module slot has not been assigned yet. */
+#define VDP_STATS_UNREGISTERED 0xFF
+
+/** @brief Which VDP memory a write goes to. */
+typedef enum {
+    VDP_STATS_VRAM,
+    VDP_STATS_CRAM,
+    VDP_STATS_VSRAM
+} VdpStatsTarget;
+
+/** @brief Traffic counters for one frame, or summed over several frames. */
+typedef struct {
+    u32 calls;        ///< VDP write calls.
+    u32 vram_words;   ///< Words written to VRAM (tiles, tilemaps, H scroll table).
+    u32 cram_words;   ///< Words written to CRAM (colors).
+    u32 vsram_words;  ///< Words written to VSRAM (vertical scroll).
+    u32 dma_bytes;    ///< Bytes queued with DMA_QUEUE / DMA_QUEUE_COPY.
+} VdpStatsCounters;
+
+/** @brief Traffic recorded for one source file. */
+typedef struct {
+    const char* name;          ///< Source file name without directory or extension.
+    VdpStatsCounters frame;    ///< Frame in progress.
+    VdpStatsCounters last;     ///< Last completed frame.
+    VdpStatsCounters total;    ///< Sum of all completed frames since vdp_stats_init().
+    VdpStatsCounters peak;     ///< Frame with the most words written (all memories).
+} VdpStatsModule;
+
+#if VDP_STATS_ENABLED
+
+/** @brief Clears all counters. Call once at startup. */
+void vdp_stats_init();
+
+/**
+ * @brief Charges one VDP call to a source file. Called by the wrappers below.
+ * @param module_slot The calling file's slot, assigned on its first call.
+ * @param file The calling file's `__BASE_FILE__`.
+ * @param target VDP memory written.
+ * @param words Words written.
+ * @param tm Transfer method of the call (DMA_QUEUE and DMA_QUEUE_COPY count as queued bytes).
+ */
+void vdp_stats_add(u8* module_slot, const char* file, VdpStatsTarget target, u32 words, TransferMethod tm);
+
+/**
+ * @brief Closes the frame: moves every module's counters to `last`, `total`
+ *        and `peak`, records the DMA queue size, handles the overlay toggle
+ *        button and redraws the overlay. Call once per frame, after
+ *        input_update() and right before SYS_doVBlankProcess().
+ */
+void vdp_stats_end_frame();
+
+/** @brief Number of source files that have made at least one VDP call. */
+u16 vdp_stats_get_module_count();
+
+/** @brief Counters of one source file, 0 to vdp_stats_get_module_count() - 1. */
+const VdpStatsModule* vdp_stats_get_module(u16 index);
+
+/** @brief Frames completed since vdp_stats_init(), for averaging `total`. */
+u32 vdp_stats_get_frame_count();
+
+/** @brief Bytes in SGDK's DMA queue at the end of the last frame, from every source. */
+u16 vdp_stats_get_last_queue_bytes();
+
+/** @brief Writes every module's totals and worst frame to `KLog()` as `VDPS` lines. */
+void vdp_stats_dump_klog();
+
+#define VDP_STATS_INIT()      vdp_stats_init()
+#define VDP_STATS_END_FRAME() vdp_stats_end_frame()
+#define VDP_STATS_DUMP()      vdp_stats_dump_klog()
+
+// --- Interposed SGDK calls ---
+// Each file gets its own slot variable (these definitions are static), and the
+// wrappers are defined before the #defines below, so they call the real functions.
+
+static u8 vdp_stats_module_slot __attribute__((unused)) = VDP_STATS_UNREGISTERED;
+
+#define _VDP_STATS_ADD(target, words, tm) \
+    vdp_stats_add(&vdp_stats_module_slot, __BASE_FILE__, (target), (words), (tm))
+
+static inline u16 vdp_stats_VDP_loadTileSet(const TileSet* tileset, u16 index, TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)tileset->numTile * 16, tm);
+    return VDP_loadTileSet(tileset, index, tm);
+}
+
+static inline void vdp_stats_VDP_loadTileData(const u32* data, u16 index, u16 num, TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)num * 16, tm);
+    VDP_loadTileData(data, index, num, tm);
+}
+
+static inline void vdp_stats_VDP_fillTileData(u8 value, u16 index, u16 num, u16 wait) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)num * 16, CPU);
+    VDP_fillTileData(value, index, num, wait);
+}
+
+static inline void vdp_stats_VDP_clearPlane(VDPPlane plane, u16 wait) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)VDP_getPlaneWidth() * VDP_getPlaneHeight(), CPU);
+    VDP_clearPlane(plane, wait);
+}
+
+static inline void vdp_stats_VDP_setTileMapXY(VDPPlane plane, u16 tile, u16 x, u16 y) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, 1, CPU);
+    VDP_setTileMapXY(plane, tile, x, y);
+}
+
+static inline void vdp_stats_VDP_fillTileMapRect(VDPPlane plane, u16 tile, u16 x, u16 y, u16 w, u16 h) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)w * h, CPU);
+    VDP_fillTileMapRect(plane, tile, x, y, w, h);
+}
+
+static inline void vdp_stats_VDP_setTileMapData(u16 plane_addr, const u16* data, u16 index, u16 num,
+                                                TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, num, tm);
+    VDP_setTileMapData(plane_addr, data, index, num, tm);
+}
+
+static inline void vdp_stats_VDP_setTileMapDataRect(VDPPlane plane, const u16* data, u16 x, u16 y, u16 w, u16 h,
+                                                    u16 wm, TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)w * h, tm);
+    VDP_setTileMapDataRect(plane, data, x, y, w, h, wm, tm);
+}
+
+static inline void vdp_stats_VDP_setTileMapDataRectEx(VDPPlane plane, const u16* data, u16 basetile, u16 x, u16 y,
+                                                      u16 w, u16 h, u16 wm, TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)w * h, tm);
+    VDP_setTileMapDataRectEx(plane, data, basetile, x, y, w, h, wm, tm);
+}
+
+static inline u16 vdp_stats_VDP_setTileMapEx(VDPPlane plane, const TileMap* tilemap, u16 basetile, u16 x, u16 y,
+                                             u16 xm, u16 ym, u16 w, u16 h, TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, (u32)w * h, tm);
+    return VDP_setTileMapEx(plane, tilemap, basetile, x, y, xm, ym, w, h, tm);
+}
+
+static inline void vdp_stats_VDP_setHorizontalScroll(VDPPlane plane, s16 value) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, 1, CPU); // The H scroll table lives in VRAM
+    VDP_setHorizontalScroll(plane, value);
+}
+
+static inline void vdp_stats_VDP_setVerticalScroll(VDPPlane plane, s16 value) {
+    _VDP_STATS_ADD(VDP_STATS_VSRAM, 1, CPU);
+    VDP_setVerticalScroll(plane, value);
+}
+
+static inline void vdp_stats_VDP_drawText(const char* str, u16 x, u16 y) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, strlen(str), CPU);
+    VDP_drawText(str, x, y);
+}
+
+static inline void vdp_stats_VDP_drawTextBG(VDPPlane plane, const char* str, u16 x, u16 y) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, strlen(str), CPU);
+    VDP_drawTextBG(plane, str, x, y);
+}
+
+static inline void vdp_stats_VDP_drawTextEx(VDPPlane plane, const char* str, u16 basetile, u16 x, u16 y,
+                                            TransferMethod tm) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, strlen(str), tm);
+    VDP_drawTextEx(plane, str, basetile, x, y, tm);
+}
+
+static inline void vdp_stats_VDP_clearText(u16 x, u16 y, u16 w) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, w, CPU);
+    VDP_clearText(x, y, w);
+}
+
+static inline void vdp_stats_VDP_clearTextBG(VDPPlane plane, u16 x, u16 y, u16 w) {
+    _VDP_STATS_ADD(VDP_STATS_VRAM, w, CPU);
+    VDP_clearTextBG(plane, x, y, w);
+}
+
+static inline void vdp_stats_VDP_setPalette(u16 num, const u16* pal) {
+    _VDP_STATS_ADD(VDP_STATS_CRAM, 16, CPU);
+    VDP_setPalette(num, pal);
+}
+
+static inline void vdp_stats_VDP_setPaletteColor(u16 index, u16 value) {
+    _VDP_STATS_ADD(VDP_STATS_CRAM, 1, CPU);
+    VDP_setPaletteColor(index, value);
+}
+
+static inline void vdp_stats_VDP_setPaletteColors(u16 index, const u16* values, u16 count) {
+    _VDP_STATS_ADD(VDP_STATS_CRAM, count, CPU);
+    VDP_setPaletteColors(index, values, count);
+}
+
+// Blocking fades rewrite all 64 colors once per frame of the fade.
+static inline void vdp_stats_VDP_fadeOutAll(u16 numframe, u8 async) {
+    _VDP_STATS_ADD(VDP_STATS_CRAM, async ? 0 : (u32)numframe * 64, CPU);
+    VDP_fadeOutAll(numframe, async);
+}
+
+static inline void vdp_stats_VDP_fadeInAll(const u16* pal, u16 numframe, u8 async) {
+    _VDP_STATS_ADD(VDP_STATS_CRAM, async ? 0 : (u32)numframe * 64, CPU);
+    VDP_fadeInAll(pal, numframe, async);
+}
+
+#define VDP_loadTileSet             vdp_stats_VDP_loadTileSet
+#define VDP_loadTileData            vdp_stats_VDP_loadTileData
+#define VDP_fillTileData            vdp_stats_VDP_fillTileData
+#define VDP_clearPlane              vdp_stats_VDP_clearPlane
+#define VDP_setTileMapXY            vdp_stats_VDP_setTileMapXY
+#define VDP_fillTileMapRect         vdp_stats_VDP_fillTileMapRect
+#define VDP_setTileMapData          vdp_stats_VDP_setTileMapData
+#define VDP_setTileMapDataRect      vdp_stats_VDP_setTileMapDataRect
+#define VDP_setTileMapDataRectEx    vdp_stats_VDP_setTileMapDataRectEx
+#define VDP_setTileMapEx            vdp_stats_VDP_setTileMapEx
+#define VDP_setHorizontalScroll     vdp_stats_VDP_setHorizontalScroll
+#define VDP_setVerticalScroll       vdp_stats_VDP_setVerticalScroll
+#define VDP_drawText                vdp_stats_VDP_drawText
+#define VDP_drawTextBG              vdp_stats_VDP_drawTextBG
+#define VDP_drawTextEx              vdp_stats_VDP_drawTextEx
+#define VDP_clearText               vdp_stats_VDP_clearText
+#define VDP_clearTextBG             vdp_stats_VDP_clearTextBG
+#define VDP_setPalette              vdp_stats_VDP_setPalette
+#define VDP_setPaletteColor         vdp_stats_VDP_setPaletteColor
+#define VDP_setPaletteColors        vdp_stats_VDP_setPaletteColors
+#define VDP_fadeOutAll              vdp_stats_VDP_fadeOutAll
+#define VDP_fadeInAll               vdp_stats_VDP_fadeInAll
+
+#else
+
+#define VDP_STATS_INIT()      ((void)0)
+#define VDP_STATS_END_FRAME() ((void)0)
+#define VDP_STATS_DUMP()      ((void)0)
+
+#endif // VDP_STATS_ENABLED
+
+#endif // VDP_STATS_H
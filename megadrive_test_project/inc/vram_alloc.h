@@ -0,0 +1,105 @@
+/**
+ * @file vram_alloc.h
+ * @brief Ref-counted VRAM tile allocator that keeps tile sets resident between states.
+ *
+ * Hands out tile ranges between `VRAM_ALLOC_FIRST_INDEX` and
+ * `VRAM_ALLOC_END_INDEX`, one range per key. The key is the `TileSet` for
+ * resources, or any address that identifies tiles built at run time.
+ *
+ * Releasing a range only drops its reference: the tiles stay in VRAM, and the
+ * next acquire of the same key gets the same range back without uploading
+ * anything. Re-entering a test therefore skips its tile upload as long as
+ * nothing else needed the space in between.
+ *
+ * When no free block is large enough, unreferenced ranges are evicted, least
+ * recently used first, until one is. Referenced ranges are never moved or
+ * evicted; if they leave no room the request fails.
+ *
+ * Everything that writes tiles below `VRAM_ALLOC_END_INDEX` must get its range
+ * here, otherwise it may overwrite a resident tile set. The sprite engine
+ * keeps its own VRAM above that limit, and the font sits at `TILE_FONT_INDEX`.
+ *
+ * The "Debug: Frame Stats" screen has a page with the stats below and the
+ * resident ranges; its A button writes them to `KLog()` as `VRAM` lines.
+ */
+#ifndef VRAM_ALLOC_H
+#define VRAM_ALLOC_H
+
+#include <genesis.h> // SGDK general header
+
+/** @brief Tiles `SPR_init()` reserves for the sprite engine, right below the font. */
+#define VRAM_ALLOC_SPRITE_TILES 420
+/** @brief First tile index the allocator hands out. */
+#define VRAM_ALLOC_FIRST_INDEX TILE_USER_INDEX
+/** @brief One past the last tile index the allocator hands out. */
+#define VRAM_ALLOC_END_INDEX (TILE_FONT_INDEX - VRAM_ALLOC_SPRITE_TILES)
+/** @brief Ranges that can be allocated or resident at once. */
+#define VRAM_ALLOC_MAX_ENTRIES 16
+/** @brief Returned instead of a tile index when a request cannot be met. */
+#define VRAM_ALLOC_FAILED 0xFFFF
+
+/** @brief One allocated range. */
+typedef struct {
+    const void* key;  ///< TileSet or other address the range belongs to.
+    u16 index;        ///< First tile index.
+    u16 num;          ///< Number of tiles.
+    u16 refs;         ///< Holders; 0 means resident but evictable.
+    u32 last_use;     ///< Value of an internal counter at the last acquire or release (for LRU).
+} VramAllocEntry;
+
+/** @brief Occupancy, fragmentation and cache figures for profiling. */
+typedef struct {
+    u16 total_tiles;      ///< Tiles the allocator manages.
+    u16 used_tiles;       ///< Tiles in allocated ranges, referenced or not.
+    u16 referenced_tiles; ///< Tiles in ranges that are currently held.
+    u16 free_tiles;       ///< Tiles in no range.
+    u16 largest_free;     ///< Largest block of free tiles.
+    u16 free_blocks;      ///< Number of free blocks.
+    u16 fragmentation;    ///< Percent of the free tiles outside the largest free block.
+    u16 entries;          ///< Ranges allocated (referenced or resident).
+    u32 hits;             ///< Acquires served by a resident range (no upload).
+    u32 misses;           ///< Acquires that had to allocate (and upload).
+    u32 evictions;        ///< Unreferenced ranges dropped to make room.
+    u32 tiles_uploaded;   ///< Tiles uploaded by vram_alloc_acquire_tileset().
+    u32 tiles_skipped;    ///< Tile uploads avoided by hits.
+    u16 failures;         ///< Acquires that failed for lack of VRAM or entries.
+} VramAllocStats;
+
+/** @brief Forgets every range and clears the stats. Call once at startup. */
+void vram_alloc_init();
+
+/**
+ * @brief Acquires a range of tiles for a key and takes a reference to it.
+ * @param key Address identifying the tiles (not NULL).
+ * @param num Number of tiles; must match the resident range if the key has one.
+ * @param resident Set to TRUE if the range was already resident and still holds
+ *        the key's tiles, FALSE if the caller has to write them. May be NULL.
+ * @return First tile index, or VRAM_ALLOC_FAILED.
+ */
+u16 vram_alloc_acquire(const void* key, u16 num, u8* resident);
+
+/**
+ * @brief Acquires a tile set's range, uploading the tiles through the DMA scheduler
+ *        unless they are still resident. Call `dma_scheduler_drain()` before drawing
+ *        a tilemap that uses them.
+ * @param tileset Tile set resource (also the key).
+ * @return First tile index, or VRAM_ALLOC_FAILED.
+ */
+u16 vram_alloc_acquire_tileset(const TileSet* tileset);
+
+/** @brief Drops one reference to the key's range. The tiles stay resident until evicted. */
+void vram_alloc_release(const void* key);
+
+/** @brief Number of allocated ranges, see vram_alloc_get_entry(). */
+u16 vram_alloc_get_entry_count();
+
+/** @brief Allocated range `i` (sorted by tile index), or NULL if out of range. */
+const VramAllocEntry* vram_alloc_get_entry(u16 i);
+
+/** @brief Occupancy, fragmentation and cache figures (computed on each call). */
+const VramAllocStats* vram_alloc_get_stats();
+
+/** @brief Writes the stats to `KLog()` as one `VRAM` line, then one `VRAM_RANGE` line per range. */
+void vram_alloc_dump_klog();
+
+#endif // VRAM_ALLOC_H
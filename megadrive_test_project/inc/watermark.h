@@ -0,0 +1,95 @@
+/**
+ * @file watermark.h
+ * @brief Runtime memory high-water marks: stack depth, free heap and VRAM tiles.
+ *
+ * Complements the static figures from `make budget` (tools/budget_report.py)
+ * with what the ROM actually uses while it runs:
+ *
+ * - Stack: `watermark_init()` paints `WATERMARK_STACK_BYTES` of the unused stack
+ *   below `main()` with a fixed pattern. The deepest byte that no longer holds
+ *   the pattern is the deepest the stack has reached since.
+ * - Heap: the lowest `MEM_getFree()` seen at the end of any frame.
+ * - VRAM: the highest tile index each `GameState` has uploaded to, reported by
+ *   `WATERMARK_TILES()` next to every tile upload. Tiles uploaded in the
+ *   iteration that switches state count for the state being entered, like the
+ *   lag monitor's entry costs. Tiles the sprite engine allocates on its own are
+ *   not included.
+ *
+ * The figures are shown on the "Debug: Frame Stats" screen and written to
+ * `KLog()` as `WM` lines when A is pressed there.
+ *
+ * Controlled by `WATERMARK_ENABLED` (see `debug_config.h`); when it is 0 the
+ * macros below expand to nothing.
+ */
+#ifndef WATERMARK_H
+#define WATERMARK_H
+
+#include <genesis.h> // SGDK general header
+#include "debug_config.h"
+
+/** @brief Maximum number of states tracked (must cover every GameState). */
+#define WATERMARK_MAX_STATES 24
+/**
+ * @brief Bytes of stack painted below main()'s frame. Keep this within the
+ * stack space SGDK reserves above the heap, or painting would hit heap blocks.
+ */
+#ifndef WATERMARK_STACK_BYTES
+#define WATERMARK_STACK_BYTES 0x600
+#endif
+
+#if WATERMARK_ENABLED
+
+/**
+ * @brief Paints the stack and resets all marks. Call once from main(), early.
+ * @param state_names Display name per state, indexed by state value (only the pointers are stored).
+ * @param count Number of states.
+ */
+void watermark_init(const char* const* state_names, u16 count);
+
+/**
+ * @brief Records that tiles [first_index, first_index + count) were uploaded this frame.
+ * @param first_index First VRAM tile index written.
+ * @param count Number of tiles written.
+ */
+void watermark_note_tiles(u16 first_index, u16 count);
+
+/**
+ * @brief Samples the free heap and charges this frame's tile uploads to a state.
+ *        Call once per main loop iteration (or per frame of a state's own loop).
+ * @param state State that owns this frame's uploads.
+ */
+void watermark_end_frame(u16 state);
+
+/** @brief Deepest stack use below main() in bytes. Equal to the painted size if it may have gone deeper. */
+u16 watermark_get_stack_used();
+
+/** @brief Lowest MEM_getFree() seen so far. */
+u16 watermark_get_min_free();
+
+/** @brief Number of states passed to watermark_init(). */
+u16 watermark_get_state_count();
+
+/** @brief Display name of a state, as passed to watermark_init(). */
+const char* watermark_get_state_name(u16 state);
+
+/** @brief Highest tile index a state uploaded to, or 0 if it uploaded none. */
+u16 watermark_get_state_max_tile(u16 state);
+
+/** @brief Writes every mark to `KLog()` as `WM` lines. */
+void watermark_dump_klog();
+
+#define WATERMARK_INIT(names, count)   watermark_init((names), (count))
+#define WATERMARK_TILES(first, count)  watermark_note_tiles((first), (count))
+#define WATERMARK_END_FRAME(state)     watermark_end_frame(state)
+#define WATERMARK_DUMP()               watermark_dump_klog()
+
+#else
+
+#define WATERMARK_INIT(names, count)   ((void)(count))
+#define WATERMARK_TILES(first, count)  ((void)0)
+#define WATERMARK_END_FRAME(state)     ((void)(state))
+#define WATERMARK_DUMP()               ((void)0)
+
+#endif // WATERMARK_ENABLED
+
+#endif // WATERMARK_H
@@ -0,0 +1,25 @@
+# Map Definition File
+# Compiled by tools/map_compiler.py (not rescomp) into inc/maps.h and src/maps.c;
+# see inc/map_asset.h for loading. One line per map:
+#
+# MAP name "file" PALETTE PRIORITY BASE COMPRESSION
+# METATILE name "file" PALETTE PRIORITY BASE BLOCK
+#
+# 'name': The C variable name of the generated MapAsset. NAME_WIDTH and
+#         NAME_HEIGHT are defined next to it.
+# "file": Map source, relative to this file. A .csv holds one row of tile
+#         numbers per line; a .tmx is a Tiled map whose first layer uses CSV
+#         encoding (its flip flags are kept).
+# PALETTE: PAL0 to PAL3, baked into every tilemap entry.
+# PRIORITY: TRUE or FALSE, baked into every tilemap entry.
+# BASE: Tile index added to every tile number. The tilesets below are placed by
+#       the VRAM allocator, so the maps are compiled for 0 and moved to the
+#       allocated index while they are unpacked or decoded.
+# COMPRESSION: NONE, or WLZ (word LZ, unpacked by map_asset.c).
+# BLOCK: 16 or 32. A METATILE map is stored as a dictionary of unique blocks of
+#        that many pixels square and one u8 block index per block, and is decoded
+#        a row or column at a time (see inc/metatile.h). At most 256 unique blocks.
+
+# Tile numbers index my_tileset: 0 empty, 1 white, 2 smiley, 3 diagonal cross.
+MAP simple_map "maps/simple_map.csv" PAL0 FALSE 0 WLZ
+METATILE scrolling_map "maps/scrolling_map.csv" PAL0 FALSE 0 16
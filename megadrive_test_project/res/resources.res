@@ -31,7 +31,8 @@ TILESET my_tileset "gfx/tileset.png" BEST ALL_PALETTE
 #      e.g., sprite_player.png is 32x16. With 2x2 tiles, it's 16px wide for one frame.
 #      32px width / 16px per frame = 2 animation frames.
 # NONE: Compression for sprite data. Sprites often use NONE for faster VRAM transfer,
-#       but compression (e.g., LZ4W) is possible.
+#       but compression (e.g., LZ4W) is possible. Sprites streamed through
+#       sprite_stream.c must use NONE: their frames are DMA'd straight from ROM.
 # 0: Time per frame in game ticks (1/60th or 1/50th of a second).
 #    A value of 0 means the animation speed is not set by rescomp and should be
 #    handled manually in code (e.g., using SPR_setAnimAndFrame() or custom timers).
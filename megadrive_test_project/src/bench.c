@@ -0,0 +1,210 @@
+/**
+ * @file bench.c
+ * @brief Implements the headless benchmark driver.
+ *
+ * The driver is a small state machine advanced once per frame by
+ * `bench_frame_end()`. It never calls into the tests directly; everything goes
+ * through the same menu and controller path a player would use.
+ */
+#include "bench.h"
+
+#if BENCH_ENABLED
+
+#include "input.h"
+#include "hv_timer.h"
+#include "dma_scheduler.h" // For the bytes the scheduler deferred
+#include <string.h> // For sprintf
+
+/** @brief One benchmarked menu entry. */
+typedef struct {
+    const char* name;
+    u16 menu_index;              // Position in menu.c's menu_items[]
+    u16 frames;                  // Frames to run once the test is entered
+    const InputRun* script;      // Looping input recording (never contains Start)
+    u16 script_length;
+} BenchTest;
+
+typedef enum {
+    BENCH_PHASE_SETTLE,      // Idle in the menu
+    BENCH_PHASE_NAVIGATE,    // Press Down until the entry is selected, then Start
+    BENCH_PHASE_WAIT_ENTER,  // Wait for the test state to start
+    BENCH_PHASE_RUN,         // Replay the script and collect metrics
+    BENCH_PHASE_EXIT,        // Press Start until back in the menu
+    BENCH_PHASE_DONE
+} BenchPhase;
+
+// Scripts are input recordings, so a capture exported with input_record_export_klog()
+// can replace any of them as long as it does not press Start.
+static const InputRun script_idle[] = { {0, 1} };
+static const InputRun script_sprite_demo[] = {
+    {BUTTON_RIGHT, 60}, {BUTTON_DOWN, 40}, {BUTTON_LEFT, 60}, {BUTTON_UP, 40}, {BUTTON_A, 1}, {0, 9}
+};
+static const InputRun script_scrolling[] = {
+    {BUTTON_RIGHT, 120}, {BUTTON_DOWN, 60}, {BUTTON_LEFT, 120}, {BUTTON_UP, 60}
+};
+static const InputRun script_water[] = { {BUTTON_UP, 60}, {BUTTON_DOWN, 120}, {BUTTON_UP, 60} };
+static const InputRun script_music[] = { {BUTTON_A, 1}, {0, BENCH_FRAMES_PER_TEST} };
+
+#define BENCH_SCRIPT(script) script, (sizeof(script) / sizeof(script[0]))
+
+static const BenchTest bench_tests[] = {
+    { "sprite_demo",   0, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_sprite_demo) },
+    { "tilemap",       1, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "fades",         2, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "scrolling",     4, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_scrolling) },
+    { "music",         5, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_music) },
+    { "palette_cycle", 6, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "dialogue",      7, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    // The sprite ramp adds one sprite every 8 frames, so give it time to reach 80.
+    { "stress_sprites", 9, 900, BENCH_SCRIPT(script_idle) },
+    { "stress_dma",    10, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "stress_text",   11, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "parallax",      12, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_scrolling) },
+    // Moving the water line rebuilds the raster table every frame.
+    { "raster_fx",     13, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_water) },
+    { "stress_entities", 14, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "sprite_flicker", 15, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "stress_ysort",  16, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) },
+    { "sprite_stream", 17, BENCH_FRAMES_PER_TEST, BENCH_SCRIPT(script_idle) }
+};
+#define BENCH_TEST_COUNT (sizeof(bench_tests) / sizeof(bench_tests[0]))
+
+static BenchPhase phase;
+static u16 test_index;
+static u16 phase_frame;       // Frames spent in the current phase
+static u16 next_buttons;      // Returned by the input provider on the next input_update()
+
+static u32 frame_start_lines;
+static u32 frame_start_vblank;
+
+// Metrics of the running test
+static u32 total_lines;
+static u16 max_lines;
+static u32 lag_frames;
+static u32 total_dma_bytes;
+static u16 max_dma_bytes;
+static u32 max_deferred_bytes;
+static u32 total_lag_all_tests;
+
+static u16 _bench_input_provider(void) {
+    return next_buttons;
+}
+
+static void _bench_set_phase(BenchPhase new_phase) {
+    phase = new_phase;
+    phase_frame = 0;
+}
+
+static void _bench_reset_metrics() {
+    total_lines = 0;
+    max_lines = 0;
+    lag_frames = 0;
+    total_dma_bytes = 0;
+    max_dma_bytes = 0;
+    max_deferred_bytes = 0;
+}
+
+static void _bench_report_test(const BenchTest* test) {
+    char line_buf[128];
+    sprintf(line_buf, "BENCH test=%s frames=%u avg_lines=%lu max_lines=%u lag=%lu dma_avg=%lu dma_max=%u "
+            "dma_deferred_max=%lu", test->name, test->frames, total_lines / test->frames, max_lines, lag_frames,
+            total_dma_bytes / test->frames, max_dma_bytes, max_deferred_bytes);
+    KLog(line_buf);
+}
+
+void bench_init() {
+    char line_buf[48];
+
+    test_index = 0;
+    next_buttons = 0;
+    total_lag_all_tests = 0;
+    _bench_reset_metrics();
+    _bench_set_phase(BENCH_PHASE_SETTLE);
+    input_set_provider(_bench_input_provider);
+
+    sprintf(line_buf, "BENCH_BEGIN tests=%u lines_per_frame=%u", (u16)BENCH_TEST_COUNT, hv_timer_lines_per_frame());
+    KLog(line_buf);
+}
+
+void bench_frame_begin() {
+    frame_start_vblank = vtimer;
+    frame_start_lines = hv_timer_now();
+}
+
+void bench_frame_end(u8 in_menu) {
+    const BenchTest* test = &bench_tests[test_index];
+    u16 buttons = 0;
+
+    phase_frame++;
+
+    switch (phase) {
+        case BENCH_PHASE_SETTLE:
+            if (phase_frame >= BENCH_SETTLE_FRAMES) _bench_set_phase(BENCH_PHASE_NAVIGATE);
+            break;
+
+        case BENCH_PHASE_NAVIGATE:
+            // menu_init() selects entry 0; press Down once per two frames (press, release),
+            // then Start. Edge detection in menu.c needs the release frame in between.
+            if (phase_frame <= test->menu_index * 2) {
+                buttons = (phase_frame % 2) ? BUTTON_DOWN : 0;
+            } else {
+                buttons = BUTTON_START;
+                _bench_set_phase(BENCH_PHASE_WAIT_ENTER);
+            }
+            break;
+
+        case BENCH_PHASE_WAIT_ENTER:
+            if (!in_menu) {
+                _bench_reset_metrics();
+                input_replay_start(test->script, test->script_length, TRUE);
+                _bench_set_phase(BENCH_PHASE_RUN);
+            }
+            break;
+
+        case BENCH_PHASE_RUN: {
+            u32 lines = hv_timer_now() - frame_start_lines;
+            u16 dma_bytes = DMA_getQueueTransferSize();
+
+            total_lines += lines;
+            if (lines > max_lines) max_lines = (lines > 0xFFFF) ? 0xFFFF : (u16)lines;
+            // Any VBlank that already passed means SYS_doVBlankProcess() is late: a dropped frame.
+            lag_frames += vtimer - frame_start_vblank;
+            total_dma_bytes += dma_bytes;
+            if (dma_bytes > max_dma_bytes) max_dma_bytes = dma_bytes;
+            if (dma_scheduler_get_stats()->pending_bytes > max_deferred_bytes) {
+                max_deferred_bytes = dma_scheduler_get_stats()->pending_bytes;
+            }
+
+            if (phase_frame >= test->frames) {
+                input_replay_stop(); // Back to the provider for the menu navigation
+                _bench_report_test(test);
+                total_lag_all_tests += lag_frames;
+                _bench_set_phase(BENCH_PHASE_EXIT);
+            }
+            break;
+        }
+
+        case BENCH_PHASE_EXIT:
+            if (in_menu) {
+                test_index++;
+                _bench_set_phase((test_index < BENCH_TEST_COUNT) ? BENCH_PHASE_SETTLE : BENCH_PHASE_DONE);
+                if (phase == BENCH_PHASE_DONE) {
+                    char line_buf[48];
+                    sprintf(line_buf, "BENCH_END total_lag=%lu", total_lag_all_tests);
+                    KLog(line_buf);
+                }
+            } else {
+                // Alternate press/release so a missed press is retried.
+                buttons = (phase_frame % 2) ? BUTTON_START : 0;
+            }
+            break;
+
+        case BENCH_PHASE_DONE:
+        default:
+            break;
+    }
+
+    next_buttons = buttons;
+}
+
+#endif // BENCH_ENABLED
@@ -0,0 +1,111 @@
+/**
+ * @file camera.c
+ * @brief Implements the dead-zone camera and hands its view to the entity pool.
+ */
+#include "camera.h"
+#include "entity_pool.h" // For culling entities against the view
+
+#define CAMERA_SCREEN_W 320
+#define CAMERA_SCREEN_H 224
+
+static s32 cam_x = 0;
+static s32 cam_y = 0;
+static s32 max_x = 0;                 // World size minus the screen
+static s32 max_y = 0;
+static s16 zone_left = 0, zone_top = 0;
+static s16 zone_right = CAMERA_SCREEN_W, zone_bottom = CAMERA_SCREEN_H;
+static s16 look_distance = 0;
+static s16 look_step = 0;
+static s16 look_x = 0;                // Current look-ahead, eased towards +-look_distance
+static s16 look_y = 0;
+static s16 margin = CAMERA_DEFAULT_MARGIN;
+
+static s32 _camera_clamp(s32 value, s32 max) {
+    if (value > max) value = max;
+    if (value < 0) value = 0;
+    return value;
+}
+
+// Moves `look` one step towards the side `velocity` points to.
+static s16 _camera_ease_look(s16 look, s16 velocity) {
+    if (velocity == 0) return look; // Standing still keeps the last direction
+    s16 goal = (velocity > 0) ? look_distance : -look_distance;
+    if (look < goal) return (goal - look > look_step) ? look + look_step : goal;
+    if (look > goal) return (look - goal > look_step) ? look - look_step : goal;
+    return look;
+}
+
+void camera_init(u32 world_w, u32 world_h) {
+    max_x = (world_w > CAMERA_SCREEN_W) ? (s32)(world_w - CAMERA_SCREEN_W) : 0;
+    max_y = (world_h > CAMERA_SCREEN_H) ? (s32)(world_h - CAMERA_SCREEN_H) : 0;
+    zone_left = 0;
+    zone_top = 0;
+    zone_right = CAMERA_SCREEN_W;
+    zone_bottom = CAMERA_SCREEN_H;
+    look_distance = 0;
+    look_step = 0;
+    look_x = 0;
+    look_y = 0;
+    margin = CAMERA_DEFAULT_MARGIN;
+    camera_set_position(0, 0);
+}
+
+void camera_set_dead_zone(s16 left, s16 top, s16 right, s16 bottom) {
+    zone_left = left;
+    zone_top = top;
+    zone_right = right;
+    zone_bottom = bottom;
+}
+
+void camera_set_look_ahead(s16 distance, s16 step) {
+    look_distance = distance;
+    look_step = step;
+}
+
+void camera_set_margin(s16 value) {
+    margin = value;
+    entity_pool_set_view(cam_x, cam_y, margin);
+}
+
+void camera_follow(s32 x, s32 y, s16 vx, s16 vy) {
+    look_x = _camera_ease_look(look_x, vx);
+    look_y = _camera_ease_look(look_y, vy);
+
+    // The zone shifts against the look-ahead: looking right keeps the target left of center.
+    s32 sx = x - cam_x + look_x;
+    s32 sy = y - cam_y + look_y;
+    s32 new_x = cam_x, new_y = cam_y;
+    if (sx < zone_left) new_x -= zone_left - sx;
+    else if (sx > zone_right) new_x += sx - zone_right;
+    if (sy < zone_top) new_y -= zone_top - sy;
+    else if (sy > zone_bottom) new_y += sy - zone_bottom;
+    camera_set_position(new_x, new_y);
+}
+
+void camera_set_position(s32 x, s32 y) {
+    cam_x = _camera_clamp(x, max_x);
+    cam_y = _camera_clamp(y, max_y);
+    entity_pool_set_view(cam_x, cam_y, margin);
+}
+
+s32 camera_get_x() {
+    return cam_x;
+}
+
+s32 camera_get_y() {
+    return cam_y;
+}
+
+s32 camera_to_screen_x(s32 world_x) {
+    return world_x - cam_x;
+}
+
+s32 camera_to_screen_y(s32 world_y) {
+    return world_y - cam_y;
+}
+
+u8 camera_is_visible(s32 x, s32 y, s16 w, s16 h) {
+    s32 sx = x - cam_x;
+    s32 sy = y - cam_y;
+    return sx + w > -margin && sx < CAMERA_SCREEN_W + margin && sy + h > -margin && sy < CAMERA_SCREEN_H + margin;
+}
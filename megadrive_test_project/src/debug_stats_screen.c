@@ -0,0 +1,321 @@
+#include "debug_stats_screen.h"
+#include "debug_config.h"
+#include "input.h"
+#include "lag_monitor.h"
+#include "hv_timer.h"
+#include "vdp_stats.h"
+#include "watermark.h"
+#include "dma_scheduler.h"
+#include "vram_alloc.h"
+#include "vdp_cache.h"
+#include "scroll_engine.h"
+#include "parallax.h"
+#include "raster_fx.h"
+#include "sprite_flicker.h"
+#include "sprite_sort.h"
+#include "sprite_stream.h"
+#include <genesis.h>
+#include <string.h> // For sprintf
+
+#define STATS_TITLE_Y 2
+#define STATS_TABLE_Y 5
+#define STATS_LAST_ROW 24 // Last row a page may use; 25 is the recording status, 27 the exit hint
+// Lag table rows that fit between its header and the scroll hint and total below it
+#define STATS_LAG_ROWS (STATS_LAST_ROW - 2 - STATS_TABLE_Y)
+#define STATS_REFRESH_INTERVAL 30 // Redraw the table every 30 frames (0.5s at 60Hz)
+#define STATS_RECORD_CAPACITY 512 // Input runs; a run only ends when the button mask changes
+
+typedef enum {
+    STATS_PAGE_LAG_BY_STATE,
+    STATS_PAGE_TRANSITIONS,
+    STATS_PAGE_VDP_TRAFFIC,
+    STATS_PAGE_MEMORY,
+    STATS_PAGE_DMA_SCHEDULER,
+    STATS_PAGE_VRAM_ALLOC,
+    STATS_PAGE_COUNT
+} StatsPage;
+
+static StatsPage current_page = STATS_PAGE_LAG_BY_STATE;
+static u16 refresh_timer = 0;
+static u16 lag_first_state = 0; // First state shown on the lag page, scrolled with Up/Down
+
+#if DEBUG_TOOLS_ENABLED
+
+// Input recording started and stopped from this screen with B. It keeps running
+// after leaving the screen, so the recording can cover the menu and any tests.
+static InputRun record_buffer[STATS_RECORD_CAPACITY];
+
+static void _debug_stats_draw_record_status() {
+    VDP_clearText(0, 25, 40);
+    if (input_get_mode() == INPUT_MODE_RECORD) {
+        VDP_drawText("B: stop input recording (REC)", 1, 25);
+    } else {
+        VDP_drawText("B: start input recording", 1, 25);
+    }
+}
+
+static void _debug_stats_toggle_recording() {
+    if (input_get_mode() == INPUT_MODE_RECORD) {
+        input_record_stop();
+        input_record_export_klog("recorded_input");
+    } else {
+        input_record_start(record_buffer, STATS_RECORD_CAPACITY);
+    }
+    _debug_stats_draw_record_status();
+}
+
+static void _debug_stats_draw_lag_page() {
+    char line_buf[41];
+    u16 y = STATS_TABLE_Y;
+
+#if LAG_MONITOR_ENABLED
+    u16 count = lag_monitor_get_state_count();
+    u16 end = lag_first_state + STATS_LAG_ROWS;
+    if (end > count) end = count;
+
+    VDP_drawText("STATE      FRAMES   LAG WRST ENTR ELAG", 1, y++);
+    for (u16 i = lag_first_state; i < end; i++) {
+        const LagStateStats* stats = lag_monitor_get_state_stats(i);
+        sprintf(line_buf, "%-8s %8lu %5lu %4u %4u %4lu", stats->name, stats->frames, stats->lag_frames,
+                stats->worst_lag, stats->entries, stats->entry_lag_frames);
+        VDP_drawText(line_buf, 1, y++);
+    }
+    if (count > STATS_LAG_ROWS) {
+        sprintf(line_buf, "Up/Down: states %u-%u of %u", lag_first_state + 1, end, count);
+        VDP_drawText(line_buf, 1, STATS_LAST_ROW - 1);
+    }
+    sprintf(line_buf, "Total lag frames: %lu", lag_monitor_get_total_lag());
+    VDP_drawText(line_buf, 1, STATS_LAST_ROW);
+#else
+    VDP_drawText("Lag monitor disabled.", 1, y);
+#endif
+}
+
+static void _debug_stats_draw_transitions_page() {
+    char line_buf[41];
+    u16 y = STATS_TABLE_Y;
+
+#if LAG_MONITOR_ENABLED
+    u16 lines_per_frame = hv_timer_lines_per_frame();
+    VDP_drawText("TRANSITION  CNT LAST(ln) MAX(ln) FRM", 1, y++);
+    for (u16 i = 0; i < LAG_MONITOR_MAX_TRANSITIONS; i++) {
+        const LagTransitionStats* stats = lag_monitor_get_transition_stats(i);
+        if (stats == NULL) continue;
+        // Last cost in frames with one decimal, e.g. "2.4".
+        u32 tenths = (stats->last_lines * 10) / lines_per_frame;
+        sprintf(line_buf, "%-10s %4u %8lu %7lu %lu.%lu", stats->name, stats->count, stats->last_lines,
+                stats->max_lines, tenths / 10, tenths % 10);
+        VDP_drawText(line_buf, 1, y++);
+    }
+#else
+    VDP_drawText("Lag monitor disabled.", 1, y);
+#endif
+}
+
+static void _debug_stats_draw_vdp_page() {
+    char line_buf[41];
+    u16 y = STATS_TABLE_Y;
+    const VdpCacheStats* cache_stats = vdp_cache_get_stats();
+    const ScrollEngineStats* engine_stats = scroll_engine_get_stats();
+    const ParallaxStats* parallax_stats = parallax_get_stats();
+    const RasterFxStats* raster_stats = raster_fx_get_stats();
+
+    // The scroll cache counts in every build; the per-module table needs VDP_STATS=1.
+    sprintf(line_buf, "Raster: %u fires, peak %u cycles", raster_stats->fires, raster_stats->peak_cycles);
+    VDP_drawText(line_buf, 1, 21);
+    sprintf(line_buf, "Parallax: up %lu peak %u lines", parallax_stats->uploads, parallax_stats->peak_lines);
+    VDP_drawText(line_buf, 1, 22);
+    sprintf(line_buf, "Scroll: set %lu drop %lu write %lu", cache_stats->requested, cache_stats->dropped,
+            cache_stats->committed);
+    VDP_drawText(line_buf, 1, 23);
+    sprintf(line_buf, "Edges col/row %lu/%lu ld %lu ov %u", engine_stats->columns, engine_stats->rows,
+            engine_stats->reloads, engine_stats->overruns);
+    VDP_drawText(line_buf, 1, 24);
+
+#if VDP_STATS_ENABLED
+    // Averages per frame since startup, then the module's worst frame in words.
+    u32 frames = vdp_stats_get_frame_count() ? vdp_stats_get_frame_count() : 1;
+    VDP_drawText("MODULE   CALL  VRAM CRAM VSRM DMAQ PEAK", 1, y++);
+    for (u16 i = 0; i < vdp_stats_get_module_count() && y < 19; i++) {
+        const VdpStatsModule* module = vdp_stats_get_module(i);
+        u32 peak = module->peak.vram_words + module->peak.cram_words + module->peak.vsram_words;
+        sprintf(line_buf, "%-8s %4lu %5lu %4lu %4lu %4lu %4lu", module->name, module->total.calls / frames,
+                module->total.vram_words / frames, module->total.cram_words / frames,
+                module->total.vsram_words / frames, module->total.dma_bytes / frames, peak);
+        VDP_drawText(line_buf, 1, y++);
+    }
+    sprintf(line_buf, "DMA queue last frame: %u bytes", vdp_stats_get_last_queue_bytes());
+    VDP_drawText(line_buf, 1, y + 1);
+#else
+    VDP_drawText("Build with make VDP_STATS=1.", 1, y);
+#endif
+}
+
+static void _debug_stats_draw_memory_page() {
+    u16 y = STATS_TABLE_Y;
+
+#if WATERMARK_ENABLED
+    char line_buf[41];
+    sprintf(line_buf, "Stack used:    %5u bytes", watermark_get_stack_used());
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Heap free min: %5u (now %u)", watermark_get_min_free(), MEM_getFree());
+    VDP_drawText(line_buf, 1, y++);
+    y++;
+    sprintf(line_buf, "STATE    MAX TILE (limit %u)", TILE_FONT_INDEX - 1);
+    VDP_drawText(line_buf, 1, y++);
+    for (u16 i = 0; i < watermark_get_state_count() && y < 23; i++) {
+        u16 max_tile = watermark_get_state_max_tile(i);
+        if (max_tile == 0) continue;
+        sprintf(line_buf, "%-8s %5u", watermark_get_state_name(i), max_tile);
+        VDP_drawText(line_buf, 1, y++);
+    }
+#else
+    VDP_drawText("Watermarks disabled.", 1, y);
+#endif
+}
+
+static void _debug_stats_draw_dma_page() {
+    char line_buf[41];
+    u16 y = STATS_TABLE_Y;
+    const DmaSchedulerStats* stats = dma_scheduler_get_stats();
+
+    sprintf(line_buf, "Budget per frame: %5u bytes", stats->budget);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Last flush:       %5lu bytes", stats->last_flushed_bytes);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Queued now:  %3u (peak %u)", stats->queued, stats->peak_queued);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Pending now: %5lu (peak %lu)", stats->pending_bytes, stats->peak_pending_bytes);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Frames with deferred bytes: %lu", stats->deferred_frames);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Total flushed: %lu bytes", stats->flushed_bytes);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Rejected (queue full): %u", stats->rejected);
+    VDP_drawText(line_buf, 1, y++);
+}
+
+static void _debug_stats_draw_vram_page() {
+    char line_buf[41];
+    u16 y = STATS_TABLE_Y;
+    const VramAllocStats* stats = vram_alloc_get_stats();
+
+    sprintf(line_buf, "Tiles used: %4u / %u (%u held)", stats->used_tiles, stats->total_tiles,
+            stats->referenced_tiles);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Free: %4u, largest block %u", stats->free_tiles, stats->largest_free);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Free blocks: %u, fragmented %u%%", stats->free_blocks, stats->fragmentation);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Hits %lu  misses %lu  evicted %lu", stats->hits, stats->misses, stats->evictions);
+    VDP_drawText(line_buf, 1, y++);
+    sprintf(line_buf, "Tiles uploaded %lu, skipped %lu", stats->tiles_uploaded, stats->tiles_skipped);
+    VDP_drawText(line_buf, 1, y++);
+    y++;
+    VDP_drawText("INDEX TILES REFS", 1, y++);
+    for (u16 i = 0; i < vram_alloc_get_entry_count() && y < 23; i++) {
+        const VramAllocEntry* entry = vram_alloc_get_entry(i);
+        sprintf(line_buf, "%5u %5u %4u", entry->index, entry->num, entry->refs);
+        VDP_drawText(line_buf, 1, y++);
+    }
+}
+
+static void _debug_stats_draw_page() {
+    char title_buf[41];
+
+    for (u16 y = STATS_TITLE_Y; y <= STATS_LAST_ROW; y++) VDP_clearText(0, y, 40);
+
+    sprintf(title_buf, "Frame Stats %u/%u  <- -> page, A: KLog", current_page + 1, STATS_PAGE_COUNT);
+    VDP_drawText(title_buf, 1, STATS_TITLE_Y);
+
+    switch (current_page) {
+        case STATS_PAGE_LAG_BY_STATE: _debug_stats_draw_lag_page(); break;
+        case STATS_PAGE_TRANSITIONS: _debug_stats_draw_transitions_page(); break;
+        case STATS_PAGE_VDP_TRAFFIC: _debug_stats_draw_vdp_page(); break;
+        case STATS_PAGE_MEMORY: _debug_stats_draw_memory_page(); break;
+        case STATS_PAGE_DMA_SCHEDULER: _debug_stats_draw_dma_page(); break;
+        case STATS_PAGE_VRAM_ALLOC: _debug_stats_draw_vram_page(); break;
+        default: break;
+    }
+}
+
+static void _debug_stats_dump_klog() {
+#if LAG_MONITOR_ENABLED
+    lag_monitor_dump_klog();
+#endif
+    VDP_STATS_DUMP();
+    WATERMARK_DUMP();
+    dma_scheduler_dump_klog();
+    vram_alloc_dump_klog();
+    vdp_cache_dump_klog();
+    scroll_engine_dump_klog();
+    parallax_dump_klog();
+    raster_fx_dump_klog();
+    sprite_flicker_dump_klog();
+    sprite_sort_dump_klog();
+    sprite_stream_dump_klog();
+}
+
+#endif // DEBUG_TOOLS_ENABLED
+
+void debug_stats_screen_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    VDP_setTextPalette(PAL0);
+
+    current_page = STATS_PAGE_LAG_BY_STATE;
+    refresh_timer = 0;
+    lag_first_state = 0;
+
+#if DEBUG_TOOLS_ENABLED
+    _debug_stats_dump_klog();
+    _debug_stats_draw_page();
+    _debug_stats_draw_record_status();
+#else
+    VDP_drawText("Debug tools are disabled", 2, 10);
+    VDP_drawText("in release builds.", 2, 11);
+#endif
+    VDP_drawText("Press Start to Exit", 2, 27);
+}
+
+void debug_stats_screen_update() {
+#if DEBUG_TOOLS_ENABLED
+    if (input_is_just_pressed(BUTTON_RIGHT)) {
+        current_page = (current_page + 1) % STATS_PAGE_COUNT;
+        refresh_timer = 0;
+    } else if (input_is_just_pressed(BUTTON_LEFT)) {
+        current_page = (current_page + STATS_PAGE_COUNT - 1) % STATS_PAGE_COUNT;
+        refresh_timer = 0;
+    }
+
+#if LAG_MONITOR_ENABLED
+    if (current_page == STATS_PAGE_LAG_BY_STATE) {
+        u16 count = lag_monitor_get_state_count();
+        if (input_is_just_pressed(BUTTON_DOWN) && lag_first_state + STATS_LAG_ROWS < count) {
+            lag_first_state++;
+            refresh_timer = 0;
+        } else if (input_is_just_pressed(BUTTON_UP) && lag_first_state > 0) {
+            lag_first_state--;
+            refresh_timer = 0;
+        }
+    }
+#endif
+
+    if (input_is_just_pressed(BUTTON_A)) {
+        _debug_stats_dump_klog();
+    }
+
+    if (input_is_just_pressed(BUTTON_B)) {
+        _debug_stats_toggle_recording();
+    }
+
+    // The totals keep changing while this screen runs, so redraw periodically.
+    if (refresh_timer == 0) _debug_stats_draw_page();
+    refresh_timer = (refresh_timer + 1) % STATS_REFRESH_INTERVAL;
+#endif
+    // Exit condition (Start button press) is handled in main.c's game loop
+}
+
+void debug_stats_screen_on_exit() {
+    // Nothing specific; main.c's return_to_menu() clears the planes.
+}
@@ -1,5 +1,6 @@
 #include "dialogue_engine.h"
 #include "input.h" 
+#include "tilemap_blit.h" // For drawing the box as row transfers
 #include <string.h> 
 
 static DialogueState current_dialogue;
@@ -28,37 +29,31 @@ void dialogue_engine_init() {
 
 void dialogue_engine_draw_box(VDPPlane plane, u16 x, u16 y, u16 width, u16 height, const char* title) {
     if (width < 2 || height < 2) return;
-    VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_TL, x, y);
-    VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_TR, x + width - 1, y);
-    VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_BL, x, y + height - 1);
-    VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_BR, x + width - 1, y + height - 1);
-    for (u16 i = 1; i < width - 1; ++i) {
-        VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_HLINE, x + i, y);
-        VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_HLINE, x + i, y + height - 1);
-    }
-    for (u16 i = 1; i < height - 1; ++i) {
-        VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_VLINE, x, y + i);
-        VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_VLINE, x + width - 1, y + i);
-    }
-    for (u16 iy = 1; iy < height - 1; ++iy) {
-        for (u16 ix = 1; ix < width - 1; ++ix) {
-            VDP_setTileMapXY(plane, BOX_ATTR | FONT_CHAR_SPACE, x + ix, y + iy);
-        }
-    }
+    if (!tilemap_blit_begin(width, height)) return;
+    tilemap_blit_fill(1, 1, width - 2, height - 2, BOX_ATTR | FONT_CHAR_SPACE);
+    tilemap_blit_fill(1, 0, width - 2, 1, BOX_ATTR | FONT_CHAR_HLINE);
+    tilemap_blit_fill(1, height - 1, width - 2, 1, BOX_ATTR | FONT_CHAR_HLINE);
+    tilemap_blit_fill(0, 1, 1, height - 2, BOX_ATTR | FONT_CHAR_VLINE);
+    tilemap_blit_fill(width - 1, 1, 1, height - 2, BOX_ATTR | FONT_CHAR_VLINE);
+    tilemap_blit_set(0, 0, BOX_ATTR | FONT_CHAR_TL);
+    tilemap_blit_set(width - 1, 0, BOX_ATTR | FONT_CHAR_TR);
+    tilemap_blit_set(0, height - 1, BOX_ATTR | FONT_CHAR_BL);
+    tilemap_blit_set(width - 1, height - 1, BOX_ATTR | FONT_CHAR_BR);
+    tilemap_blit_push(plane, x, y, CPU); // One transfer per box row
     if (title != NULL) {
         int title_len = strlen(title);
         int title_start_x = x + (width - title_len) / 2;
         if (title_start_x < x + 1) title_start_x = x + 1;
         // Ensure title does not overflow box width
         if (title_len > 0 && title_len <= (width - 2)) { 
-            VDP_drawTextEx(plane, title, title_start_x, y, BOX_ATTR, FALSE); 
+            VDP_drawTextEx(plane, title, BOX_ATTR | FONT_CHAR_SPACE, title_start_x, y, CPU); 
         } else if (title_len > (width - 2) && (width - 2 > 0)) { // Check if box is wide enough for any title
              // If title is too long, draw a truncated version (very basic truncation)
             char truncated_title[MAX_CHARS_PER_LINE]; 
             strncpy(truncated_title, title, width - 3); // width-2 for content, -1 for ellipsis if added
             truncated_title[width - 3] = '\0'; 
             // strcat(truncated_title, "."); // Example: Add ellipsis, ensure buffer is large enough
-            VDP_drawTextEx(plane, truncated_title, x + 1, y, BOX_ATTR, FALSE);
+            VDP_drawTextEx(plane, truncated_title, BOX_ATTR | FONT_CHAR_SPACE, x + 1, y, CPU);
         }
     }
 }
@@ -162,11 +157,16 @@ void dialogue_engine_draw_current_page(VDPPlane plane, u16 box_tile_x, u16 box_t
     dialogue_engine_draw_box(plane, box_tile_x, box_tile_y, box_width_tiles, box_height_tiles, title);
 
     for (u8 i = 0; i < current_dialogue.num_lines_on_current_page; ++i) {
-        VDP_drawTextEx(plane, current_dialogue.lines[i], box_tile_x + 1, box_tile_y + 1 + i, BOX_ATTR, FALSE);
+        dialogue_engine_draw_text_line_inside_box(plane, current_dialogue.lines[i], box_tile_x + 1, box_tile_y + 1 + i);
     }
     // Paging indicator drawing will be added later
 }
 
+void dialogue_engine_draw_text_line_inside_box(VDPPlane plane, const char* text, u16 x, u16 y) {
+    // The font starts at the space character, so FONT_CHAR_SPACE is the text base tile.
+    VDP_drawTextEx(plane, text, BOX_ATTR | FONT_CHAR_SPACE, x, y, CPU);
+}
+
 u8 dialogue_engine_update() {
     if (!current_dialogue.is_active) return FALSE;
 
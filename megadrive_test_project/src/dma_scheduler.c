@@ -0,0 +1,242 @@
+/**
+ * @file dma_scheduler.c
+ * @brief Implements the prioritized, budgeted DMA scheduler.
+ *
+ * Each priority has its own ring buffer of pending transfers. A flush walks
+ * the priorities from highest to lowest and hands transfers to SGDK's DMA
+ * queue until the frame's budget is used up. Tile data goes through
+ * `VDP_loadTileData(..., DMA_QUEUE)` so it is split on tile boundaries;
+ * everything else through `DMA_queueDma()`.
+ */
+#include "dma_scheduler.h"
+#include "error_handler.h" // For reporting invalid priorities
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_DMA_SCHEDULER "dma_scheduler"
+
+/** @brief One pending transfer (the remainder, once a bulk transfer has been split). */
+typedef struct {
+    const u8* from;
+    u16 to;        // Destination address in bytes
+    u16 len;       // Words left to transfer
+    u16 step;      // Destination increment in bytes (2: consecutive words)
+    u8 location;   // DMA_VRAM, DMA_CRAM or DMA_VSRAM
+    u8 tiles;      // TRUE: tile data (u32 rows); split only on whole tiles
+    u8 waited;     // TRUE: held back once for being larger than a frame's budget
+} DmaTransfer;
+
+typedef struct {
+    DmaTransfer entries[DMA_SCHEDULER_QUEUE_SIZE];
+    u16 head;      // Oldest entry
+    u16 count;
+} DmaQueue;
+
+static DmaQueue queues[DMA_PRIORITY_COUNT];
+static DmaSchedulerStats stats;
+
+static void _dma_scheduler_update_pending() {
+    u16 queued = 0;
+    u32 pending_bytes = 0;
+
+    for (u16 p = 0; p < DMA_PRIORITY_COUNT; p++) {
+        const DmaQueue* queue = &queues[p];
+        for (u16 i = 0; i < queue->count; i++) {
+            pending_bytes += (u32)queue->entries[(queue->head + i) % DMA_SCHEDULER_QUEUE_SIZE].len * 2;
+        }
+        queued += queue->count;
+    }
+    stats.queued = queued;
+    stats.pending_bytes = pending_bytes;
+    if (queued > stats.peak_queued) stats.peak_queued = queued;
+}
+
+static u8 _dma_scheduler_push(DmaPriority priority, u8 location, const void* from, u16 to, u16 len, u16 step,
+                              u8 tiles) {
+    if (priority >= DMA_PRIORITY_COUNT) {
+        error_handler_display_error(MODULE_NAME_DMA_SCHEDULER, __func__, __LINE__, "Invalid priority!");
+        return FALSE;
+    }
+    if (len == 0) return TRUE;
+
+    DmaQueue* queue = &queues[priority];
+    if (queue->count >= DMA_SCHEDULER_QUEUE_SIZE) {
+        stats.rejected++;
+        return FALSE;
+    }
+
+    DmaTransfer* transfer = &queue->entries[(queue->head + queue->count) % DMA_SCHEDULER_QUEUE_SIZE];
+    transfer->from = (const u8*)from;
+    transfer->to = to;
+    transfer->len = len;
+    transfer->step = step;
+    transfer->location = location;
+    transfer->tiles = tiles;
+    transfer->waited = FALSE;
+    queue->count++;
+
+    _dma_scheduler_update_pending();
+    return TRUE;
+}
+
+// Hands the first `words` words of a transfer to SGDK's DMA queue.
+static u8 _dma_scheduler_send(const DmaTransfer* transfer, u16 words) {
+    if (transfer->tiles) {
+        VDP_loadTileData((const u32*)transfer->from, transfer->to / TILE_SIZE, words / (TILE_SIZE / 2), DMA_QUEUE);
+        return TRUE;
+    }
+    return DMA_queueDma(transfer->location, (void*)transfer->from, transfer->to, words, transfer->step);
+}
+
+static void _dma_scheduler_pop(DmaQueue* queue) {
+    queue->head = (queue->head + 1) % DMA_SCHEDULER_QUEUE_SIZE;
+    queue->count--;
+}
+
+void dma_scheduler_init() {
+    memset(queues, 0, sizeof(queues));
+    memset(&stats, 0, sizeof(stats));
+    dma_scheduler_set_budget(0);
+}
+
+u8 dma_scheduler_queue(DmaPriority priority, u8 location, const void* from, u16 to, u16 len) {
+    return _dma_scheduler_push(priority, location, from, to, len, 2, FALSE);
+}
+
+u8 dma_scheduler_queue_step(DmaPriority priority, u8 location, const void* from, u16 to, u16 len, u16 step) {
+    if (priority == DMA_PRIORITY_BULK && step != 2) {
+        // Bulk transfers are split, and the remainder's address assumes consecutive words.
+        error_handler_display_error(MODULE_NAME_DMA_SCHEDULER, __func__, __LINE__, "Stepped bulk transfer!");
+        return FALSE;
+    }
+    return _dma_scheduler_push(priority, location, from, to, len, step, FALSE);
+}
+
+u8 dma_scheduler_queue_tiles(DmaPriority priority, const u32* tiles, u16 index, u16 num) {
+    return _dma_scheduler_push(priority, DMA_VRAM, tiles, index * TILE_SIZE, num * (TILE_SIZE / 2), 2, TRUE);
+}
+
+u8 dma_scheduler_load_tileset(const TileSet* tileset, u16 index) {
+    if (tileset->compression != COMPRESSION_NONE) {
+        // Unpacking needs a RAM buffer that would have to live until the transfer ends.
+        VDP_loadTileSet(tileset, index, DMA);
+        return TRUE;
+    }
+    return dma_scheduler_queue_tiles(DMA_PRIORITY_BULK, tileset->tiles, index, tileset->numTile);
+}
+
+u8 dma_scheduler_queue_colors(u16 index, const u16* colors, u16 count) {
+    return dma_scheduler_queue(DMA_PRIORITY_PALETTE, DMA_CRAM, colors, index * 2, count);
+}
+
+void dma_scheduler_flush() {
+    // The sprite engine and any direct DMA_QUEUE calls have already queued their bytes.
+    u16 queued_by_others = DMA_getQueueTransferSize();
+    s32 budget_left = (s32)stats.budget - queued_by_others;
+    u32 moved = 0;
+
+    for (u16 p = 0; p < DMA_PRIORITY_COUNT && budget_left > 0; p++) {
+        DmaQueue* queue = &queues[p];
+        while (queue->count != 0) {
+            DmaTransfer* transfer = &queue->entries[queue->head];
+            u32 bytes = (u32)transfer->len * 2;
+
+            if ((s32)bytes <= budget_left) {
+                if (!_dma_scheduler_send(transfer, transfer->len)) break;
+                budget_left -= bytes;
+                moved += bytes;
+                _dma_scheduler_pop(queue);
+            } else if (p == DMA_PRIORITY_BULK) {
+                // Send what fits and keep the rest for the next frame.
+                u16 words = budget_left / 2;
+                if (transfer->tiles) words &= ~(TILE_SIZE / 2 - 1);
+                if (words != 0 && _dma_scheduler_send(transfer, words)) {
+                    transfer->from += words * 2;
+                    transfer->to += words * 2;
+                    transfer->len -= words;
+                    moved += words * 2;
+                }
+                budget_left = 0;
+                break;
+            } else if (bytes > stats.budget && (transfer->waited || (moved == 0 && queued_by_others == 0))) {
+                // Larger than a whole frame's budget: move it whole rather than never. It goes
+                // with the others' bytes after one frame, or SPR_update() would hold it off forever.
+                if (!_dma_scheduler_send(transfer, transfer->len)) break;
+                budget_left = 0;
+                moved += bytes;
+                _dma_scheduler_pop(queue);
+            } else {
+                if (bytes > stats.budget) transfer->waited = TRUE;
+                break; // Keep this priority in order; lower priorities may still fit
+            }
+            if (budget_left <= 0) break;
+        }
+    }
+
+    stats.last_flushed_bytes = moved;
+    stats.flushed_bytes += moved;
+    _dma_scheduler_update_pending();
+    if (stats.pending_bytes != 0) stats.deferred_frames++;
+    if (stats.pending_bytes > stats.peak_pending_bytes) stats.peak_pending_bytes = stats.pending_bytes;
+}
+
+void dma_scheduler_drain() {
+    while (stats.queued != 0) {
+        dma_scheduler_flush();
+        SYS_doVBlankProcess();
+    }
+}
+
+void dma_scheduler_set_budget(u16 bytes) {
+    if (bytes == 0) bytes = IS_PALSYSTEM ? DMA_SCHEDULER_BUDGET_PAL : DMA_SCHEDULER_BUDGET_NTSC;
+    stats.budget = bytes;
+}
+
+u16 dma_scheduler_get_queued(DmaPriority priority) {
+    return (priority < DMA_PRIORITY_COUNT) ? queues[priority].count : 0;
+}
+
+// TRUE if the transfer's source starts within the `bytes` bytes at `from`.
+static u8 _dma_scheduler_reads(const DmaTransfer* transfer, const void* from, u32 bytes) {
+    const u8* start = (const u8*)from;
+    return transfer->from >= start && transfer->from < start + bytes;
+}
+
+u8 dma_scheduler_is_pending(DmaPriority priority, const void* from, u32 bytes) {
+    if (priority >= DMA_PRIORITY_COUNT) return FALSE;
+    const DmaQueue* queue = &queues[priority];
+    for (u16 i = 0; i < queue->count; i++) {
+        if (_dma_scheduler_reads(&queue->entries[(queue->head + i) % DMA_SCHEDULER_QUEUE_SIZE], from, bytes)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+u16 dma_scheduler_cancel(DmaPriority priority, const void* from, u32 bytes) {
+    if (priority >= DMA_PRIORITY_COUNT) return 0;
+    DmaQueue* queue = &queues[priority];
+    u16 kept = 0;
+    for (u16 i = 0; i < queue->count; i++) {
+        const DmaTransfer* transfer = &queue->entries[(queue->head + i) % DMA_SCHEDULER_QUEUE_SIZE];
+        if (_dma_scheduler_reads(transfer, from, bytes)) continue;
+        queue->entries[(queue->head + kept) % DMA_SCHEDULER_QUEUE_SIZE] = *transfer;
+        kept++;
+    }
+    u16 dropped = queue->count - kept;
+    queue->count = kept;
+    _dma_scheduler_update_pending();
+    return dropped;
+}
+
+const DmaSchedulerStats* dma_scheduler_get_stats() {
+    return &stats;
+}
+
+void dma_scheduler_dump_klog() {
+    char line_buf[128];
+    sprintf(line_buf, "DMAS budget=%u queued=%u peak_queued=%u pending=%lu peak_pending=%lu flushed=%lu "
+            "deferred_frames=%lu rejected=%u", stats.budget, stats.queued, stats.peak_queued, stats.pending_bytes,
+            stats.peak_pending_bytes, stats.flushed_bytes, stats.deferred_frames, stats.rejected);
+    KLog(line_buf);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file entity_pool.c
+ * @brief Implements the entity pool: packed parallel arrays, an id table and a free list.
+ *
+ * Slot s (0 <= s < live) holds a live entity in every array below; `slot_id[s]`
+ * names it and `id_slot[id]` finds it. Free ids are chained through
+ * `next_free[]`. The update loops only touch the slots in use.
+ */
+#include "entity_pool.h"
+#include "hv_timer.h"      // For timing the update
+#include "error_handler.h" // For reporting invalid ids
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_ENTITY_POOL "entity_pool"
+
+// Per slot, packed at the front.
+static s32 pos_x[ENTITY_POOL_MAX];        // 24.8 pixels
+static s32 pos_y[ENTITY_POOL_MAX];
+static s16 vel_x[ENTITY_POOL_MAX];        // 8.8 pixels per frame
+static s16 vel_y[ENTITY_POOL_MAX];
+static u16 anim_timer[ENTITY_POOL_MAX];   // Frames left on the current animation frame
+static u16 anim_speed[ENTITY_POOL_MAX];   // Frames per animation frame; 0: not animated
+static u16 anim_frame[ENTITY_POOL_MAX];
+static u16 anim_frames[ENTITY_POOL_MAX];  // Frames in the animation
+static Sprite* sprites[ENTITY_POOL_MAX];  // NULL for an entity without a sprite
+static u8 culled[ENTITY_POOL_MAX];        // Outside the view last update: sprite hidden
+static u16 slot_id[ENTITY_POOL_MAX];
+
+// Per id.
+static u16 id_slot[ENTITY_POOL_MAX];      // ENTITY_POOL_NONE while the id is free
+static u16 next_free[ENTITY_POOL_MAX];
+
+static u16 live = 0;
+static u16 free_head = ENTITY_POOL_NONE;
+static s32 min_x, min_y, max_x, max_y;   // 24.8, like the positions
+static s32 view_x = 0, view_y = 0;       // World position of the screen's top-left corner
+static s16 view_margin = 32;
+static EntityPoolStats stats;
+
+// Slot of a live id, or ENTITY_POOL_NONE (reported).
+static u16 _entity_pool_slot(u16 id, const char* func, u16 line) {
+    if (id >= ENTITY_POOL_MAX || id_slot[id] == ENTITY_POOL_NONE) {
+        error_handler_display_error(MODULE_NAME_ENTITY_POOL, func, line, "Invalid entity!");
+        return ENTITY_POOL_NONE;
+    }
+    return id_slot[id];
+}
+
+void entity_pool_init() {
+    live = 0;
+    for (u16 id = 0; id < ENTITY_POOL_MAX; id++) {
+        id_slot[id] = ENTITY_POOL_NONE;
+        next_free[id] = id + 1;
+    }
+    next_free[ENTITY_POOL_MAX - 1] = ENTITY_POOL_NONE;
+    free_head = 0;
+    memset(&stats, 0, sizeof(stats));
+    entity_pool_set_bounds(0, 0, 320 - 16, 224 - 16);
+    entity_pool_set_view(0, 0, 32);
+}
+
+void entity_pool_clear() {
+    while (live > 0) entity_pool_despawn(slot_id[live - 1]);
+}
+
+void entity_pool_set_bounds(s32 new_min_x, s32 new_min_y, s32 new_max_x, s32 new_max_y) {
+    min_x = (s32)new_min_x << 8;
+    min_y = (s32)new_min_y << 8;
+    max_x = (s32)new_max_x << 8;
+    max_y = (s32)new_max_y << 8;
+}
+
+void entity_pool_set_view(s32 x, s32 y, s16 margin) {
+    view_x = x;
+    view_y = y;
+    view_margin = margin;
+}
+
+u16 entity_pool_spawn(const SpriteDefinition* def, u16 attr, s32 x, s32 y, s16 vx, s16 vy) {
+    if (free_head == ENTITY_POOL_NONE) return ENTITY_POOL_NONE;
+    u16 id = free_head;
+    free_head = next_free[id];
+
+    u16 slot = live++;
+    id_slot[id] = slot;
+    slot_id[slot] = id;
+    pos_x[slot] = x << 8;
+    pos_y[slot] = y << 8;
+    vel_x[slot] = vx;
+    vel_y[slot] = vy;
+    anim_timer[slot] = 0;
+    anim_speed[slot] = ENTITY_POOL_DEFAULT_ANIM_SPEED;
+    anim_frame[slot] = 0;
+    anim_frames[slot] = 1;
+    sprites[slot] = NULL;
+    culled[slot] = FALSE; // Checked on the next update
+    if (def != NULL) {
+        // An entity spawned out of view is culled by the next update.
+        sprites[slot] = SPR_addSprite(def, (s16)(x - view_x), (s16)(y - view_y), attr);
+        if (sprites[slot] != NULL) SPR_setFrame(sprites[slot], 0);
+        anim_frames[slot] = def->animations[0]->numFrame;
+    }
+
+    stats.spawns++;
+    if (live > stats.peak_live) stats.peak_live = live;
+    return id;
+}
+
+void entity_pool_despawn(u16 id) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    if (slot == ENTITY_POOL_NONE) return;
+    if (sprites[slot] != NULL) SPR_releaseSprite(sprites[slot]);
+
+    // Fill the hole with the last live entity, so the slots stay packed.
+    u16 last = --live;
+    if (slot != last) {
+        pos_x[slot] = pos_x[last];
+        pos_y[slot] = pos_y[last];
+        vel_x[slot] = vel_x[last];
+        vel_y[slot] = vel_y[last];
+        anim_timer[slot] = anim_timer[last];
+        anim_speed[slot] = anim_speed[last];
+        anim_frame[slot] = anim_frame[last];
+        anim_frames[slot] = anim_frames[last];
+        sprites[slot] = sprites[last];
+        culled[slot] = culled[last];
+        slot_id[slot] = slot_id[last];
+        id_slot[slot_id[slot]] = slot;
+    }
+
+    id_slot[id] = ENTITY_POOL_NONE;
+    next_free[id] = free_head;
+    free_head = id;
+    stats.despawns++;
+}
+
+void entity_pool_set_velocity(u16 id, s16 vx, s16 vy) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    if (slot == ENTITY_POOL_NONE) return;
+    vel_x[slot] = vx;
+    vel_y[slot] = vy;
+}
+
+void entity_pool_set_anim_speed(u16 id, u16 frames) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    if (slot == ENTITY_POOL_NONE) return;
+    anim_speed[slot] = frames;
+    anim_timer[slot] = 0;
+}
+
+s32 entity_pool_get_x(u16 id) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    return (slot == ENTITY_POOL_NONE) ? 0 : pos_x[slot] >> 8;
+}
+
+s32 entity_pool_get_y(u16 id) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    return (slot == ENTITY_POOL_NONE) ? 0 : pos_y[slot] >> 8;
+}
+
+Sprite* entity_pool_get_sprite(u16 id) {
+    u16 slot = _entity_pool_slot(id, __func__, __LINE__);
+    return (slot == ENTITY_POOL_NONE) ? NULL : sprites[slot];
+}
+
+u16 entity_pool_count() {
+    return live;
+}
+
+// Moves one axis of every entity and bounces it off [lo, hi].
+static void _entity_pool_move_axis(s32* pos, s16* vel, s32 lo, s32 hi) {
+    for (u16 n = live; n; n--, pos++, vel++) {
+        s32 p = *pos + *vel;
+        if (p < lo) {
+            p = lo;
+            *vel = -*vel;
+        } else if (p > hi) {
+            p = hi;
+            *vel = -*vel;
+        }
+        *pos = p;
+    }
+}
+
+void entity_pool_update() {
+    u32 start = hv_timer_now();
+
+    _entity_pool_move_axis(pos_x, vel_x, min_x, max_x);
+    _entity_pool_move_axis(pos_y, vel_y, min_y, max_y);
+
+    // Culling and sprite positions. A 32x32 box is tested, which covers the
+    // sprites used here; the margin absorbs anything larger.
+    s16 left = -view_margin - 32;
+    s16 top = -view_margin - 32;
+    s16 right = 320 + view_margin;
+    s16 bottom = 224 + view_margin;
+    u16 num_culled = 0;
+    Sprite** sprite = sprites;
+    const s32* x = pos_x;
+    const s32* y = pos_y;
+    u8* cull = culled;
+    for (u16 n = live; n; n--, sprite++, x++, y++, cull++) {
+        s32 sx = (*x >> 8) - view_x;
+        s32 sy = (*y >> 8) - view_y;
+        if (sx < left || sx > right || sy < top || sy > bottom) {
+            num_culled++;
+            if (*cull) continue;
+            // Leaving: park the sprite on the edge of the culling box, off
+            // screen, and hide it.
+            *cull = TRUE;
+            if (*sprite != NULL) {
+                SPR_setPosition(*sprite, (sx < left) ? left : (sx > right) ? right : sx,
+                                (sy < top) ? top : (sy > bottom) ? bottom : sy);
+                SPR_setVisibility(*sprite, HIDDEN);
+            }
+            continue;
+        }
+        if (*sprite == NULL) {
+            *cull = FALSE;
+            continue;
+        }
+        if (*cull) {
+            *cull = FALSE;
+            SPR_setVisibility(*sprite, VISIBLE);
+        }
+        SPR_setPosition(*sprite, sx, sy);
+    }
+
+    // Animation: culled entities are frozen; only frame changes touch a sprite.
+    u16* timer = anim_timer;
+    const u16* speed = anim_speed;
+    cull = culled;
+    for (u16 slot = 0; slot < live; slot++, timer++, speed++, cull++) {
+        if (*cull || *speed == 0 || ++*timer < *speed) continue;
+        *timer = 0;
+        if (++anim_frame[slot] >= anim_frames[slot]) anim_frame[slot] = 0;
+        if (sprites[slot] != NULL) SPR_setFrame(sprites[slot], anim_frame[slot]);
+    }
+
+    stats.live = live;
+    stats.culled = num_culled;
+    stats.last_lines = hv_timer_now() - start;
+    if (stats.last_lines > stats.peak_lines) stats.peak_lines = stats.last_lines;
+}
+
+const EntityPoolStats* entity_pool_get_stats() {
+    stats.live = live;
+    return &stats;
+}
+
+void entity_pool_dump_klog() {
+    char line_buf[128];
+    sprintf(line_buf, "ENTITY live=%u peak_live=%u spawns=%lu despawns=%lu culled=%u last_lines=%u peak_lines=%u",
+            stats.live, stats.peak_live, stats.spawns, stats.despawns, stats.culled, stats.last_lines, stats.peak_lines);
+    KLog(line_buf);
+}
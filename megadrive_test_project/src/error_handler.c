@@ -1,7 +1,13 @@
 #include "error_handler.h"
+#include "palette_manager.h" // For the error screen colors
 #include <string.h> // For strlen, strcpy, strcat
 #include <stdio.h>  // For sprintf (not used if _int_to_string_decimal is used)
 
+// The error screen must not be counted by the force-included VDP_STATS wrappers,
+// which may be what is reporting the error (see vdp_stats.h).
+#undef VDP_clearPlane
+#undef VDP_drawText
+
 // Simple int to string for line numbers (decimal, up to 5 digits for u16)
 // Buffer should be at least 6 chars long (5 digits + null terminator).
 static void _int_to_string_decimal(u16 value, char* buffer) {
@@ -39,8 +45,9 @@ void error_handler_display_error(const char* module_name,
     SPR_end(); // Clear sprites
 
     // Set a distinct error palette
-    VDP_setPaletteColor(0, RGB24_TO_VDPCOLOR(0x000000)); // Black background
-    VDP_setPaletteColor(15, RGB24_TO_VDPCOLOR(0xFFFFFF)); // White text 
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000000)); // Black background
+    palette_manager_set_color(15, RGB24_TO_VDPCOLOR(0xFFFFFF)); // White text 
+    palette_manager_commit_now(); // The main loop, which normally commits, no longer runs
     VDP_setTextPalette(PAL0); // Ensure text uses PAL0
 
     u16 y_pos = 2; // Starting Y position for text
@@ -5,54 +5,38 @@
  * This module handles the setup and updating of visual elements such as
  * tilemaps and sprites. It includes functions for loading graphical assets,
  * initializing the sprite system, and managing player sprite movement and animation.
+ * The player is an entity of the entity pool, which moves and animates it.
  */
 #include "graphics.h"
 #include "resources.h" // For rescomp resources (spr_player, my_tileset, sfx_ping_data)
-#include "animation.h" // For update_player_animation()
+#include "entity_pool.h" // For the player entity
 #include "pcm_player.h"  // New - For pcm_player_play()
-#include "input.h"     // For input_is_dpad_xxx_pressed() and input_is_button_pressed()
+#include "input.h"     // For input_is_held() and input_is_just_pressed()
+#include "dma_scheduler.h" // For dma_scheduler_drain()
+#include "vram_alloc.h" // For vram_alloc_acquire_tileset()
+#include "palette_manager.h" // For palette_manager_set_palette()
+#include "maps.h"        // For simple_map, compiled from res/maps.res
 
 // --- Tilemap Definition (Example) ---
-// This is a sample tilemap that can be displayed.
-// It's currently not active in the main demo loop.
-// Tile indices correspond to tiles in 'tileset.png' after processing by rescomp.
-// 0: Transparent/empty (or first tile in tileset if not handled as special)
+// The sample tilemap is `simple_map` in res/maps/simple_map.csv, compiled by the
+// map compiler into `maps.h` (see res/maps.res). Its tile numbers index `my_tileset`:
+// 0: Transparent/empty
 // 1: White tile (index 1 in tileset.png)
 // 2: Pattern A tile (index 2 in tileset.png)
 // 3: Pattern B tile (index 3 in tileset.png)
 
-/** @brief Width of the example tilemap in tiles. */
-#define MAP_WIDTH 20
-/** @brief Height of the example tilemap in tiles. */
-#define MAP_HEIGHT 10
-
-/**
- * @brief Defines the layout of the simple example tilemap.
- * Each value is a tile index that refers to a tile in `my_tileset`.
- */
-const u16 simple_map[MAP_HEIGHT][MAP_WIDTH] = {
-    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
-    {1,2,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,3,1},
-    {1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-    {1,0,0,2,2,0,0,0,0,0,0,0,0,0,2,2,0,0,0,1},
-    {1,0,0,2,2,0,0,0,0,0,0,0,0,0,2,2,0,0,0,1},
-    {1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-    {1,0,0,0,0,0,0,3,3,3,3,0,0,0,0,0,0,0,0,1},
-    {1,0,0,0,0,0,0,3,0,0,3,0,0,0,0,0,0,0,0,1},
-    {1,2,3,0,0,0,0,3,3,3,3,0,0,0,0,0,0,2,3,1},
-    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-};
-
 // --- Sprite Variables ---
-/** @brief Pointer to the SGDK Sprite object for the player. */
-static Sprite* player_sprite_sgdk;
-/** @brief Player's current X position on the screen. */
-static s16 player_x = 100;
-/** @brief Player's current Y position on the screen. */
-static s16 player_y = 100;
+/** @brief Entity pool id of the player. */
+static u16 player_entity = ENTITY_POOL_NONE;
+/** @brief Player's starting position on the screen. */
+#define PLAYER_START_X 100
+#define PLAYER_START_Y 100
 /** @brief Movement speed of the player sprite in pixels per frame. */
 #define PLAYER_SPEED 2
 
+/** @brief First VRAM tile of `my_tileset`, as handed out by the VRAM allocator. */
+static u16 simple_tileset_index = TILE_USER_INDEX;
+
 
 // --- Function Implementations ---
 
@@ -61,50 +45,44 @@ static s16 player_y = 100;
  *
  * The tileset data (`my_tileset`) is defined in `resources.h` (generated from `resources.res`)
  * and originates from `res/gfx/tileset.png`.
- * Tiles are loaded into VRAM starting at `TILE_USER_INDEX`.
+ * The VRAM allocator picks the tile range; if the tiles are still resident from
+ * an earlier visit, nothing is uploaded. Call `release_simple_tileset()` when done.
  * The palette associated with `my_tileset` is loaded into hardware palette `PAL0`.
  */
 void load_simple_tileset() {
-    // VDP_loadTileSet arguments:
-    // const TileSet *tileset: Pointer to the TileSet structure (from resources.h).
-    // u16 index: The starting tile index in VRAM where tiles will be loaded.
-    //            `TILE_USER_INDEX` is an SGDK constant for the first user-definable tile index.
-    // TransferMethod tm: DMA is recommended for speed.
-    VDP_loadTileSet(&my_tileset, TILE_USER_INDEX, DMA);
+    // vram_alloc_acquire_tileset hands out a tile range for the TileSet (from resources.h)
+    // and queues the upload on the DMA scheduler, unless the range is still resident.
+    // Wait for the upload, since display_simple_tilemap() is usually called right after.
+    simple_tileset_index = vram_alloc_acquire_tileset(&my_tileset);
+    dma_scheduler_drain();
 
     // Load palette for the tileset.
-    // `my_tileset.palette` is a pointer to a Palette structure (also from resources.h).
+    // A TileSet carries no palette, so take it from `tileset_img`, the IMAGE resource
+    // built from the same PNG (see resources.res).
     // `PAL0` is an SGDK constant for hardware palette 0.
-    VDP_setPalette(PAL0, my_tileset.palette->data);
+    palette_manager_set_palette(PAL0, tileset_img.palette->data);
+}
+
+/**
+ * @brief Drops the reference taken by `load_simple_tileset()`.
+ * The tiles stay resident until the allocator needs their space.
+ */
+void release_simple_tileset() {
+    vram_alloc_release(&my_tileset);
 }
 
 /**
  * @brief Displays the `simple_map` on background plane A (BG_A).
  *
- * This function first clears BG_A. Then, it iterates through the `simple_map`
- * array and uses `VDP_setTileMapXY` to draw each tile onto the screen.
- * Tiles with value 0 in `simple_map` are considered empty and are skipped.
- * The tile attributes are set to use `PAL0` and the tile index is offset by `TILE_USER_INDEX`.
+ * This function first clears BG_A, then writes the compiled `simple_map` at the
+ * top-left corner. Its entries already hold `PAL0` and the tile numbers, so the
+ * only change made while unpacking is moving the tile numbers to the first tile
+ * of `my_tileset` (see `load_simple_tileset()`).
  */
 void display_simple_tilemap() {
     VDP_clearPlane(BG_A, TRUE); // Clear Plane A, TRUE to also clear VRAM representation
 
-    for (int y_coord = 0; y_coord < MAP_HEIGHT; y_coord++) {
-        for (int x_coord = 0; x_coord < MAP_WIDTH; x_coord++) {
-            // Only draw non-zero tiles (assuming 0 is an "empty" tile in our map design)
-            if (simple_map[y_coord][x_coord] != 0) {
-                // Construct tile attributes:
-                // - PAL0: Use palette 0.
-                // - Priority: FALSE (lower priority than sprites if sprites have high priority).
-                // - FlipH, FlipV: FALSE (no flipping).
-                // - Tile Index: `TILE_USER_INDEX` + value from `simple_map`.
-                //   This assumes tile values in `simple_map` (1, 2, 3, etc.) directly
-                //   correspond to the order of tiles in `tileset.png` (after the 0th tile).
-                VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, TILE_USER_INDEX + simple_map[y_coord][x_coord]),
-                                 x_coord, y_coord);
-            }
-        }
-    }
+    map_asset_load(&simple_map, BG_A, 0, 0, simple_tileset_index);
 }
 
 /**
@@ -113,12 +91,13 @@ void display_simple_tilemap() {
  * This function performs critical setup for using sprites:
  * 1.  Calls `SPR_init()` to initialize SGDK's sprite engine.
  * 2.  Loads the player sprite's palette (`spr_player.palette` from `resources.h`)
- *     into hardware palette `PAL1` using `VDP_setPalette()`.
- * 3.  Adds the player sprite to the VDP sprite list using `SPR_addSprite()`.
+ *     into hardware palette `PAL1` using `palette_manager_set_palette()`.
+ * 3.  Empties the entity pool and spawns the player in it, standing still.
  *     `&spr_player` (from `resources.h`) provides the sprite definition (size, tiles, etc.).
- *     Initial position is `(player_x, player_y)`.
+ *     Initial position is `(PLAYER_START_X, PLAYER_START_Y)`.
  *     Attributes `TILE_ATTR(PAL1, TRUE, FALSE, FALSE)` set palette to `PAL1` and high priority.
- * 4.  Sets the initial animation frame of the player sprite to frame 0 using `SPR_setFrame()`.
+ *     The pool adds the sprite with `SPR_addSprite()` at animation frame 0, and keeps
+ *     the player on screen (320x224, considering sprite size 16x16).
  *
  * Note: `init_sound_system()` and `input_init()` are also called here, though they could
  * alternatively be called directly from `main.c` during global initialization.
@@ -127,13 +106,12 @@ void setup_sprites() {
     SPR_init(); // Initialize SGDK sprite engine
 
     // Load player sprite palette into PAL1
-    VDP_setPalette(PAL1, spr_player.palette->data);
-
-    // Add player sprite to the screen
-    player_sprite_sgdk = SPR_addSprite(&spr_player, player_x, player_y, TILE_ATTR(PAL1, TRUE, FALSE, FALSE));
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
 
-    // Set initial animation frame
-    SPR_setFrame(player_sprite_sgdk, 0);
+    // Add the player to the screen
+    entity_pool_init();
+    player_entity = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), PLAYER_START_X,
+                                      PLAYER_START_Y, 0, 0);
 
     // Initialize other systems (can also be done in main)
     // init_sound_system(); // REMOVED - Sound system init called from main.c now by sound_manager_init()
@@ -144,51 +122,34 @@ void setup_sprites() {
  * @brief Updates game logic related to sprites, primarily player movement and actions.
  *
  * This function is called every frame from the main game loop. It performs:
- * 1.  **Input Handling:** Checks D-Pad input using `input_is_dpad_xxx_pressed()`
- *     functions and updates `player_x` and `player_y` positions based on `PLAYER_SPEED`.
- * 2.  **Boundary Checks:** Ensures the player sprite stays within the screen boundaries
- *     (320x224, considering sprite size 16x16).
- * 3.  **Sprite Position Update:** Sets the new hardware sprite position using `SPR_setPosition()`.
- * 4.  **Sound Trigger:** Checks if Button A is pressed using `input_is_button_pressed(BUTTON_A)`.
- *     If true, it calls `play_sfx_ping()` to play the sound effect.
- * 5.  **Animation Update:** Calls `update_player_animation()` to advance the player's
- *     animation frame if necessary.
- * 6.  **VDP Update:** Calls `SPR_update()` to commit all sprite changes (position, frame, etc.)
+ * 1.  **Input Handling:** Checks D-Pad input using `input_is_held()` and sets the
+ *     player entity's velocity from `PLAYER_SPEED`.
+ * 2.  **Sound Trigger:** Checks if Button A is pressed using `input_is_just_pressed(BUTTON_A)`.
+ *     If true, it calls `pcm_player_play()` to play the sound effect.
+ * 3.  **Entity Update:** Calls `entity_pool_update()`, which moves the player, keeps it
+ *     within the screen boundaries, advances its animation and sets the sprite position.
+ * 4.  **VDP Update:** Calls `SPR_update()` to commit all sprite changes (position, frame, etc.)
  *     to the VDP for display on the next screen refresh.
  */
 void update_sprites_example() {
     // --- Input-based movement ---
-    if (input_is_held(BUTTON_LEFT)) { // Was input_is_dpad_left_pressed or similar
-        player_x -= PLAYER_SPEED;
-    }
-    if (input_is_held(BUTTON_RIGHT)) {
-        player_x += PLAYER_SPEED;
-    }
-    if (input_is_held(BUTTON_UP)) {
-        player_y -= PLAYER_SPEED;
-    }
-    if (input_is_held(BUTTON_DOWN)) {
-        player_y += PLAYER_SPEED;
-    }
-
-    // Keep sprite on screen (simple boundary check)
-    // Screen width 320, height 224. Sprite is 16x16 pixels.
-    if (player_x < 0) player_x = 0;
-    if (player_x > (320 - 16)) player_x = 320 - 16;
-    if (player_y < 0) player_y = 0;
-    if (player_y > (224 - 16)) player_y = 224 - 16;
-
-    // Update hardware sprite position
-    SPR_setPosition(player_sprite_sgdk, player_x, player_y);
+    // Velocities are 8.8 pixels per frame. The pool's bounds are the screen, so
+    // the player stops at its edges (the bounce is undone by the next frame's input).
+    s16 vx = 0, vy = 0;
+    if (input_is_held(BUTTON_LEFT)) vx -= PLAYER_SPEED << 8;
+    if (input_is_held(BUTTON_RIGHT)) vx += PLAYER_SPEED << 8;
+    if (input_is_held(BUTTON_UP)) vy -= PLAYER_SPEED << 8;
+    if (input_is_held(BUTTON_DOWN)) vy += PLAYER_SPEED << 8;
+    entity_pool_set_velocity(player_entity, vx, vy);
 
     // --- Sound Trigger ---
     // Play sound if Button A is pressed
-    if (input_is_button_pressed(BUTTON_A)) {
+    if (input_is_just_pressed(BUTTON_A)) {
         pcm_player_play(&sfx_ping_data); // Replaced play_sfx_ping()
     }
 
-    // Update player animation
-    update_player_animation(player_sprite_sgdk);
+    // Move and animate the player
+    entity_pool_update();
 
     // Commit all sprite changes to VDP
     SPR_update();
@@ -0,0 +1,46 @@
+/**
+ * @file hv_timer.c
+ * @brief Implements scanline-resolution timestamps from the VDP HV counter.
+ */
+#include "hv_timer.h"
+
+/** @brief Total scanlines per frame on NTSC systems. */
+#define HV_TIMER_NTSC_LINES 262
+/** @brief Total scanlines per frame on PAL systems. */
+#define HV_TIMER_PAL_LINES 313
+/** @brief 68000 cycles per scanline (3420 master clocks / 7). */
+#define HV_TIMER_CYCLES_PER_LINE 488
+
+u16 hv_timer_lines_per_frame() {
+    return IS_PALSYSTEM ? HV_TIMER_PAL_LINES : HV_TIMER_NTSC_LINES;
+}
+
+/**
+ * @brief Returns a monotonically increasing scanline timestamp.
+ *
+ * `vtimer` and the V counter are read together and re-read if the VBlank
+ * interrupt fired in between, so the pair always belongs to the same frame.
+ * Because `vtimer` ticks at the start of VBlank, lines are counted from there:
+ * VBlank lines map to the start of the frame, active lines to the end.
+ */
+u32 hv_timer_now() {
+    u32 frame;
+    u16 line;
+
+    do {
+        frame = vtimer;
+        line = GET_VCOUNTER;
+    } while (frame != vtimer);
+
+    u16 lines_per_frame = hv_timer_lines_per_frame();
+    if (line >= HV_TIMER_ACTIVE_LINES) {
+        line -= HV_TIMER_ACTIVE_LINES;
+    } else {
+        line += lines_per_frame - HV_TIMER_ACTIVE_LINES;
+    }
+    return (frame * lines_per_frame) + line;
+}
+
+u32 hv_timer_lines_to_cycles(u32 lines) {
+    return lines * HV_TIMER_CYCLES_PER_LINE;
+}
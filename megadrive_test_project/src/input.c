@@ -1,5 +1,6 @@
 #include "input.h"
 #include "error_handler.h" // For error reporting
+#include <string.h>        // For sprintf
 
 typedef struct {
     u16 current;
@@ -8,6 +9,21 @@ typedef struct {
 
 static InputState joy1_input_state;
 static u8 is_input_initialized = FALSE; // Initialization flag
+static InputProviderCallback* input_provider = NULL; // NULL means read the real joypad
+
+static InputMode input_mode = INPUT_MODE_LIVE;
+
+// Recording state. `record_count` runs are complete or in progress; the last one grows until the mask changes.
+static InputRun* record_buffer = NULL;
+static u16 record_capacity = 0;
+static u16 record_count = 0;
+
+// Replay state
+static const InputRun* replay_runs = NULL;
+static u16 replay_run_count = 0;
+static u16 replay_index = 0;       // Run being played
+static u16 replay_run_frame = 0;   // Frames already played from that run
+static u8 replay_loop = FALSE;
 
 // Module name for error reporting
 #define MODULE_NAME_INPUT "input"
@@ -16,6 +32,9 @@ void input_init() {
     // JOY_init() is called by SGDK_init().
     joy1_input_state.current = 0;
     joy1_input_state.prev = 0;
+    input_provider = NULL;
+    input_mode = INPUT_MODE_LIVE;
+    record_count = 0;
     is_input_initialized = TRUE;
     // KLog("Input system initialized."); // Optional: KLog for debug on emulator
 }
@@ -27,7 +46,93 @@ void input_update() {
         return; // Should halt in error_handler, but good practice
     }
     joy1_input_state.prev = joy1_input_state.current;
-    joy1_input_state.current = JOY_readJoypad(JOY_1);
+
+    if (input_mode == INPUT_MODE_REPLAY) {
+        if (replay_index >= replay_run_count && replay_loop) replay_index = 0;
+        if (replay_index < replay_run_count) {
+            joy1_input_state.current = replay_runs[replay_index].buttons;
+            if (++replay_run_frame >= replay_runs[replay_index].frames) {
+                replay_index++;
+                replay_run_frame = 0;
+            }
+            return;
+        }
+        input_mode = INPUT_MODE_LIVE; // Recording exhausted, fall through to live input
+    }
+
+    joy1_input_state.current = input_provider ? input_provider() : JOY_readJoypad(JOY_1);
+
+    if (input_mode == INPUT_MODE_RECORD) {
+        InputRun* last = (record_count > 0) ? &record_buffer[record_count - 1] : NULL;
+        if (last != NULL && last->buttons == joy1_input_state.current && last->frames < 0xFFFF) {
+            last->frames++;
+        } else if (record_count < record_capacity) {
+            record_buffer[record_count].buttons = joy1_input_state.current;
+            record_buffer[record_count].frames = 1;
+            record_count++;
+        } else {
+            KLog("input: record buffer full, recording stopped");
+            input_mode = INPUT_MODE_LIVE;
+        }
+    }
+}
+
+void input_set_provider(InputProviderCallback* provider) {
+    input_provider = provider;
+}
+
+void input_record_start(InputRun* buffer, u16 capacity) {
+    if (buffer == NULL || capacity == 0) {
+        error_handler_display_error(MODULE_NAME_INPUT, __func__, __LINE__, "No record buffer!");
+        return;
+    }
+    record_buffer = buffer;
+    record_capacity = capacity;
+    record_count = 0;
+    input_mode = INPUT_MODE_RECORD;
+}
+
+u16 input_record_stop() {
+    if (input_mode == INPUT_MODE_RECORD) input_mode = INPUT_MODE_LIVE;
+    return record_count;
+}
+
+void input_record_export_klog(const char* name) {
+    char line_buf[48];
+    u32 total_frames = 0;
+
+    if (record_buffer == NULL) return;
+
+    sprintf(line_buf, "const InputRun %s[] = {", name);
+    KLog(line_buf);
+    for (u16 i = 0; i < record_count; i++) {
+        sprintf(line_buf, "    { 0x%04X, %u },", record_buffer[i].buttons, record_buffer[i].frames);
+        KLog(line_buf);
+        total_frames += record_buffer[i].frames;
+    }
+    sprintf(line_buf, "}; // %u runs, %lu frames", record_count, total_frames);
+    KLog(line_buf);
+}
+
+void input_replay_start(const InputRun* runs, u16 run_count, u8 loop) {
+    if (runs == NULL || run_count == 0) {
+        error_handler_display_error(MODULE_NAME_INPUT, __func__, __LINE__, "Empty recording!");
+        return;
+    }
+    replay_runs = runs;
+    replay_run_count = run_count;
+    replay_index = 0;
+    replay_run_frame = 0;
+    replay_loop = loop;
+    input_mode = INPUT_MODE_REPLAY;
+}
+
+void input_replay_stop() {
+    if (input_mode == INPUT_MODE_REPLAY) input_mode = INPUT_MODE_LIVE;
+}
+
+InputMode input_get_mode() {
+    return input_mode;
 }
 
 u8 input_is_held(u16 button_mask) {
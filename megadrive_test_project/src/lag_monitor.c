@@ -0,0 +1,138 @@
+/**
+ * @file lag_monitor.c
+ * @brief Implements lag-frame and VBlank-overrun accounting.
+ */
+#include "lag_monitor.h"
+
+#if LAG_MONITOR_ENABLED
+
+#include "hv_timer.h"
+#include "error_handler.h" // For reporting invalid IDs
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_LAG_MONITOR "lag_monitor"
+
+typedef struct {
+    u32 start_lines;   // hv_timer_now() at transition begin
+    u32 start_vblank;  // vtimer at transition begin
+} TransitionTimer;
+
+static LagStateStats state_stats[LAG_MONITOR_MAX_STATES];
+static LagTransitionStats transition_stats[LAG_MONITOR_MAX_TRANSITIONS];
+static TransitionTimer transition_timers[LAG_MONITOR_MAX_TRANSITIONS];
+static u16 state_count = 0;
+static u32 frame_start_vblank = 0; // vtimer at the start of the current loop iteration
+
+void lag_monitor_init(const char* const* state_names, u16 count) {
+    if (count > LAG_MONITOR_MAX_STATES) {
+        error_handler_display_error(MODULE_NAME_LAG_MONITOR, __func__, __LINE__, "Too many states!");
+        return;
+    }
+    memset(state_stats, 0, sizeof(state_stats));
+    memset(transition_stats, 0, sizeof(transition_stats));
+    for (u16 i = 0; i < count; i++) {
+        state_stats[i].name = state_names[i];
+    }
+    state_count = count;
+    frame_start_vblank = vtimer;
+}
+
+void lag_monitor_frame_begin() {
+    frame_start_vblank = vtimer;
+}
+
+void lag_monitor_frame_end(u16 state_before, u16 state_after) {
+    u32 vblanks = vtimer - frame_start_vblank;
+    u16 lag = 0;
+    if (vblanks > 1) lag = (vblanks - 1 > 0xFFFF) ? 0xFFFF : (u16)(vblanks - 1);
+
+    if (state_before >= state_count || state_after >= state_count) {
+        error_handler_display_error(MODULE_NAME_LAG_MONITOR, __func__, __LINE__, "State out of range!");
+        return;
+    }
+
+    state_stats[state_before].frames++;
+    if (state_after != state_before) {
+        // The iteration that switches state usually runs the new state's init
+        // (clears, tileset uploads), so its cost belongs to entering that state.
+        state_stats[state_after].entries++;
+        state_stats[state_after].entry_lag_frames += lag;
+    } else {
+        state_stats[state_before].lag_frames += lag;
+        if (lag > state_stats[state_before].worst_lag) state_stats[state_before].worst_lag = lag;
+    }
+}
+
+void lag_monitor_transition_begin(u16 transition_id, const char* name) {
+    if (transition_id >= LAG_MONITOR_MAX_TRANSITIONS) {
+        error_handler_display_error(MODULE_NAME_LAG_MONITOR, __func__, __LINE__, "Transition ID out of range!");
+        return;
+    }
+    transition_stats[transition_id].name = name;
+    transition_timers[transition_id].start_vblank = vtimer;
+    transition_timers[transition_id].start_lines = hv_timer_now();
+}
+
+void lag_monitor_transition_end(u16 transition_id) {
+    u32 end_lines = hv_timer_now();
+
+    if (transition_id >= LAG_MONITOR_MAX_TRANSITIONS) {
+        error_handler_display_error(MODULE_NAME_LAG_MONITOR, __func__, __LINE__, "Transition ID out of range!");
+        return;
+    }
+
+    LagTransitionStats* stats = &transition_stats[transition_id];
+    u32 lines = end_lines - transition_timers[transition_id].start_lines;
+    stats->count++;
+    stats->last_lines = lines;
+    if (lines > stats->max_lines) stats->max_lines = lines;
+    stats->total_lines += lines;
+    stats->total_vblanks += vtimer - transition_timers[transition_id].start_vblank;
+}
+
+const LagStateStats* lag_monitor_get_state_stats(u16 state) {
+    if (state >= state_count) return NULL;
+    return &state_stats[state];
+}
+
+const LagTransitionStats* lag_monitor_get_transition_stats(u16 transition_id) {
+    if (transition_id >= LAG_MONITOR_MAX_TRANSITIONS || transition_stats[transition_id].count == 0) return NULL;
+    return &transition_stats[transition_id];
+}
+
+u16 lag_monitor_get_state_count() {
+    return state_count;
+}
+
+u32 lag_monitor_get_total_lag() {
+    u32 total = 0;
+    for (u16 i = 0; i < state_count; i++) {
+        total += state_stats[i].lag_frames + state_stats[i].entry_lag_frames;
+    }
+    return total;
+}
+
+void lag_monitor_dump_klog() {
+    char line_buf[64];
+
+    KLog("LAG: state frames lag worst entries entry_lag");
+    for (u16 i = 0; i < state_count; i++) {
+        const LagStateStats* stats = &state_stats[i];
+        if (stats->frames == 0 && stats->entries == 0) continue;
+        sprintf(line_buf, "LAG %s %lu %lu %u %u %lu", stats->name, stats->frames, stats->lag_frames,
+                stats->worst_lag, stats->entries, stats->entry_lag_frames);
+        KLog(line_buf);
+    }
+
+    KLog("LAG_TR: transition count last_lines max_lines total_lines total_vblanks");
+    for (u16 i = 0; i < LAG_MONITOR_MAX_TRANSITIONS; i++) {
+        const LagTransitionStats* stats = &transition_stats[i];
+        if (stats->count == 0) continue;
+        sprintf(line_buf, "LAG_TR %s %u %lu %lu %lu %lu", stats->name, stats->count, stats->last_lines,
+                stats->max_lines, stats->total_lines, stats->total_vblanks);
+        KLog(line_buf);
+    }
+}
+
+#endif // LAG_MONITOR_ENABLED
@@ -24,6 +24,27 @@
 #include "test_fades.h"     // For Fades Test
 #include "test_palette_cycle.h" // For Palette Cycling Test
 #include "test_dialogue.h"      // New
+#include "test_stress_sprites.h" // For the sprite stress test
+#include "test_stress_dma.h"     // For the VDP transfer throughput test
+#include "test_stress_text.h"    // For the text drawing stress test
+#include "test_parallax.h"       // For the parallax bands demo
+#include "test_raster_fx.h"      // For the H-int raster effects demo
+#include "test_stress_entities.h" // For the entity pool stress test
+#include "test_sprite_flicker.h"  // For the sprite flicker demo
+#include "test_stress_ysort.h"     // For the Y-sort comparison
+#include "test_sprite_stream.h"    // For the sprite frame streaming demo
+#include "profiler.h"           // For per-state frame-budget zones (debug builds only)
+#include "pc_sampler.h"         // For statistical PC sampling (`make profile` builds only)
+#include "lag_monitor.h"        // For lag-frame accounting per state (debug builds only)
+#include "vdp_stats.h"          // For VDP traffic per module (`make VDP_STATS=1` builds only)
+#include "watermark.h"          // For stack, heap and VRAM high-water marks (debug builds only)
+#include "dma_scheduler.h"      // For budgeted, prioritized DMA transfers
+#include "vram_alloc.h"         // For ref-counted, cached VRAM tile ranges
+#include "palette_manager.h"    // For the shadow palette and its per-frame upload
+#include "vdp_cache.h"          // For scroll values written once per frame during VBlank
+#include "debug_stats_screen.h" // For the "Debug: Frame Stats" screen
+#include "bench.h"              // For the headless benchmark driver (`make bench` builds only)
+#include "soak.h"               // For the long-running soak test (`make soak` builds only)
 
 //--------------------------------------------------------------------------------------------------
 // Game State Definition and Management
@@ -43,7 +64,18 @@ typedef enum {
     STATE_TEST_SCROLLING,       ///< Runs the scrolling background demo.
     STATE_TEST_MUSIC,           ///< Runs the XGM music playback test.
     STATE_TEST_PALETTE_CYCLE,   ///< Runs the Palette Cycling Test.
-    STATE_TEST_DIALOGUE         ///< Runs the simple Dialogue Box Test.
+    STATE_TEST_DIALOGUE,        ///< Runs the simple Dialogue Box Test.
+    STATE_DEBUG_STATS,          ///< Shows lag and timing totals from the debug instrumentation.
+    STATE_STRESS_SPRITES,       ///< Ramps the sprite count until frames drop.
+    STATE_STRESS_DMA,           ///< Measures tilemap write and DMA throughput.
+    STATE_STRESS_TEXT,          ///< Redraws a full screen of text every frame.
+    STATE_TEST_PARALLAX,        ///< Runs the line-scroll parallax demo.
+    STATE_TEST_RASTER_FX,       ///< Runs the H-int raster effects demo.
+    STATE_STRESS_ENTITIES,      ///< Ramps the entity pool and measures its update.
+    STATE_TEST_SPRITE_FLICKER,  ///< Runs the sprite overflow flicker demo.
+    STATE_STRESS_YSORT,         ///< Compares the incremental Y sort with a full sort.
+    STATE_TEST_SPRITE_STREAM,   ///< Runs the sprite frame streaming demo.
+    STATE_COUNT                 ///< Number of states (not a real state).
 } GameState;
 
 /**
@@ -52,6 +84,45 @@ typedef enum {
  */
 static GameState current_game_state;
 
+#if PROFILER_ENABLED || LAG_MONITOR_ENABLED || WATERMARK_ENABLED || SOAK_ENABLED
+/**
+ * @brief Short display names for each `GameState`, indexed by state value.
+ * Used by the profiler, the lag monitor, the watermarks and the soak test, so keep them to 8 characters or fewer.
+ */
+static const char* const game_state_names[] = {
+    "LOADING",  // STATE_LOADING_SCREEN
+    "MENU",     // STATE_MENU
+    "SPRITES",  // STATE_TEST_SPRITE_DEMO
+    "TILEMAP",  // STATE_TEST_TILEMAP_DISPLAY
+    "FADES",    // STATE_TEST_FADES
+    "INPUT",    // STATE_TEST_INPUT_DISPLAY
+    "SCROLL",   // STATE_TEST_SCROLLING
+    "MUSIC",    // STATE_TEST_MUSIC
+    "PALCYCLE", // STATE_TEST_PALETTE_CYCLE
+    "DIALOGUE", // STATE_TEST_DIALOGUE
+    "DEBUG",    // STATE_DEBUG_STATS
+    "STR_SPR",  // STATE_STRESS_SPRITES
+    "STR_DMA",  // STATE_STRESS_DMA
+    "STR_TEXT", // STATE_STRESS_TEXT
+    "PARALLAX", // STATE_TEST_PARALLAX
+    "RASTER",   // STATE_TEST_RASTER_FX
+    "STR_ENT",  // STATE_STRESS_ENTITIES
+    "FLICKER",  // STATE_TEST_SPRITE_FLICKER
+    "STR_YSRT", // STATE_STRESS_YSORT
+    "SPRSTRM"   // STATE_TEST_SPRITE_STREAM
+};
+#endif
+
+/**
+ * @brief Transitions timed individually by the lag monitor.
+ * Each value is a lag monitor transition ID.
+ */
+typedef enum {
+    TRANSITION_GO_TO_MENU,      ///< go_to_menu_state(): plane clears and menu redraw.
+    TRANSITION_RETURN_TO_MENU,  ///< return_to_menu(): sprite shutdown, clears, then go_to_menu_state().
+    TRANSITION_ENTER_TEST       ///< Running the selected test's init from the menu.
+} TransitionId;
+
 // --- Variables and Enum for Fade Test (specific to STATE_TEST_FADES) ---
 // Removed: static u16 fade_test_palette[16]; 
 // Removed: typedef enum { ... } FadeTestSubState;
@@ -75,6 +146,7 @@ static void init_scrolling_test_state();
 static void init_music_test_state();
 static void init_palette_cycle_test_state();
 static void init_dialogue_test_state();  // New
+static void init_debug_stats_state();
 
 // --- Update Functions ---
 static void update_menu_state();
@@ -85,6 +157,7 @@ static void update_scrolling_test_state();
 static void update_music_test_state();
 static void update_palette_cycle_test_state();
 static void update_dialogue_test_state(); // New
+static void update_debug_stats_state();
 
 
 //--------------------------------------------------------------------------------------------------
@@ -106,29 +179,37 @@ static void show_loading_screen() {
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE);
 
-    // Load and display the logo (compiled via resources.res)
-    VDP_setPalette(PAL0, logo_minnka_img_tileset.palette->data);
-    VDP_loadTileSet(&logo_minnka_img_tileset, TILE_USER_INDEX, DMA);
+    // Load and display the logo (compiled via resources.res). The tiles are too
+    // big for one VBlank, so let the DMA scheduler spread them over a few frames
+    // before the tilemap that uses them is drawn.
+    palette_manager_set_palette(PAL0, logo_minnka_img.palette->data);
+    u16 logo_tile_index = vram_alloc_acquire_tileset(logo_minnka_img.tileset);
+    dma_scheduler_drain();
 
+    const TileMap* logo_tilemap = logo_minnka_img.tilemap;
     u16 logo_offset_x = 0;
-    if (logo_minnka_img_tilemap.w < 40) { // Center if narrower than 40 tiles (320px)
-        logo_offset_x = (40 - logo_minnka_img_tilemap.w) / 2;
+    if (logo_tilemap->w < 40) { // Center if narrower than 40 tiles (320px)
+        logo_offset_x = (40 - logo_tilemap->w) / 2;
     }
 
-    VDP_setTileMapEx(BG_A, &logo_minnka_img_tilemap,
-                     TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, TILE_USER_INDEX),
+    VDP_setTileMapEx(BG_A, logo_tilemap,
+                     TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, logo_tile_index),
                      logo_offset_x, 0, 0, 0,
-                     logo_minnka_img_tilemap.w, logo_minnka_img_tilemap.h, DMA);
+                     logo_tilemap->w, logo_tilemap->h, DMA);
 
     timer_start_time = SYS_getTime(); // Get time in system ticks
 
     // Loop for duration or until Start is pressed
     while(TRUE) {
         input_update(); // Must be called to read joypad state
-        if (input_is_button_pressed(BUTTON_START)) break;
+        if (input_is_just_pressed(BUTTON_START)) break;
         if (SYS_getTime() - timer_start_time >= (loading_screen_duration_seconds * SGDK_TIMER_NORMAL_DIV)) break;
+        WATERMARK_END_FRAME(STATE_LOADING_SCREEN); // This loop runs its own frames
+        palette_manager_commit();
+        dma_scheduler_flush();
         SYS_doVBlankProcess(); // Process VBlank tasks (like VSync wait)
     }
+    vram_alloc_release(logo_minnka_img.tileset); // Evictable from now on
     go_to_menu_state(); // Transition to the main menu
 }
 
@@ -140,11 +221,13 @@ static void show_loading_screen() {
  * and logic, and sets the `current_game_state` to `STATE_MENU`.
  */
 static void go_to_menu_state() {
+    LAG_MONITOR_TRANSITION_BEGIN(TRANSITION_GO_TO_MENU, "GO_MENU");
     VDP_clearPlane(BG_A, TRUE); // Clear any previous content from planes
     VDP_clearPlane(BG_B, TRUE);
     // menu_init() will set its own background color and text palette.
     menu_init(); // Initialize menu content, drawing, and internal state
     current_game_state = STATE_MENU; // Set the application state to Menu
+    LAG_MONITOR_TRANSITION_END(TRANSITION_GO_TO_MENU);
 }
 
 /**
@@ -157,12 +240,14 @@ static void go_to_menu_state() {
  * Optional fade transitions could be added here for smoother exits from tests.
  */
 static void return_to_menu() {
+    LAG_MONITOR_TRANSITION_BEGIN(TRANSITION_RETURN_TO_MENU, "RET_MENU");
     SPR_end(); // Clear/disable all sprites
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE);
     // Optional: transition_fade_out_to_black(10); // Fade out from test
     go_to_menu_state();
     // Optional: transition_fade_in_from_black(10);  // Fade into menu
+    LAG_MONITOR_TRANSITION_END(TRANSITION_RETURN_TO_MENU);
 }
 
 // Removed: static void init_sprite_demo_state() { ... }
@@ -229,6 +314,18 @@ static void init_dialogue_test_state() {
     current_game_state = STATE_TEST_DIALOGUE;
 }
 
+/**
+ * @brief Initializes the "Debug: Frame Stats" screen.
+ *
+ * Calls `debug_stats_screen_init()` from `debug_stats_screen.c`, which draws the
+ * lag and transition totals and writes them to the debug port.
+ * Sets the `current_game_state` to `STATE_DEBUG_STATS`.
+ */
+static void init_debug_stats_state() {
+    debug_stats_screen_init();
+    current_game_state = STATE_DEBUG_STATS;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 // State Update Functions
@@ -253,6 +350,7 @@ static void update_menu_state() {
     if (selected_test_index != -1) { // An item has been selected
         menu_reset_action_id(); // Reset the action ID to prevent re-triggering
 
+        LAG_MONITOR_TRANSITION_BEGIN(TRANSITION_ENTER_TEST, "ENTER");
         switch (selected_test_index) {
             case 0: 
                 test_sprite_demo_init(); // Call new module's init
@@ -271,8 +369,46 @@ static void update_menu_state() {
             case 5: init_music_test_state(); break;
             case 6: init_palette_cycle_test_state(); break;
             case 7: init_dialogue_test_state(); break; // New menu item for Dialogue Test
+            case 8: init_debug_stats_state(); break;
+            case 9:
+                test_stress_sprites_init();
+                current_game_state = STATE_STRESS_SPRITES;
+                break;
+            case 10:
+                test_stress_dma_init();
+                current_game_state = STATE_STRESS_DMA;
+                break;
+            case 11:
+                test_stress_text_init();
+                current_game_state = STATE_STRESS_TEXT;
+                break;
+            case 12:
+                parallax_test_init();
+                current_game_state = STATE_TEST_PARALLAX;
+                break;
+            case 13:
+                raster_fx_test_init();
+                current_game_state = STATE_TEST_RASTER_FX;
+                break;
+            case 14:
+                test_stress_entities_init();
+                current_game_state = STATE_STRESS_ENTITIES;
+                break;
+            case 15:
+                test_sprite_flicker_init();
+                current_game_state = STATE_TEST_SPRITE_FLICKER;
+                break;
+            case 16:
+                test_stress_ysort_init();
+                current_game_state = STATE_STRESS_YSORT;
+                break;
+            case 17:
+                test_sprite_stream_init();
+                current_game_state = STATE_TEST_SPRITE_STREAM;
+                break;
             default: go_to_menu_state(); break; // Should not happen
         }
+        LAG_MONITOR_TRANSITION_END(TRANSITION_ENTER_TEST);
     }
 }
 
@@ -282,66 +418,12 @@ static void update_menu_state() {
 /**
  * @brief Updates logic for the controller input display test state.
  *
- * Calls `input_test_update_display()` (from `input_test.c`) with the current
- * joypad state obtained from `input_get_joy1_state()`.
+ * Calls `input_test_update_display()` (from `input_test.c`), which reads the
+ * current joypad state through the input module.
  * Checks for the Start button press to return to the main menu.
  */
 static void update_input_display_state() {
-    input_test_update_display(joy1_current_state); // Use direct state from input.c (if made accessible) or keep input_get_joy1_state if that's updated
-                                                // Assuming input_get_joy1_state() was removed, this needs to be updated.
-                                                // However, input.c now has static joy1_current_state.
-                                                // For now, let's assume input_test_update_display can be called without arguments
-                                                // if it internally uses input_is_held / input_is_just_pressed for its display logic,
-                                                // OR input_get_joy1_state() is temporarily kept/re-added for this specific display test.
-                                                // The prompt didn't specify changing input_test.c, so let's assume it still needs joy_state.
-                                                // For now, to make this compile, we'd need a way to get current state.
-                                                // This highlights a dependency: input_test_update_display needs the raw state.
-                                                // Let's assume input_get_joy1_state() is *temporarily* kept for this one test,
-                                                // or input_test.c is also refactored. Given the task focuses on *using* the new functions,
-                                                // this part needs careful handling.
-                                                // For now, I will assume input_get_joy1_state() is still available for this specific test.
-                                                // If input_get_joy1_state() was indeed removed from input.h,
-                                                // then input_test_update_display would need refactoring, or main.c
-                                                // would pass input_is_held for each button to it.
-                                                // The simplest solution is to use input_is_held for the exit condition,
-                                                // and assume input_test_update_display(u16) still needs a raw state.
-                                                // The prompt for input.h removed input_get_joy1_state from the header.
-                                                // So, input_test_update_display(u16) needs to be called with joy1_current_state from input.c.
-                                                // This implies joy1_current_state must be made extern or have a getter.
-                                                // This was not part of the task.
-                                                // Reverting to the idea that input_test.c should be updated to use new functions if it displays states.
-                                                // For now, I will only change the exit condition as per prompt.
-                                                // The call to input_test_update_display(input_get_joy1_state()) will be left as is,
-                                                // acknowledging this as a potential follow-up refactor for input_test.c.
-                                                // Actually, input_get_joy1_state() was removed from input.h, so this will cause a compile error.
-                                                // The task implies input_test.c should also be updated.
-                                                // Since that's not specified, I'll make a minimal change to make it "work" by
-                                                // temporarily re-adding a way to get the raw state or by changing input_test.c.
-                                                // The most consistent change is to assume input_test_update_display itself will be refactored
-                                                // to use the new input_is_held functions to display its state.
-                                                // So, the call becomes input_test_update_display() without args.
-                                                // This means input_test.c must be changed.
-                                                // For now, I will only change the exit condition as per prompt.
-                                                // The call to input_test_update_display will be an issue.
-
-    // Per prompt, only changing exit condition here.
-    // The call to input_test_update_display(input_get_joy1_state()) will be an issue due to removal of input_get_joy1_state().
-    // This subtask should ideally include refactoring input_test.c.
-    // For now, focusing strictly on the prompt:
-    // input_test_update_display(input_get_joy1_state()); // This line is problematic if input_get_joy1_state is removed
-    // Let's assume input_test.c would be refactored to not need the raw state passed in,
-    // and would call input_is_held itself for each button.
-    // So, the call becomes:
-    // input_test_update_display(joy1_current_state); // This requires joy1_current_state to be accessible.
-                                                   // This is still problematic.
-                                                   // The best way for THIS task is to assume input_test_update_display
-                                                   // is updated to match the new input system internally.
-                                                   // So, we just call it.
-
-    input_test_update_display(); // Corrected call with no arguments, assumes input_test.c now uses new input system.
-                                                      // This is not ideal as it re-reads, but avoids changing input_test.c in *this* task.
-                                                      // A better fix would be to update input_test.c to use the new functions.
-                                                      // Given the constraint of the current task, this is a temporary workaround for the display.
+    input_test_update_display(); // Reads the buttons through input_is_held()
 
     if (input_is_just_pressed(BUTTON_START)) { // Was input_is_button_pressed
         return_to_menu();
@@ -416,6 +498,22 @@ static void update_dialogue_test_state() {
     }
 }
 
+/**
+ * @brief Updates the "Debug: Frame Stats" screen.
+ *
+ * Calls `debug_stats_screen_update()` for paging and periodic redraws.
+ * Checks for the Start button press to call `debug_stats_screen_on_exit()`
+ * and then `return_to_menu()` to go back to the main menu.
+ */
+static void update_debug_stats_state() {
+    debug_stats_screen_update();
+
+    if (input_is_just_pressed(BUTTON_START)) {
+        debug_stats_screen_on_exit();
+        return_to_menu();
+    }
+}
+
 
 //--------------------------------------------------------------------------------------------------
 // Main Application Entry Point
@@ -429,8 +527,11 @@ static void update_dialogue_test_state() {
  * Enters the main game loop, which:
  * 1. Updates controller input using `input_update()`.
  * 2. Uses a `switch` statement based on `current_game_state` to call the
- *    appropriate update function for the current state.
+ *    appropriate update function for the current state. In debug builds the
+ *    dispatch is wrapped in a profiler zone named after the state.
  * 3. Calls `SYS_doVBlankProcess()` to handle VBlank tasks (sprite DMA, sound updates, VSync wait).
+ * 4. In debug builds, counts the VBlanks that passed during the iteration and
+ *    charges any extra ones (lag frames) to the state via the lag monitor.
  *
  * @return int Typically 0, though the return value is not used in this embedded context.
  */
@@ -442,15 +543,39 @@ int main() {
     input_init();        // Input handling system
     // Removed: init_sound_system(); 
     sound_manager_init(); // Initialize the new sound manager
-
+    dma_scheduler_init(); // Per-frame DMA budget (NTSC or PAL)
+    vram_alloc_init();    // VRAM tile ranges for the loading screen and the tests
+    palette_manager_init(); // Shadow palette (the only CRAM readback)
+    vdp_cache_init();     // Scroll cache, committed by the VBlank process callback
+    PROFILER_INIT();      // Frame-budget profiler (compiled out in release builds)
+    PC_SAMPLER_INIT();    // PC-sampling profiler (only in `make profile` builds)
+    LAG_MONITOR_INIT(game_state_names, STATE_COUNT); // Lag accounting (compiled out in release builds)
+    VDP_STATS_INIT();     // VDP traffic accounting (only in `make VDP_STATS=1` builds)
+    WATERMARK_INIT(game_state_names, STATE_COUNT); // Paints the stack (compiled out in release builds)
+
+#if BENCH_ENABLED || SOAK_ENABLED
+    // The benchmark and soak ROMs drive the menu themselves, so skip the timed loading screen.
+    BENCH_INIT();
+    go_to_menu_state();
+    SOAK_INIT(game_state_names, STATE_COUNT); // After the menu is up, so it records the menu's plane size
+#else
     // Set the initial game state
     current_game_state = STATE_LOADING_SCREEN;
+#endif
 
     // --- Main Game Loop ---
     while(1) {
+        LAG_MONITOR_FRAME_BEGIN(); // Remember the VBlank count to detect missed frames
+        BENCH_FRAME_BEGIN();       // Frame start timestamp (benchmark ROM only)
+        SOAK_FRAME_BEGIN();        // Frame start timestamp (soak ROM only)
+
         // Update controller input state once per frame
         input_update();
 
+        // The state may change inside the switch, so remember which zone was opened.
+        GameState frame_state = current_game_state;
+        PROFILER_ZONE_BEGIN(frame_state, game_state_names[frame_state]);
+
         // Process logic based on the current game state
         switch (current_game_state) {
             case STATE_LOADING_SCREEN:
@@ -496,15 +621,95 @@ int main() {
             case STATE_TEST_DIALOGUE: // New case
                 update_dialogue_test_state(); // This function also handles its own exit.
                 break;
+            case STATE_DEBUG_STATS:
+                update_debug_stats_state(); // This function also handles its own exit.
+                break;
+            case STATE_STRESS_SPRITES:
+                test_stress_sprites_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_stress_sprites_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_STRESS_DMA:
+                test_stress_dma_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_stress_dma_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_STRESS_TEXT:
+                test_stress_text_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_stress_text_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_TEST_PARALLAX:
+                parallax_test_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    parallax_test_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_TEST_RASTER_FX:
+                raster_fx_test_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    raster_fx_test_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_STRESS_ENTITIES:
+                test_stress_entities_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_stress_entities_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_TEST_SPRITE_FLICKER:
+                test_sprite_flicker_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_sprite_flicker_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_STRESS_YSORT:
+                test_stress_ysort_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_stress_ysort_on_exit();
+                    return_to_menu();
+                }
+                break;
+            case STATE_TEST_SPRITE_STREAM:
+                test_sprite_stream_update();
+                if (input_is_just_pressed(BUTTON_START)) {
+                    test_sprite_stream_on_exit();
+                    return_to_menu();
+                }
+                break;
             default:
                 // Should not happen with defined states.
                 // Optionally, handle by defaulting to a safe state like the menu.
                 // go_to_menu_state();
                 break;
         }
+        PROFILER_ZONE_END(frame_state);
+        palette_manager_commit(); // Queue this frame's palette changes as one CRAM transfer
+        dma_scheduler_flush(); // Hand this frame's share of the queued transfers to SGDK's DMA queue
+        PROFILER_END_FRAME(); // Overlay toggle (C button) and redraw
+        PC_SAMPLER_END_FRAME(); // Periodic histogram dump to KLog
+        VDP_STATS_END_FRAME();  // Close this frame's VDP traffic counters, overlay (C button)
+        BENCH_FRAME_END(current_game_state == STATE_MENU); // Metrics and next scripted input
+        SOAK_FRAME_END(frame_state, current_game_state == STATE_MENU); // Leak checks and next scripted input
+
         // SGDK's VBlank processing function.
         // Handles VBlank tasks: DMA sprite updates, sound driver updates, VSync wait.
         SYS_doVBlankProcess();
+
+        // More than one VBlank since LAG_MONITOR_FRAME_BEGIN() means this iteration dropped frames.
+        LAG_MONITOR_FRAME_END(frame_state, current_game_state);
+        // Heap low-water mark; tile uploads count for the state that is now current.
+        WATERMARK_END_FRAME(current_game_state);
     }
     return (0); // Standard main return, not typically used in embedded systems.
 }
@@ -0,0 +1,69 @@
+/**
+ * @file map_asset.c
+ * @brief Implements unpacking and loading of the compiled map assets.
+ */
+#include "map_asset.h"
+#include "tilemap_blit.h"  // For the plane address
+#include "error_handler.h" // For reporting failed loads
+
+// Module name for error reporting
+#define MODULE_NAME_MAP_ASSET "map_asset"
+
+void map_asset_unpack(const MapAsset* map, u16* dest, u16 base_index) {
+    const u16* src = map->data;
+    u16* end = dest + map->w * map->h;
+    u16 delta = base_index - map->base; // Wraps for a lower base; the sum is still right
+
+    if (map->compression == MAP_ASSET_NONE) {
+        while (dest < end) *dest++ = *src++ + delta;
+        return;
+    }
+
+    while (dest < end) {
+        u16 token = *src++;
+        if (token & 0x8000) {
+            // Match: copies words already written, so they are rebased already.
+            u16 len = ((token >> 10) & 0x1F) + 2;
+            const u16* from = dest - ((token & 0x3FF) + 1);
+            while (len--) *dest++ = *from++;
+        } else {
+            u16 len = token;
+            while (len--) *dest++ = *src++ + delta;
+        }
+    }
+}
+
+u8 map_asset_load(const MapAsset* map, VDPPlane plane, u16 x, u16 y, u16 base_index) {
+    u16 plane_addr = tilemap_blit_plane_address(plane);
+    if (plane_addr == 0) return FALSE;
+    u16 plane_width = VDP_getPlaneWidth();
+    if (x + map->w > plane_width || y + map->h > VDP_getPlaneHeight()) {
+        error_handler_display_error(MODULE_NAME_MAP_ASSET, __func__, __LINE__, "Map out of plane!");
+        return FALSE;
+    }
+
+    u16 count = map->w * map->h;
+    const u16* words = map->data;
+    u16* buffer = NULL;
+    if (map->compression != MAP_ASSET_NONE || base_index != map->base) {
+        buffer = MEM_alloc(count * sizeof(u16));
+        if (buffer == NULL) {
+            error_handler_display_error(MODULE_NAME_MAP_ASSET, __func__, __LINE__, "Out of memory!");
+            return FALSE;
+        }
+        map_asset_unpack(map, buffer, base_index);
+        words = buffer;
+    }
+
+    if (x == 0 && map->w == plane_width) {
+        // Rows are contiguous in VRAM too: one transfer.
+        VDP_setTileMapData(plane_addr, words, y * plane_width, count, DMA);
+    } else {
+        for (u16 j = 0; j < map->h; j++) {
+            VDP_setTileMapData(plane_addr, &words[j * map->w], (y + j) * plane_width + x, map->w, DMA);
+        }
+    }
+
+    if (buffer != NULL) MEM_free(buffer);
+    return TRUE;
+}
@@ -1,5 +1,6 @@
 #include "menu.h"
 #include "input.h"   // For input_get_joy1_state()
+#include "palette_manager.h" // For the menu background color
 #include <string.h>  // For strcpy, strcat
 
 // Define menu items
@@ -9,7 +10,19 @@ static const char* menu_items[MAX_MENU_ITEMS] = {
     "3. Test Fades",
     "4. Test Inputs",
     "5. Scrolling Demo",
-    "6. XGM Music Test" // New item
+    "6. XGM Music Test", // New item
+    "7. Palette Cycle Test",
+    "8. Dialogue Box Test",
+    "9. Debug: Frame Stats",
+    "10. Stress: Sprites",
+    "11. Stress: VDP Transfers",
+    "12. Stress: Text",
+    "13. Parallax Demo",
+    "14. Raster Effects",
+    "15. Stress: Entities",
+    "16. Sprite Flicker",
+    "17. Stress: Y-Sort",
+    "18. Sprite Streaming"
 };
 
 static s16 current_selection = 0;
@@ -19,7 +32,7 @@ static s16 selected_action_id = -1; // -1 means no action, otherwise use current
 #define MENU_CURSOR "> "
 #define MENU_NOCURSOR "  "
 #define MENU_START_X 5  // X position for menu text (in tiles)
-#define MENU_START_Y 8  // Y position for the first menu item (in tiles)
+#define MENU_START_Y 6  // Y position for the first menu item (in tiles); the help line must stay above row 28
 
 // Removed: static u16 prev_joy_state = 0; 
 
@@ -31,11 +44,11 @@ void menu_init() {
     // Clear VDP planes and set background color for menu
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE);
-    VDP_setPaletteColor(0, RGB24_TO_VDPCOLOR(0x000022)); // Darker blue for menu background
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000022)); // Darker blue for menu background
 
     // Set text palette (e.g., PAL1). Ensure PAL1 has a light color at a suitable index.
     // If default SGDK font uses color index 15 from the palette:
-    // VDP_setPaletteColor(15 + 16, RGB24_TO_VDPCOLOR(0xFFFFFF)); // White on PAL1, index 15
+    // palette_manager_set_color(15 + 16, RGB24_TO_VDPCOLOR(0xFFFFFF)); // White on PAL1, index 15
     // VDP_setTextPalette(PAL1);
     // For simplicity, if PAL0 color 15 is white, default PAL0 might be okay.
     // Let's assume default PAL0 (index 15) is white for now.
@@ -0,0 +1,89 @@
+/**
+ * @file metatile.c
+ * @brief Implements the metatile row/column decoders.
+ *
+ * Both decoders look up one block per block crossed and copy its entries in a
+ * tight inner loop, rather than redoing the index arithmetic for every tile.
+ */
+#include "metatile.h"
+#include "tilemap_blit.h"  // For the plane address
+#include "error_handler.h" // For reporting out-of-map requests
+
+// Module name for error reporting
+#define MODULE_NAME_METATILE "metatile"
+
+/** @brief Widest plane (128 tiles): the longest row `metatile_load()` decodes at once. */
+#define METATILE_MAX_ROW 128
+
+static u16 row_buffer[METATILE_MAX_ROW];
+
+void metatile_decode_row(const MetatileMap* map, u16 x, u16 y, u16 count, u16* dest, u16 base_index) {
+    if (x + count > METATILE_MAP_TILE_W(map) || y >= METATILE_MAP_TILE_H(map)) {
+        error_handler_display_error(MODULE_NAME_METATILE, __func__, __LINE__, "Row out of map!");
+        return;
+    }
+    u16 shift = map->block_shift;
+    u16 mask = (1 << shift) - 1;
+    u16 delta = base_index - map->base; // Modulo 2^16, so a negative offset works too
+    const u8* layout = &map->layout[(y >> shift) * map->w];
+    const u16* block_row = &map->blocks[(y & mask) << shift]; // Tile row `y` within block 0
+
+    while (count) {
+        const u16* src = &block_row[layout[x >> shift] << (shift * 2)];
+        u16 i = x & mask;
+        u16 n = (1 << shift) - i; // Tiles left in this block's row
+        if (n > count) n = count;
+        x += n;
+        count -= n;
+        while (n--) *dest++ = src[i++] + delta;
+    }
+}
+
+void metatile_decode_column(const MetatileMap* map, u16 x, u16 y, u16 count, u16* dest, u16 base_index) {
+    if (x >= METATILE_MAP_TILE_W(map) || y + count > METATILE_MAP_TILE_H(map)) {
+        error_handler_display_error(MODULE_NAME_METATILE, __func__, __LINE__, "Column out of map!");
+        return;
+    }
+    u16 shift = map->block_shift;
+    u16 mask = (1 << shift) - 1;
+    u16 delta = base_index - map->base;
+    const u8* layout = &map->layout[x >> shift];
+    const u16* block_column = &map->blocks[x & mask]; // Tile column `x` within block 0
+
+    while (count) {
+        const u16* src = &block_column[layout[(y >> shift) * map->w] << (shift * 2)];
+        u16 j = y & mask;
+        u16 n = (1 << shift) - j; // Tiles left in this block's column
+        if (n > count) n = count;
+        y += n;
+        count -= n;
+        while (n--) {
+            *dest++ = src[j << shift] + delta;
+            j++;
+        }
+    }
+}
+
+u8 metatile_load(const MetatileMap* map, VDPPlane plane, u16 x, u16 y, u16 w, u16 h, u16 base_index) {
+    u16 plane_addr = tilemap_blit_plane_address(plane);
+    if (plane_addr == 0) return FALSE;
+    u16 plane_width = VDP_getPlaneWidth();
+    u16 plane_height = VDP_getPlaneHeight();
+    if (x + w > METATILE_MAP_TILE_W(map) || y + h > METATILE_MAP_TILE_H(map) || w > plane_width) {
+        error_handler_display_error(MODULE_NAME_METATILE, __func__, __LINE__, "Area out of map!");
+        return FALSE;
+    }
+
+    // Plane sizes are powers of two, so wrapping is a mask.
+    u16 plane_x = x & (plane_width - 1);
+    u16 first = plane_width - plane_x; // Entries before the row wraps to the plane's left edge
+    if (first > w) first = w;
+
+    for (u16 j = 0; j < h; j++) {
+        u16 row_start = ((y + j) & (plane_height - 1)) * plane_width;
+        metatile_decode_row(map, x, y + j, w, row_buffer, base_index);
+        VDP_setTileMapData(plane_addr, row_buffer, row_start + plane_x, first, DMA);
+        if (first < w) VDP_setTileMapData(plane_addr, &row_buffer[first], row_start, w - first, DMA);
+    }
+    return TRUE;
+}
@@ -5,12 +5,12 @@ void music_init_driver() {
     XGM_init();
 }
 
-void music_start(u8 xgm_track_res_id) {
+void music_start(const u8* xgm_track) {
     // Check if XGM is already playing something, stop it first if needed.
     if (XGM_isPlaying()) {
         XGM_stopPlay();
     }
-    XGM_startPlay(xgm_track_res_id);
+    XGM_startPlay(xgm_track);
 }
 
 void music_stop() {
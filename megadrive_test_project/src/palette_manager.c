@@ -0,0 +1,95 @@
+/**
+ * @file palette_manager.c
+ * @brief Implements the shadow CRAM palette manager.
+ */
+#include "palette_manager.h"
+#include "dma_scheduler.h" // For dma_scheduler_queue_colors(), dma_scheduler_flush()
+#include "error_handler.h" // For reporting out-of-range writes
+#include <string.h>        // For memcpy
+
+// Module name for error reporting
+#define MODULE_NAME_PALETTE_MANAGER "palette_manager"
+
+static u16 shadow[PALETTE_MANAGER_COLORS];
+static u16 dirty_start = PALETTE_MANAGER_COLORS; // First dirty color (PALETTE_MANAGER_COLORS: nothing dirty)
+static u16 dirty_end = 0;                        // One past the last dirty color
+
+static void _palette_manager_mark_dirty(u16 start, u16 end) {
+    if (start < dirty_start) dirty_start = start;
+    if (end > dirty_end) dirty_end = end;
+}
+
+void palette_manager_init() {
+    VDP_getPaletteColors(0, shadow, PALETTE_MANAGER_COLORS);
+    dirty_start = PALETTE_MANAGER_COLORS;
+    dirty_end = 0;
+}
+
+void palette_manager_set_color(u16 index, u16 color) {
+    palette_manager_set_colors(index, &color, 1);
+}
+
+void palette_manager_set_colors(u16 index, const u16* colors, u16 count) {
+    if (index + count > PALETTE_MANAGER_COLORS) {
+        error_handler_display_error(MODULE_NAME_PALETTE_MANAGER, __func__, __LINE__, "Color index out of range!");
+        return;
+    }
+    if (count == 0) return;
+    memcpy(&shadow[index], colors, count * sizeof(u16));
+    _palette_manager_mark_dirty(index, index + count);
+}
+
+void palette_manager_set_palette(u16 num, const u16* colors) {
+    palette_manager_set_colors((num & 3) * 16, colors, 16);
+}
+
+u16 palette_manager_get_color(u16 index) {
+    return shadow[index & (PALETTE_MANAGER_COLORS - 1)];
+}
+
+void palette_manager_get_palette(u16 num, u16* dest) {
+    memcpy(dest, &shadow[(num & 3) * 16], 16 * sizeof(u16));
+}
+
+void palette_manager_commit() {
+    if (dirty_start >= dirty_end) return;
+    // The transfer reads the shadow when it runs, so later writes to the same
+    // colors are picked up as well; a full palette queue keeps the range dirty.
+    if (!dma_scheduler_queue_colors(dirty_start, &shadow[dirty_start], dirty_end - dirty_start)) return;
+    dirty_start = PALETTE_MANAGER_COLORS;
+    dirty_end = 0;
+}
+
+void palette_manager_commit_now() {
+    if (dirty_start >= dirty_end) return;
+    VDP_setPaletteColors(dirty_start, &shadow[dirty_start], dirty_end - dirty_start);
+    dirty_start = PALETTE_MANAGER_COLORS;
+    dirty_end = 0;
+}
+
+void palette_manager_fade_to(const u16* target, u16 frames) {
+    u16 from[PALETTE_MANAGER_COLORS];
+    memcpy(from, shadow, sizeof(from));
+
+    for (u16 step = 1; step <= frames; step++) {
+        // Interpolate each 3-bit component (bits 1-3 of each nibble of 0x0BGR).
+        for (u16 i = 0; i < PALETTE_MANAGER_COLORS; i++) {
+            u16 color = 0;
+            for (u16 shift = 0; shift < 12; shift += 4) {
+                s16 c_from = (from[i] >> shift) & 0xE;
+                s16 c_to = (target[i] >> shift) & 0xE;
+                s16 value = c_from + ((c_to - c_from) * (s16)step) / (s16)frames;
+                color |= (value & 0xE) << shift;
+            }
+            shadow[i] = color;
+        }
+        _palette_manager_mark_dirty(0, PALETTE_MANAGER_COLORS);
+        palette_manager_commit();
+        dma_scheduler_flush();
+        SYS_doVBlankProcess();
+    }
+
+    if (frames == 0) {
+        palette_manager_set_colors(0, target, PALETTE_MANAGER_COLORS);
+    }
+}
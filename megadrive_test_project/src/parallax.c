@@ -0,0 +1,142 @@
+/**
+ * @file parallax.c
+ * @brief Implements the incrementally updated parallax scroll tables.
+ *
+ * Each plane keeps a 16.16 position per table entry and the value the VDP
+ * reads for it (the negated whole part). Positions are unsigned so that a band
+ * drifting for hours wraps instead of overflowing; the VDP only uses the low
+ * 10 bits anyway.
+ */
+#include "parallax.h"
+#include "dma_scheduler.h" // For uploading the tables at DMA_PRIORITY_SCROLL
+#include "vdp_cache.h"     // For switching the scroll mode during VBlank
+#include "hv_timer.h"      // For timing the table updates
+#include "error_handler.h" // For reporting invalid modes, planes and bands
+#include <string.h>        // For memset, memcpy, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_PARALLAX "parallax"
+
+/** @brief Entries in a line table; a tile-row table uses the first 28. */
+#define PARALLAX_MAX_ENTRIES 224
+
+typedef struct {
+    ParallaxBand bands[PARALLAX_MAX_BANDS];
+    u16 num_bands;
+    u8 dirty;                               // Table changed outside parallax_update(); upload it
+    u32 position[PARALLAX_MAX_ENTRIES];     // 16.16 pixels
+    s16 table[PARALLAX_MAX_ENTRIES];        // What the VDP reads: -(position >> 16)
+} ParallaxPlane;
+
+static ParallaxPlane planes[2]; // BG_A, BG_B, in the VDP's table order
+static u16 entries = 0;         // 224 (line mode), 28 (tile mode), 0 (inactive)
+static u16 table_step = 4;      // Bytes between a plane's entries in VRAM
+static s32 camera = 0;
+static ParallaxStats stats;
+
+// Index into `planes`, or -1 (reported) for anything but BG_A and BG_B.
+static s16 _parallax_slot(VDPPlane plane, const char* func, u16 line) {
+    if (plane == BG_A) return 0;
+    if (plane == BG_B) return 1;
+    error_handler_display_error(MODULE_NAME_PARALLAX, func, line, "Invalid plane!");
+    return -1;
+}
+
+void parallax_init(u16 mode) {
+    if (mode == HSCROLL_LINE) {
+        entries = PARALLAX_MAX_ENTRIES;
+        table_step = 4; // One BG_A/BG_B pair per line
+    } else if (mode == HSCROLL_TILE) {
+        entries = PARALLAX_MAX_ENTRIES / 8;
+        table_step = 32; // One pair per 8 lines; the VDP skips the other 7
+    } else {
+        error_handler_display_error(MODULE_NAME_PARALLAX, __func__, __LINE__, "Invalid scroll mode!");
+        return;
+    }
+    memset(planes, 0, sizeof(planes));
+    planes[0].dirty = TRUE;
+    planes[1].dirty = TRUE;
+    camera = 0;
+    memset(&stats, 0, sizeof(stats));
+    vdp_cache_set_hscroll_mode(mode);
+}
+
+void parallax_set_bands(VDPPlane plane, const ParallaxBand* bands, u16 count) {
+    s16 slot = _parallax_slot(plane, __func__, __LINE__);
+    if (slot < 0) return;
+    if (count > PARALLAX_MAX_BANDS) {
+        error_handler_display_error(MODULE_NAME_PARALLAX, __func__, __LINE__, "Too many bands!");
+        return;
+    }
+    for (u16 i = 0; i < count; i++) {
+        if (bands[i].first + bands[i].count > entries) {
+            error_handler_display_error(MODULE_NAME_PARALLAX, __func__, __LINE__, "Band out of table!");
+            return;
+        }
+    }
+
+    ParallaxPlane* target = &planes[slot];
+    memcpy(target->bands, bands, count * sizeof(ParallaxBand));
+    target->num_bands = count;
+    for (u16 i = 0; i < count; i++) {
+        memset(&target->position[bands[i].first], 0, bands[i].count * sizeof(u32));
+        memset(&target->table[bands[i].first], 0, bands[i].count * sizeof(s16));
+    }
+    target->dirty = TRUE;
+}
+
+void parallax_update(s32 camera_x) {
+    if (entries == 0) return;
+    u32 start = hv_timer_now();
+    s16 dx = (s16)(camera_x - camera); // Per-frame moves, far below 32768 pixels
+    camera = camera_x;
+
+    for (u16 p = 0; p < 2; p++) {
+        ParallaxPlane* plane = &planes[p];
+        u8 changed = plane->dirty;
+
+        for (u16 b = 0; b < plane->num_bands; b++) {
+            const ParallaxBand* band = &plane->bands[b];
+            // 8.8 speeds times whole pixels, moved to 16.16.
+            u32 delta = (u32)((s32)dx * band->speed + band->drift) << 8;
+            u32 ramp = (u32)((s32)dx * band->ramp) << 8;
+            if (delta == 0 && ramp == 0) continue;
+
+            u32* position = &plane->position[band->first];
+            s16* out = &plane->table[band->first];
+            for (u16 n = band->count; n; n--) {
+                *position += delta;
+                *out++ = -(s16)(*position++ >> 16);
+                delta += ramp;
+            }
+            changed = TRUE;
+        }
+
+        if (changed) {
+            dma_scheduler_queue_step(DMA_PRIORITY_SCROLL, DMA_VRAM, plane->table, VDP_getHScrollTableAddress() + p * 2,
+                                     entries, table_step);
+            plane->dirty = FALSE;
+            stats.uploads++;
+        }
+    }
+
+    stats.updates++;
+    stats.last_lines = hv_timer_now() - start;
+    if (stats.last_lines > stats.peak_lines) stats.peak_lines = stats.last_lines;
+}
+
+void parallax_end() {
+    entries = 0;
+    vdp_cache_set_hscroll_mode(HSCROLL_PLANE);
+}
+
+const ParallaxStats* parallax_get_stats() {
+    return &stats;
+}
+
+void parallax_dump_klog() {
+    char line_buf[80];
+    sprintf(line_buf, "PLX updates=%lu uploads=%lu last_lines=%u peak_lines=%u", stats.updates, stats.uploads,
+            stats.last_lines, stats.peak_lines);
+    KLog(line_buf);
+}
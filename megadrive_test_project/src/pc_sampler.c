@@ -0,0 +1,75 @@
+/**
+ * @file pc_sampler.c
+ * @brief Implements the statistical PC-sampling profiler.
+ *
+ * SGDK's V-int callback runs behind SGDK's own dispatcher, so the offset of
+ * the interrupted PC on the stack is not stable there. The H-int callback, on
+ * the other hand, is jumped to directly from the exception vector, so
+ * `pc_sampler_hint.s` can read the PC from a known place in the exception frame.
+ * Scheduling that interrupt on the last active line gives one sample per frame,
+ * taken at the same point VBlank would be.
+ */
+#include "pc_sampler.h"
+
+#if PC_SAMPLER_ENABLED
+
+#include <string.h> // For memset, sprintf
+
+/** @brief Raw H-int handler implemented in pc_sampler_hint.s. */
+extern void pc_sampler_hint_handler(void);
+
+static u16 histogram[PC_SAMPLER_BUCKET_COUNT]; // Samples per ROM bucket, saturating at 0xFFFF
+static u32 total_samples = 0;
+static u32 out_of_range_samples = 0;           // PC outside [0, PC_SAMPLER_ROM_SPAN), e.g. code in RAM
+static u16 frames_since_dump = 0;
+
+void pc_sampler_init() {
+    memset(histogram, 0, sizeof(histogram));
+    total_samples = 0;
+    out_of_range_samples = 0;
+    frames_since_dump = 0;
+
+    SYS_disableInts();
+    // The H-int counter fires after (value + 1) lines and is reloaded during VBlank.
+    VDP_setHIntCounter(PC_SAMPLER_LINES_PER_SAMPLE - 1);
+    SYS_setHIntCallback(pc_sampler_hint_handler);
+    VDP_setHInterrupt(TRUE);
+    SYS_enableInts();
+}
+
+void pc_sampler_record(u32 pc) {
+    total_samples++;
+    if (pc >= PC_SAMPLER_ROM_SPAN) {
+        out_of_range_samples++;
+        return;
+    }
+    u16* bucket = &histogram[pc >> PC_SAMPLER_BUCKET_SHIFT];
+    if (*bucket != 0xFFFF) (*bucket)++;
+}
+
+void pc_sampler_end_frame() {
+    frames_since_dump++;
+    if (frames_since_dump >= PC_SAMPLER_DUMP_INTERVAL) {
+        frames_since_dump = 0;
+        pc_sampler_dump_klog();
+    }
+}
+
+void pc_sampler_dump_klog() {
+    char line_buf[40];
+
+    // Format understood by tools/pc_symbolize.py:
+    //   PCS_BEGIN <bucket_shift> <total_samples> <out_of_range_samples>
+    //   PCS <bucket_start_address_hex> <count>
+    //   PCS_END
+    sprintf(line_buf, "PCS_BEGIN %u %lu %lu", PC_SAMPLER_BUCKET_SHIFT, total_samples, out_of_range_samples);
+    KLog(line_buf);
+    for (u16 i = 0; i < PC_SAMPLER_BUCKET_COUNT; i++) {
+        if (histogram[i] == 0) continue;
+        sprintf(line_buf, "PCS %06lX %u", (u32)i << PC_SAMPLER_BUCKET_SHIFT, histogram[i]);
+        KLog(line_buf);
+    }
+    KLog("PCS_END");
+}
+
+#endif // PC_SAMPLER_ENABLED
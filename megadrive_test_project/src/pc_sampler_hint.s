@@ -0,0 +1,22 @@
+| pc_sampler_hint.s
+| Raw H-interrupt handler for the PC-sampling profiler (see pc_sampler.c).
+|
+| SYS_setHIntCallback() makes the H-int vector jump straight here, so on entry
+| the stack holds the 68000 exception frame: SR (word) followed by the PC
+| (long) of the interrupted code. The handler saves the registers a C call may
+| clobber, passes that PC to pc_sampler_record() and returns with rte.
+| The file is assembled even when PC_SAMPLER_ENABLED is 0. pc_sampler_record
+| is then not compiled, so it is referenced weakly to keep the link clean; the
+| handler is never installed in that case.
+
+        .text
+        .globl  pc_sampler_hint_handler
+        .weak   pc_sampler_record
+
+pc_sampler_hint_handler:
+        movem.l %d0-%d1/%a0-%a1, -(%sp)     | 16 bytes of saved registers
+        move.l  18(%sp), -(%sp)              | Stacked PC: 16 saved bytes + 2 bytes of SR
+        jsr     pc_sampler_record
+        addq.l  #4, %sp
+        movem.l (%sp)+, %d0-%d1/%a0-%a1
+        rte
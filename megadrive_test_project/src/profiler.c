@@ -0,0 +1,149 @@
+/**
+ * @file profiler.c
+ * @brief Implements the frame-budget profiler.
+ *
+ * Each zone owns a ring buffer of the last `PROFILER_HISTORY_LENGTH` samples.
+ * Statistics are computed only when requested (overlay redraw or KLog dump),
+ * so the per-zone cost in the hot path is two `hv_timer_now()` calls and one
+ * array store.
+ */
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include "hv_timer.h"
+#include "input.h"        // For the overlay toggle button
+#include "error_handler.h" // For reporting invalid zone IDs
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_PROFILER "profiler"
+
+/** @brief Text row used by the overlay (row 0 is not used by any test screen). */
+#define PROFILER_OVERLAY_ROW 0
+/** @brief The overlay is redrawn every N frames to keep its own VDP cost low. */
+#define PROFILER_OVERLAY_INTERVAL 10
+
+typedef struct {
+    const char* name;
+    u32 start_time;                         // hv_timer_now() at zone begin
+    u16 history[PROFILER_HISTORY_LENGTH];   // Ring buffer of scanlines per sample
+    u16 head;                               // Next slot to write in history
+    u16 count;                              // Valid samples in history
+} ProfilerZone;
+
+static ProfilerZone zones[PROFILER_MAX_ZONES];
+static s16 last_zone_id = -1;     // Zone that ended most recently (shown by the overlay)
+static u8 overlay_visible = FALSE;
+static u16 overlay_timer = 0;
+
+void profiler_init() {
+    memset(zones, 0, sizeof(zones));
+    last_zone_id = -1;
+    overlay_visible = FALSE;
+    overlay_timer = 0;
+}
+
+void profiler_zone_begin(u16 zone_id, const char* name) {
+    if (zone_id >= PROFILER_MAX_ZONES) {
+        error_handler_display_error(MODULE_NAME_PROFILER, __func__, __LINE__, "Zone ID out of range!");
+        return;
+    }
+    zones[zone_id].name = name;
+    zones[zone_id].start_time = hv_timer_now();
+}
+
+void profiler_zone_end(u16 zone_id) {
+    u32 end_time = hv_timer_now();
+
+    if (zone_id >= PROFILER_MAX_ZONES) {
+        error_handler_display_error(MODULE_NAME_PROFILER, __func__, __LINE__, "Zone ID out of range!");
+        return;
+    }
+
+    ProfilerZone* zone = &zones[zone_id];
+    u32 elapsed = end_time - zone->start_time;
+    if (elapsed > 0xFFFF) elapsed = 0xFFFF; // e.g. the loading screen runs its own multi-second loop
+
+    zone->history[zone->head] = (u16)elapsed;
+    zone->head = (zone->head + 1) % PROFILER_HISTORY_LENGTH;
+    if (zone->count < PROFILER_HISTORY_LENGTH) zone->count++;
+    last_zone_id = zone_id;
+}
+
+u8 profiler_get_zone_stats(u16 zone_id, ProfilerZoneStats* stats) {
+    if (zone_id >= PROFILER_MAX_ZONES || zones[zone_id].count == 0) return FALSE;
+
+    const ProfilerZone* zone = &zones[zone_id];
+    u16 min_lines = 0xFFFF;
+    u16 max_lines = 0;
+    u32 total = 0;
+
+    for (u16 i = 0; i < zone->count; i++) {
+        u16 sample = zone->history[i];
+        if (sample < min_lines) min_lines = sample;
+        if (sample > max_lines) max_lines = sample;
+        total += sample;
+    }
+
+    stats->name = zone->name;
+    stats->min_lines = min_lines;
+    stats->max_lines = max_lines;
+    stats->avg_lines = (u16)(total / zone->count);
+    stats->last_lines = zone->history[(zone->head + PROFILER_HISTORY_LENGTH - 1) % PROFILER_HISTORY_LENGTH];
+    stats->sample_count = zone->count;
+    return TRUE;
+}
+
+// Formats "<name> min/avg/max" for one zone into buffer (at least 40 chars).
+static void _profiler_format_zone(const ProfilerZoneStats* stats, char* buffer) {
+    sprintf(buffer, "%-9s%4u/%4u/%4u ln", stats->name ? stats->name : "?",
+            stats->min_lines, stats->avg_lines, stats->max_lines);
+}
+
+// The overlay is drawn during active display from any state, including one
+// running raster effects, so its port writes are made with interrupts disabled
+// (see raster_fx.h).
+static void _profiler_draw_overlay() {
+    ProfilerZoneStats stats;
+    char line_buf[40];
+    u8 has_stats = (last_zone_id >= 0 && profiler_get_zone_stats(last_zone_id, &stats));
+
+    if (has_stats) _profiler_format_zone(&stats, line_buf);
+    SYS_disableInts();
+    VDP_clearText(0, PROFILER_OVERLAY_ROW, 40);
+    if (has_stats) VDP_drawText(line_buf, 0, PROFILER_OVERLAY_ROW);
+    SYS_enableInts();
+}
+
+void profiler_end_frame() {
+    if (input_is_just_pressed(PROFILER_OVERLAY_BUTTON)) {
+        overlay_visible = !overlay_visible;
+        overlay_timer = 0;
+        if (!overlay_visible) {
+            SYS_disableInts(); // As in _profiler_draw_overlay()
+            VDP_clearText(0, PROFILER_OVERLAY_ROW, 40);
+            SYS_enableInts();
+        }
+        profiler_dump_klog();
+    }
+
+    if (overlay_visible) {
+        if (overlay_timer == 0) _profiler_draw_overlay();
+        overlay_timer = (overlay_timer + 1) % PROFILER_OVERLAY_INTERVAL;
+    }
+}
+
+void profiler_dump_klog() {
+    ProfilerZoneStats stats;
+    char line_buf[48];
+
+    KLog("PROFILER: zone min/avg/max (scanlines)");
+    for (u16 i = 0; i < PROFILER_MAX_ZONES; i++) {
+        if (!profiler_get_zone_stats(i, &stats)) continue;
+        _profiler_format_zone(&stats, line_buf);
+        KLog(line_buf);
+    }
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,288 @@
+/**
+ * @file raster_fx.c
+ * @brief Compiles raster effect lists into the fire table walked by raster_fx_hint.s.
+ *
+ * The H-int counter (VDP register 10) is reloaded when it fires, with the
+ * value the register holds at that moment, and on every line of VBlank. A
+ * value written by a fire's handler therefore sets the interval between the
+ * next fire and the one after it. The table starts every frame with fires at
+ * the end of lines 0 and 1 (register 0 during VBlank), which gives the handler
+ * one fire of head start to set any later interval, and ends with a fire at
+ * the end of line 223 that restores the top of the frame and writes 0 for the
+ * next VBlank.
+ *
+ * That last fire's record sits at the head of each table: the fire before it
+ * ends the table and moves on to the next one, so a new table's first frame
+ * starts from its own line-0 state. The handler thus runs the head record of
+ * the next table at line 223, then the rest of that table from line 0 on.
+ *
+ * Table layout, in words, one record per fire:
+ *   0x8A00 | counter        H-int counter for the interval after the next fire
+ *   n, n register words     e.g. 0x8700 | backdrop
+ *   m, m runs of:           VDP write command (2 words), k, k data words
+ * and a 0 after the last record. Records start with 0x8Axx, so the handler
+ * tells the end of the table from another record by that 0.
+ *
+ * Three tables rotate: the one the handler reads, the one waiting for the end
+ * of the frame, and one to compile into, which is never either of the others.
+ */
+#include "raster_fx.h"
+#include "debug_config.h"  // For PC_SAMPLER_ENABLED
+#include "error_handler.h" // For reporting invalid lists
+#include "palette_manager.h" // For the line-0 colors
+#include "vdp_cache.h"     // For the line-0 vertical scroll
+#include <string.h>        // For memcpy, memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_RASTER_FX "raster_fx"
+
+/** @brief Words per table: 4 per fire, 4 per color or scroll, 19 per palette, 1 per backdrop. */
+#define RASTER_FX_TABLE_WORDS 640
+
+/** @brief Last active line; its fire ends the frame. */
+#define RASTER_FX_LAST_LINE 223
+
+// Handler cycles (68000 timings of raster_fx_hint.s; keep in sync with it).
+#define RASTER_FX_CYCLES_FIRE 340 // Interrupt entry (44), fixed code, rte
+#define RASTER_FX_CYCLES_NEXT 10  // Record followed by another
+#define RASTER_FX_CYCLES_END 48   // Last record: switches to the next table
+#define RASTER_FX_CYCLES_REG 22   // Per register word
+#define RASTER_FX_CYCLES_RUN 62   // Per run, besides its data words
+#define RASTER_FX_CYCLES_WORD 22  // Per data word
+
+/** @brief Raw H-int handler implemented in raster_fx_hint.s. */
+extern void raster_fx_hint_handler(void);
+
+// Shared with the handler.
+const u16* volatile raster_fx_cursor = NULL; // Next record to run
+const u16* volatile raster_fx_live = NULL;   // Table being run this frame
+const u16* volatile raster_fx_next = NULL;   // Table for the next frame
+volatile u32 raster_fx_fires = 0;            // Fires so far
+
+static u16 tables[3][RASTER_FX_TABLE_WORDS];
+static RasterFxEntry sorted[RASTER_FX_MAX_ENTRIES];
+static u16 num_sorted = 0;
+static u16 head_words = 0; // Size of the head record of the last table compiled
+static u8 running = FALSE;
+static RasterFxStats stats;
+
+static u16* out;       // Compile cursor
+static u16* out_end;
+
+static u8 _raster_fx_emit(u16 word) {
+    if (out >= out_end) return FALSE;
+    *out++ = word;
+    return TRUE;
+}
+
+// Appends a run of `count` words written to CRAM or VSRAM at `addr`.
+static u8 _raster_fx_emit_run(u8 vsram, u16 addr, const u16* data, u16 count) {
+    // Write commands: CD bits 0011 (CRAM) or 0101 (VSRAM); these addresses fit the first word.
+    u32 command = vsram ? (0x40000010 | ((u32)addr << 16)) : (0xC0000000 | ((u32)addr << 16));
+    if (!_raster_fx_emit(command >> 16) || !_raster_fx_emit(command & 0xFFFF) || !_raster_fx_emit(count)) return FALSE;
+    for (u16 i = 0; i < count; i++) {
+        if (!_raster_fx_emit(data[i])) return FALSE;
+    }
+    return TRUE;
+}
+
+// Appends the record for a fire running the entries for line `entry_line`, and
+// returns its cost in cycles (0 on overflow). `last` is the record ending the table.
+static u16 _raster_fx_emit_fire(u16 entry_line, u16 counter, u8 last) {
+    u16 regs = 0, runs = 0, words = 0;
+
+    if (!_raster_fx_emit(0x8A00 | counter)) return 0;
+    u16* count = out;
+    if (!_raster_fx_emit(0)) return 0;
+    for (u16 i = 0; i < num_sorted; i++) {
+        if (sorted[i].line != entry_line || sorted[i].action != RASTER_FX_BACKDROP) continue;
+        if (!_raster_fx_emit(0x8700 | (sorted[i].value & 63))) return 0;
+        regs++;
+    }
+    *count = regs;
+
+    count = out;
+    if (!_raster_fx_emit(0)) return 0;
+    for (u16 i = 0; i < num_sorted; i++) {
+        const RasterFxEntry* entry = &sorted[i];
+        if (entry->line != entry_line) continue;
+        u8 ok = TRUE;
+        switch (entry->action) {
+            case RASTER_FX_COLOR: ok = _raster_fx_emit_run(FALSE, entry->target * 2, &entry->value, 1); break;
+            case RASTER_FX_PALETTE: ok = _raster_fx_emit_run(FALSE, entry->target * 32, entry->data, 16); break;
+            case RASTER_FX_VSCROLL: ok = _raster_fx_emit_run(TRUE, (entry->target == BG_B) ? 2 : 0, &entry->value, 1); break;
+            default: continue; // Backdrop: a register word, above
+        }
+        if (!ok) return 0;
+        runs++;
+        words += (entry->action == RASTER_FX_PALETTE) ? 16 : 1;
+    }
+    *count = runs;
+
+    u16 cycles = RASTER_FX_CYCLES_FIRE + regs * RASTER_FX_CYCLES_REG + runs * RASTER_FX_CYCLES_RUN +
+                 words * RASTER_FX_CYCLES_WORD;
+    return cycles + (last ? RASTER_FX_CYCLES_END : RASTER_FX_CYCLES_NEXT);
+}
+
+// Sorted, unique fire lines: 0, 1, the line before each entry, and the last line.
+static u16 _raster_fx_fire_lines(u16* lines) {
+    u16 count = 0;
+    lines[count++] = 0;
+    lines[count++] = 1;
+    for (u16 i = 0; i < num_sorted; i++) {
+        u16 line = sorted[i].line;
+        if (line >= 3 && line - 1 != lines[count - 1]) lines[count++] = line - 1;
+    }
+    lines[count++] = RASTER_FX_LAST_LINE;
+    return count;
+}
+
+static u8 _raster_fx_compile(u16* table) {
+    u16 lines[RASTER_FX_MAX_ENTRIES + 3];
+    u16 num_lines = _raster_fx_fire_lines(lines);
+    RasterFxStats cost = { num_lines, 0, 0, stats.fired };
+
+    out = table;
+    out_end = table + RASTER_FX_TABLE_WORDS;
+    for (u16 n = 0; n < num_lines; n++) {
+        // Head first: the last fire (line 223), which restores the top of the
+        // frame and writes 0 for the reloads during VBlank. Then the fires from
+        // line 0 on, each running the next line's entries and writing the
+        // interval after the next fire: 0xFF (no fire before VBlank) past the end.
+        u16 k = (n == 0) ? num_lines - 1 : n - 1;
+        u16 counter = 0xFF;
+        if (k + 2 < num_lines) counter = lines[k + 2] - lines[k + 1] - 1;
+        else if (k + 1 == num_lines) counter = 0;
+
+        u16 entry_line = (lines[k] == RASTER_FX_LAST_LINE) ? 0 : lines[k] + 1;
+        u16 cycles = _raster_fx_emit_fire(entry_line, counter, n + 1 == num_lines);
+        if (cycles == 0) return FALSE;
+        if (cycles > cost.peak_cycles) cost.peak_cycles = cycles;
+        cost.frame_cycles += cycles;
+        if (n == 0) head_words = out - table;
+    }
+    if (!_raster_fx_emit(0)) return FALSE;
+
+    stats = cost;
+    return TRUE;
+}
+
+// Applies the line-0 entries outside the handler, during VBlank. Colors and
+// scroll go through the palette shadow and the scroll cache, so they hold the
+// top-of-frame values the handler restores every frame; the backdrop register
+// has no shadow and is written directly.
+static void _raster_fx_apply_top() {
+    for (u16 i = 0; i < num_sorted && sorted[i].line == 0; i++) {
+        const RasterFxEntry* entry = &sorted[i];
+        switch (entry->action) {
+            case RASTER_FX_COLOR: palette_manager_set_color(entry->target, entry->value); break;
+            case RASTER_FX_PALETTE: palette_manager_set_palette(entry->target, entry->data); break;
+            case RASTER_FX_BACKDROP: VDP_setBackgroundColor(entry->value); break;
+            case RASTER_FX_VSCROLL: vdp_cache_set_vscroll(entry->target, entry->value); break;
+            default: break;
+        }
+    }
+    palette_manager_commit_now(); // Still in VBlank: on screen from this frame
+}
+
+static u8 _raster_fx_check(const RasterFxEntry* entry) {
+    if (entry->line > RASTER_FX_LAST_LINE) return FALSE;
+    switch (entry->action) {
+        case RASTER_FX_COLOR: return entry->target < 64;
+        case RASTER_FX_PALETTE: return entry->target <= PAL3 && entry->data != NULL;
+        case RASTER_FX_BACKDROP: return entry->value < 64;
+        case RASTER_FX_VSCROLL: return entry->target == BG_A || entry->target == BG_B;
+        default: return FALSE;
+    }
+}
+
+u8 raster_fx_set(const RasterFxEntry* entries, u16 count) {
+    if (PC_SAMPLER_ENABLED) {
+        error_handler_display_error(MODULE_NAME_RASTER_FX, __func__, __LINE__, "H-int used by the PC sampler!");
+        return FALSE;
+    }
+    if (count > RASTER_FX_MAX_ENTRIES) {
+        error_handler_display_error(MODULE_NAME_RASTER_FX, __func__, __LINE__, "Too many entries!");
+        return FALSE;
+    }
+    for (u16 i = 0; i < count; i++) {
+        if (!_raster_fx_check(&entries[i])) {
+            error_handler_display_error(MODULE_NAME_RASTER_FX, __func__, __LINE__, "Invalid entry!");
+            return FALSE;
+        }
+    }
+
+    // Insertion sort by line; entries of a line keep their order.
+    for (u16 i = 0; i < count; i++) {
+        u16 j = i;
+        while (j > 0 && sorted[j - 1].line > entries[i].line) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = entries[i];
+    }
+    num_sorted = count;
+
+    // Compile into the table that is neither being run nor waiting. The handler
+    // only ever moves `next` into `live`, so neither can become this one.
+    const u16* live = raster_fx_live;
+    const u16* next = raster_fx_next;
+    u16* table = tables[0];
+    for (u16 i = 0; i < 3; i++) {
+        if (tables[i] != live && tables[i] != next) {
+            table = tables[i];
+            break;
+        }
+    }
+    if (!_raster_fx_compile(table)) {
+        error_handler_display_error(MODULE_NAME_RASTER_FX, __func__, __LINE__, "Table full!");
+        return FALSE;
+    }
+    raster_fx_next = table;
+
+    if (!running) {
+        // Start at the top of a frame: VBlank reloads the counter with 0, and
+        // the first fire (end of line 0) runs the record after the head, whose
+        // work (the line-0 entries) is done here.
+        VDP_waitVSync();
+        SYS_disableInts();
+        _raster_fx_apply_top();
+        raster_fx_live = table;
+        raster_fx_cursor = table + head_words;
+        VDP_setHIntCounter(0);
+        SYS_setHIntCallback(raster_fx_hint_handler);
+        VDP_setHInterrupt(TRUE);
+        SYS_enableInts();
+        running = TRUE;
+    }
+    return TRUE;
+}
+
+void raster_fx_stop() {
+    if (!running) return;
+    // Stop in VBlank, after the fire at line 223 restored the top of the
+    // frame, so the VDP holds the values the shadow and the cache are given.
+    VDP_waitVSync();
+    SYS_disableInts();
+    VDP_setHInterrupt(FALSE);
+    SYS_setHIntCallback(NULL);
+    _raster_fx_apply_top();
+    SYS_enableInts();
+    raster_fx_cursor = NULL;
+    raster_fx_live = NULL;
+    raster_fx_next = NULL;
+    running = FALSE;
+}
+
+const RasterFxStats* raster_fx_get_stats() {
+    stats.fired = raster_fx_fires;
+    return &stats;
+}
+
+void raster_fx_dump_klog() {
+    char line_buf[80];
+    raster_fx_get_stats();
+    sprintf(line_buf, "RFX fires=%u peak_cycles=%u frame_cycles=%lu fired=%lu", stats.fires, stats.peak_cycles,
+            stats.frame_cycles, stats.fired);
+    KLog(line_buf);
+}
@@ -0,0 +1,46 @@
+| raster_fx_hint.s
+| Raw H-interrupt handler for the raster effects (see raster_fx.c).
+|
+| SYS_setHIntCallback() makes the H-int vector jump straight here. Each fire
+| runs one record of the current table: it writes the H-int counter for the
+| interval after the next fire, the register words, then each run (a write
+| command and its data words), and leaves the cursor on the next record. A 0
+| after the record marks the end of the table: the cursor then moves to the
+| table raster_fx_set() left in raster_fx_next, whose head record is run by
+| the fire at the end of line 223.
+|
+| The cycle counts on the right are what raster_fx.c adds up per fire
+| (RASTER_FX_CYCLES_*); change them together. Interrupt entry is 44 more.
+
+        .text
+        .globl  raster_fx_hint_handler
+
+        .equ    VDP_DATA, 0xC00000
+        .equ    VDP_CTRL, 0xC00004
+
+raster_fx_hint_handler:
+        movem.l %d0-%d1/%a0-%a2, -(%sp)     | 48
+        move.l  raster_fx_cursor, %a0        | 20
+        lea     VDP_CTRL, %a1                | 12
+        lea     VDP_DATA, %a2                | 12
+        move.w  (%a0)+, (%a1)                | 12  H-int counter (register 10)
+        move.w  (%a0)+, %d0                  | 8   Register words
+        bra.s   2f                           | 10
+1:      move.w  (%a0)+, (%a1)                | 12  } 22 per register word
+2:      dbra    %d0, 1b                      | 10  } (14 when done)
+        move.w  (%a0)+, %d0                  | 8   Runs
+        bra.s   5f                           | 10
+3:      move.l  (%a0)+, (%a1)                | 20  } 62 per run:
+        move.w  (%a0)+, %d1                  | 8   } command, count,
+        bra.s   4f                           | 10  } inner dbra done (14),
+6:      move.w  (%a0)+, (%a2)                | 12  } outer dbra (10)
+4:      dbra    %d1, 6b                      | 10  22 per data word
+5:      dbra    %d0, 3b                      | 14 when done
+        tst.w   (%a0)                        | 8
+        bne.s   7f                           | 10 to the next record, 8 at the end of the table
+        move.l  raster_fx_next, %a0          | 20  } 48 at the end, with the bne
+        move.l  %a0, raster_fx_live          | 20  }
+7:      move.l  %a0, raster_fx_cursor        | 20
+        addq.l  #1, raster_fx_fires          | 28
+        movem.l (%sp)+, %d0-%d1/%a0-%a2      | 52
+        rte                                  | 20
@@ -0,0 +1,265 @@
+/**
+ * @file scroll_engine.c
+ * @brief Implements the edge-streaming scroll engine.
+ *
+ * The engine remembers the tile rectangle [left, right] x [top, bottom] that
+ * the plane currently holds (the tiles under the screen). A camera move turns
+ * into the columns and rows of the new rectangle that were not in the old one.
+ * Each is decoded into its own buffer from a small ring and queued; the ring
+ * holds two frames' worth of edges, and scroll transfers normally leave with
+ * the flush of the frame that queued them. When they back up further, a
+ * buffer the update would reuse may still be queued; the update then reloads
+ * the view instead, which drops the backlog.
+ *
+ * A reload decodes the view into a buffer laid out like the plane rows it
+ * covers, queued as one transfer (two where it wraps past the plane's bottom)
+ * at the same priority. Edges still pending for the old view are dropped
+ * first, so they cannot land on top of it.
+ */
+#include "scroll_engine.h"
+#include "dma_scheduler.h" // For queueing the edges at DMA_PRIORITY_SCROLL
+#include "vdp_cache.h"     // For the scroll values written during VBlank
+#include "hv_timer.h"      // For timing each update
+#include "tilemap_blit.h"  // For the plane address
+#include "error_handler.h" // For reporting an unusable plane
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_SCROLL_ENGINE "scroll_engine"
+
+/** @brief Tiles that can be visible at once, counting partly visible ones. */
+#define SCROLL_ENGINE_VIEW_COLS (SCROLL_ENGINE_SCREEN_W / 8 + 1)
+#define SCROLL_ENGINE_VIEW_ROWS (SCROLL_ENGINE_SCREEN_H / 8 + 1)
+
+/** @brief Edge buffers: up to SCROLL_ENGINE_MAX_EDGES columns and rows per frame, for two frames. */
+#define SCROLL_ENGINE_EDGE_BUFFERS (SCROLL_ENGINE_MAX_EDGES * 2 * 2)
+
+static u16 edge_buffers[SCROLL_ENGINE_EDGE_BUFFERS][SCROLL_ENGINE_VIEW_COLS];
+static u16 reload_buffer[SCROLL_ENGINE_VIEW_ROWS * SCROLL_ENGINE_PLANE_WIDTH]; // Whole plane rows
+static u16 next_buffer = 0;
+
+static const MetatileMap* map = NULL;
+static VDPPlane plane = BG_A;
+static u16 plane_addr = VDP_BG_A;
+static u16 plane_width = 64;
+static u16 plane_height = 32;
+static u16 base_index = 0;
+
+static s32 cam_x = 0;
+static s32 cam_y = 0;
+static s32 max_x = 0;
+static s32 max_y = 0;
+static u16 left, right, top, bottom; // Tiles the plane holds, inclusive
+static ScrollEngineStats stats;
+
+static u16* _scroll_engine_next_buffer() {
+    u16* buffer = edge_buffers[next_buffer];
+    if (++next_buffer >= SCROLL_ENGINE_EDGE_BUFFERS) next_buffer = 0;
+    return buffer;
+}
+
+// TRUE if the next `count` edge buffers are no longer read by a pending transfer.
+static u8 _scroll_engine_buffers_free(u16 count) {
+    for (u16 i = 0, b = next_buffer; i < count; i++) {
+        if (dma_scheduler_is_pending(DMA_PRIORITY_SCROLL, edge_buffers[b], sizeof(edge_buffers[b]))) return FALSE;
+        if (++b >= SCROLL_ENGINE_EDGE_BUFFERS) b = 0;
+    }
+    return TRUE;
+}
+
+// Number of tiles in [from, to], 0 if empty.
+static u16 _scroll_engine_span(u16 from, u16 to) {
+    return (from <= to) ? to - from + 1 : 0;
+}
+
+// Visible tile rectangle for the current camera.
+static void _scroll_engine_view(u16* l, u16* r, u16* t, u16* b) {
+    u16 last_col = METATILE_MAP_TILE_W(map) - 1;
+    u16 last_row = METATILE_MAP_TILE_H(map) - 1;
+
+    *l = cam_x >> 3;
+    *r = (cam_x + SCROLL_ENGINE_SCREEN_W - 1) >> 3;
+    *t = cam_y >> 3;
+    *b = (cam_y + SCROLL_ENGINE_SCREEN_H - 1) >> 3;
+    if (*r > last_col) *r = last_col; // Map narrower than the screen
+    if (*b > last_row) *b = last_row;
+}
+
+// Queues map column `x`, rows top..bottom, as one or two stepped transfers (two where it wraps).
+static void _scroll_engine_stream_column(u16 x) {
+    u16 count = bottom - top + 1;
+    u16* buffer = _scroll_engine_next_buffer();
+    u16 px = x & (plane_width - 1);
+    u16 py = top & (plane_height - 1);
+    u16 first = plane_height - py;
+    if (first > count) first = count;
+
+    metatile_decode_column(map, x, top, count, buffer, base_index);
+    dma_scheduler_queue_step(DMA_PRIORITY_SCROLL, DMA_VRAM, buffer, plane_addr + (py * plane_width + px) * 2, first,
+                             plane_width * 2);
+    if (first < count) {
+        dma_scheduler_queue_step(DMA_PRIORITY_SCROLL, DMA_VRAM, &buffer[first], plane_addr + px * 2, count - first,
+                                 plane_width * 2);
+    }
+    stats.columns++;
+}
+
+// Queues map row `y`, columns left..right, as one or two transfers (two where it wraps).
+static void _scroll_engine_stream_row(u16 y) {
+    u16 count = right - left + 1;
+    u16* buffer = _scroll_engine_next_buffer();
+    u16 px = left & (plane_width - 1);
+    u16 row_addr = plane_addr + (y & (plane_height - 1)) * plane_width * 2;
+    u16 first = plane_width - px;
+    if (first > count) first = count;
+
+    metatile_decode_row(map, left, y, count, buffer, base_index);
+    dma_scheduler_queue(DMA_PRIORITY_SCROLL, DMA_VRAM, buffer, row_addr + px * 2, first);
+    if (first < count) dma_scheduler_queue(DMA_PRIORITY_SCROLL, DMA_VRAM, &buffer[first], row_addr, count - first);
+    stats.rows++;
+}
+
+static void _scroll_engine_reload() {
+    dma_scheduler_cancel(DMA_PRIORITY_SCROLL, edge_buffers, sizeof(edge_buffers));
+    dma_scheduler_cancel(DMA_PRIORITY_SCROLL, reload_buffer, sizeof(reload_buffer));
+    _scroll_engine_view(&left, &right, &top, &bottom);
+
+    // Buffer row j is plane row (top + j); the cells outside the view are not
+    // shown, and are streamed before they come into view.
+    u16 count = right - left + 1;
+    u16 rows = bottom - top + 1;
+    u16 px = left & (SCROLL_ENGINE_PLANE_WIDTH - 1);
+    u16 first = SCROLL_ENGINE_PLANE_WIDTH - px;
+    if (first > count) first = count;
+    for (u16 j = 0; j < rows; j++) {
+        u16* row = &reload_buffer[j * SCROLL_ENGINE_PLANE_WIDTH];
+        metatile_decode_row(map, left, top + j, first, &row[px], base_index);
+        if (first < count) metatile_decode_row(map, left + first, top + j, count - first, row, base_index);
+    }
+
+    u16 py = top & (plane_height - 1);
+    u16 first_rows = plane_height - py;
+    if (first_rows > rows) first_rows = rows;
+    dma_scheduler_queue(DMA_PRIORITY_SCROLL, DMA_VRAM, reload_buffer, plane_addr + py * SCROLL_ENGINE_PLANE_WIDTH * 2,
+                        first_rows * SCROLL_ENGINE_PLANE_WIDTH);
+    if (first_rows < rows) {
+        dma_scheduler_queue(DMA_PRIORITY_SCROLL, DMA_VRAM, &reload_buffer[first_rows * SCROLL_ENGINE_PLANE_WIDTH],
+                            plane_addr, (rows - first_rows) * SCROLL_ENGINE_PLANE_WIDTH);
+    }
+    stats.reloads++;
+}
+
+// The plane wraps every 512 pixels or less, so the low 16 bits of the camera
+// position are all the VDP needs.
+static void _scroll_engine_set_scroll() {
+    vdp_cache_set_hscroll(plane, (s16)-cam_x);
+    vdp_cache_set_vscroll(plane, (s16)cam_y);
+}
+
+static s32 _scroll_engine_clamp(s32 value, s32 max) {
+    if (value < 0) return 0;
+    return (value > max) ? max : value;
+}
+
+void scroll_engine_init(VDPPlane target, const MetatileMap* source, u16 base, s32 x, s32 y) {
+    plane_addr = tilemap_blit_plane_address(target);
+    if (plane_addr == 0) return;
+    plane_width = VDP_getPlaneWidth();
+    plane_height = VDP_getPlaneHeight();
+    if (plane_width != SCROLL_ENGINE_PLANE_WIDTH || plane_height < SCROLL_ENGINE_VIEW_ROWS) {
+        error_handler_display_error(MODULE_NAME_SCROLL_ENGINE, __func__, __LINE__, "Plane must be 64x32 or 64x64!");
+        return;
+    }
+    if ((u32)METATILE_MAP_TILE_W(source) > SCROLL_ENGINE_MAX_MAP_TILES ||
+        (u32)METATILE_MAP_TILE_H(source) > SCROLL_ENGINE_MAX_MAP_TILES) {
+        error_handler_display_error(MODULE_NAME_SCROLL_ENGINE, __func__, __LINE__, "Map too large!");
+        return;
+    }
+
+    plane = target;
+    map = source;
+    base_index = base;
+    next_buffer = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    max_x = (s32)METATILE_MAP_TILE_W(map) * 8 - SCROLL_ENGINE_SCREEN_W;
+    max_y = (s32)METATILE_MAP_TILE_H(map) * 8 - SCROLL_ENGINE_SCREEN_H;
+    if (max_x < 0) max_x = 0;
+    if (max_y < 0) max_y = 0;
+    cam_x = _scroll_engine_clamp(x, max_x);
+    cam_y = _scroll_engine_clamp(y, max_y);
+
+    _scroll_engine_reload();
+    _scroll_engine_set_scroll();
+}
+
+void scroll_engine_set_camera(s32 x, s32 y) {
+    if (map == NULL) return;
+    u32 start = hv_timer_now();
+    u16 old_left = left, old_right = right, old_top = top, old_bottom = bottom;
+
+    cam_x = _scroll_engine_clamp(x, max_x);
+    cam_y = _scroll_engine_clamp(y, max_y);
+    _scroll_engine_view(&left, &right, &top, &bottom);
+
+    u8 jump = left > old_left + SCROLL_ENGINE_MAX_EDGES || left + SCROLL_ENGINE_MAX_EDGES < old_left ||
+              top > old_top + SCROLL_ENGINE_MAX_EDGES || top + SCROLL_ENGINE_MAX_EDGES < old_top;
+    if (!jump) {
+        // Same bounds as the loops below.
+        u16 edges = _scroll_engine_span((old_right + 1 > left) ? old_right + 1 : left, right) +
+                    _scroll_engine_span((old_bottom + 1 > top) ? old_bottom + 1 : top, bottom);
+        if (left < old_left) edges += _scroll_engine_span(left, (old_left - 1 < right) ? old_left - 1 : right);
+        if (top < old_top) edges += _scroll_engine_span(top, (old_top - 1 < bottom) ? old_top - 1 : bottom);
+        if (!_scroll_engine_buffers_free(edges)) {
+            stats.overruns++;
+            jump = TRUE;
+        }
+    }
+
+    if (jump) {
+        _scroll_engine_reload();
+    } else {
+        // Columns cover the new rows, rows the new columns, so a diagonal move
+        // fills its corner too (twice, which is harmless).
+        for (u16 col = (old_right + 1 > left) ? old_right + 1 : left; col <= right; col++) {
+            _scroll_engine_stream_column(col);
+        }
+        for (u16 col = left; col < old_left && col <= right; col++) _scroll_engine_stream_column(col);
+        for (u16 row = (old_bottom + 1 > top) ? old_bottom + 1 : top; row <= bottom; row++) {
+            _scroll_engine_stream_row(row);
+        }
+        for (u16 row = top; row < old_top && row <= bottom; row++) _scroll_engine_stream_row(row);
+    }
+
+    _scroll_engine_set_scroll();
+
+    stats.last_lines = hv_timer_now() - start;
+    if (stats.last_lines > stats.peak_lines) stats.peak_lines = stats.last_lines;
+}
+
+s32 scroll_engine_get_x() {
+    return cam_x;
+}
+
+s32 scroll_engine_get_y() {
+    return cam_y;
+}
+
+s32 scroll_engine_get_max_x() {
+    return max_x;
+}
+
+s32 scroll_engine_get_max_y() {
+    return max_y;
+}
+
+const ScrollEngineStats* scroll_engine_get_stats() {
+    return &stats;
+}
+
+void scroll_engine_dump_klog() {
+    char line_buf[100];
+    sprintf(line_buf, "SCRL columns=%lu rows=%lu reloads=%lu overruns=%u last_lines=%u peak_lines=%u", stats.columns,
+            stats.rows, stats.reloads, stats.overruns, stats.last_lines, stats.peak_lines);
+    KLog(line_buf);
+}
@@ -0,0 +1,273 @@
+/**
+ * @file soak.c
+ * @brief Implements the long-running soak test.
+ *
+ * The menu navigation works like the benchmark driver's (bench.c): a small
+ * state machine advanced once per frame by `soak_frame_end()`, which only
+ * reaches the tests through the menu and the controller path.
+ */
+#include "soak.h"
+
+#if SOAK_ENABLED
+
+#include "input.h"
+#include "menu.h"          // For MAX_MENU_ITEMS
+#include "hv_timer.h"
+#include "error_handler.h" // For reporting an invalid state
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_SOAK "soak"
+
+typedef enum {
+    SOAK_PHASE_SETTLE,      // Idle in the menu
+    SOAK_PHASE_NAVIGATE,    // Press Down until the entry is selected, then Start
+    SOAK_PHASE_WAIT_ENTER,  // Wait for the test state to start
+    SOAK_PHASE_RUN,         // Run the test without input
+    SOAK_PHASE_EXIT,        // Press Start until back in the menu
+    SOAK_PHASE_DONE
+} SoakPhase;
+
+/** @brief Values checked per state at the end of every cycle. */
+typedef enum {
+    SOAK_METRIC_FRAME_LINES,   // Average scanlines per frame while in the state
+    SOAK_METRIC_HEAP_LOST,     // Free heap lost over all visits so far (MEM_getFree() before entering minus after exiting)
+    SOAK_METRIC_SPR_ACTIVE,    // SPR_getNumActiveSprite() on the visit's last frame
+    SOAK_METRIC_SPR_HW,        // SPR_getUsedVDPSprite() on the visit's last frame
+    SOAK_METRIC_SPR_VRAM_FREE, // SPR_getFreeVRAM() on the visit's last frame
+    SOAK_METRIC_COUNT
+} SoakMetric;
+
+static const char* const metric_names[SOAK_METRIC_COUNT] = {
+    "frame_lines", "heap_lost", "spr_active", "spr_hw", "spr_vram_free"
+};
+// Free VRAM is worse when it shrinks; everything else is worse when it grows.
+static const u8 metric_lower_is_worse[SOAK_METRIC_COUNT] = { FALSE, FALSE, FALSE, FALSE, TRUE };
+
+/** @brief Baseline and trend of one metric. */
+typedef struct {
+    s32 baseline;
+    s32 last;
+    u16 streak;   // Cycles since the value last improved
+    u8 flagged;   // Reported already (each metric is reported once)
+} SoakTrend;
+
+/** @brief Everything recorded for one state during the current cycle. */
+typedef struct {
+    u32 lines;                        // Scanlines summed over the state's frames
+    u16 frames;
+    s32 values[SOAK_METRIC_COUNT];    // Sampled values (frame time is computed at the end of the cycle)
+    u8 has_heap;                      // The state was visited and exited at least once
+    u8 has_sprites;                   // The sprite engine was running on the visit's last frame
+    SoakTrend trends[SOAK_METRIC_COUNT];
+} SoakState;
+
+static SoakState states[SOAK_MAX_STATES];
+static const char* const* names = NULL;
+static u16 state_count = 0;
+
+static SoakPhase phase;
+static u16 menu_index;        // Menu entry being visited
+static u16 phase_frame;       // Frames spent in the current phase
+static u16 next_buttons;      // Returned by the input provider on the next input_update()
+static u16 run_state;         // State of the test being visited
+static u16 cycle;             // Completed cycles
+static u16 flag_count;
+
+static u32 frame_start_lines;
+static u16 heap_before_visit;  // MEM_getFree() in the menu right before navigating to the test
+static u16 start_plane_width;
+static u16 start_plane_height;
+static u8 plane_flagged;
+
+static u16 _soak_input_provider(void) {
+    return next_buttons;
+}
+
+static void _soak_set_phase(SoakPhase new_phase) {
+    phase = new_phase;
+    phase_frame = 0;
+}
+
+static void _soak_flag(const char* metric, u16 state, s32 baseline, s32 now) {
+    char line_buf[96];
+    sprintf(line_buf, "SOAK_FLAG cycle=%u metric=%s state=%s baseline=%ld now=%ld", cycle, metric, names[state],
+            baseline, now);
+    KLog(line_buf);
+    flag_count++;
+}
+
+// Updates one trend with this cycle's value and flags it once it stays worse than the baseline.
+static void _soak_check(SoakTrend* trend, SoakMetric metric, u16 state, s32 value, s32 tolerance) {
+    if (cycle <= SOAK_WARMUP_CYCLES) {
+        trend->baseline = value;
+        trend->last = value;
+        trend->streak = 0;
+        return;
+    }
+
+    s32 change = metric_lower_is_worse[metric] ? trend->last - value : value - trend->last; // > 0: worse
+    trend->streak = (change < 0) ? 0 : trend->streak + 1;
+    trend->last = value;
+
+    s32 drift = metric_lower_is_worse[metric] ? trend->baseline - value : value - trend->baseline;
+    if (!trend->flagged && trend->streak >= SOAK_TREND_CYCLES && drift > tolerance) {
+        trend->flagged = TRUE;
+        _soak_flag(metric_names[metric], state, trend->baseline, value);
+    }
+}
+
+// Called back in the menu after a visit: every test must leave the plane size as it found it.
+static void _soak_check_plane(u16 state) {
+    if (plane_flagged) return;
+    if (VDP_getPlaneWidth() != start_plane_width || VDP_getPlaneHeight() != start_plane_height) {
+        plane_flagged = TRUE;
+        _soak_flag("plane_size", state, (s32)start_plane_width * start_plane_height,
+                   (s32)VDP_getPlaneWidth() * VDP_getPlaneHeight());
+    }
+}
+
+static void _soak_end_cycle() {
+    char line_buf[64];
+
+    cycle++;
+    for (u16 i = 0; i < state_count; i++) {
+        SoakState* soak_state = &states[i];
+        if (soak_state->frames != 0) {
+            s32 avg_lines = soak_state->lines / soak_state->frames;
+            // Allow for measurement noise: two lines plus 1/16 of the baseline.
+            s32 tolerance = 2 + (soak_state->trends[SOAK_METRIC_FRAME_LINES].baseline >> 4);
+            _soak_check(&soak_state->trends[SOAK_METRIC_FRAME_LINES], SOAK_METRIC_FRAME_LINES, i, avg_lines, tolerance);
+        }
+        if (soak_state->has_heap) {
+            _soak_check(&soak_state->trends[SOAK_METRIC_HEAP_LOST], SOAK_METRIC_HEAP_LOST, i,
+                        soak_state->values[SOAK_METRIC_HEAP_LOST], 0);
+        }
+        if (soak_state->has_sprites) {
+            for (u16 m = SOAK_METRIC_SPR_ACTIVE; m <= SOAK_METRIC_SPR_VRAM_FREE; m++) {
+                _soak_check(&soak_state->trends[m], m, i, soak_state->values[m], 0);
+            }
+        }
+        soak_state->lines = 0;
+        soak_state->frames = 0;
+        soak_state->has_sprites = FALSE; // The heap loss is a running total and is kept
+    }
+
+    sprintf(line_buf, "SOAK cycle=%u heap_free=%u flags=%u", cycle, MEM_getFree(), flag_count);
+    KLog(line_buf);
+
+    if (cycle >= SOAK_CYCLES) {
+        sprintf(line_buf, "SOAK_END cycles=%u flags=%u", cycle, flag_count);
+        KLog(line_buf);
+        _soak_set_phase(SOAK_PHASE_DONE);
+    }
+}
+
+void soak_init(const char* const* state_names, u16 count) {
+    char line_buf[64];
+
+    if (count > SOAK_MAX_STATES) {
+        error_handler_display_error(MODULE_NAME_SOAK, __func__, __LINE__, "Too many states!");
+        return;
+    }
+    names = state_names;
+    state_count = count;
+    memset(states, 0, sizeof(states));
+
+    menu_index = 0;
+    next_buttons = 0;
+    cycle = 0;
+    flag_count = 0;
+    start_plane_width = VDP_getPlaneWidth();
+    start_plane_height = VDP_getPlaneHeight();
+    plane_flagged = FALSE;
+    _soak_set_phase(SOAK_PHASE_SETTLE);
+    input_set_provider(_soak_input_provider);
+
+    sprintf(line_buf, "SOAK_BEGIN cycles=%u tests=%u heap_free=%u", (u16)SOAK_CYCLES, (u16)MAX_MENU_ITEMS,
+            MEM_getFree());
+    KLog(line_buf);
+}
+
+void soak_frame_begin() {
+    frame_start_lines = hv_timer_now();
+}
+
+void soak_frame_end(u16 state, u8 in_menu) {
+    u16 buttons = 0;
+
+    if (state >= state_count) {
+        error_handler_display_error(MODULE_NAME_SOAK, __func__, __LINE__, "State out of range!");
+        return;
+    }
+    if (phase != SOAK_PHASE_DONE) {
+        states[state].lines += hv_timer_now() - frame_start_lines;
+        states[state].frames++;
+    }
+
+    phase_frame++;
+
+    switch (phase) {
+        case SOAK_PHASE_SETTLE:
+            if (phase_frame >= SOAK_SETTLE_FRAMES) {
+                heap_before_visit = MEM_getFree();
+                _soak_set_phase(SOAK_PHASE_NAVIGATE);
+            }
+            break;
+
+        case SOAK_PHASE_NAVIGATE:
+            // menu_init() selects entry 0; press Down once per two frames (press, release),
+            // then Start. Edge detection in menu.c needs the release frame in between.
+            if (phase_frame <= menu_index * 2) {
+                buttons = (phase_frame % 2) ? BUTTON_DOWN : 0;
+            } else {
+                buttons = BUTTON_START;
+                _soak_set_phase(SOAK_PHASE_WAIT_ENTER);
+            }
+            break;
+
+        case SOAK_PHASE_WAIT_ENTER:
+            if (!in_menu) _soak_set_phase(SOAK_PHASE_RUN);
+            break;
+
+        case SOAK_PHASE_RUN:
+            run_state = state;
+            if (phase_frame >= SOAK_FRAMES_PER_TEST) {
+                // Sample the sprite engine before return_to_menu() shuts it down.
+                if (SPR_isInitialized()) {
+                    states[state].values[SOAK_METRIC_SPR_ACTIVE] = SPR_getNumActiveSprite();
+                    states[state].values[SOAK_METRIC_SPR_HW] = SPR_getUsedVDPSprite();
+                    states[state].values[SOAK_METRIC_SPR_VRAM_FREE] = SPR_getFreeVRAM();
+                    states[state].has_sprites = TRUE;
+                }
+                _soak_set_phase(SOAK_PHASE_EXIT);
+            }
+            break;
+
+        case SOAK_PHASE_EXIT:
+            if (in_menu) {
+                // A visit that frees memory it did not allocate lowers the total; that is fine.
+                states[run_state].values[SOAK_METRIC_HEAP_LOST] += (s32)heap_before_visit - MEM_getFree();
+                states[run_state].has_heap = TRUE;
+                _soak_check_plane(run_state);
+
+                _soak_set_phase(SOAK_PHASE_SETTLE);
+                if (++menu_index >= MAX_MENU_ITEMS) {
+                    menu_index = 0;
+                    _soak_end_cycle();
+                }
+            } else {
+                // Alternate press/release so a missed press is retried.
+                buttons = (phase_frame % 2) ? BUTTON_START : 0;
+            }
+            break;
+
+        case SOAK_PHASE_DONE:
+        default:
+            break;
+    }
+
+    next_buttons = buttons;
+}
+
+#endif // SOAK_ENABLED
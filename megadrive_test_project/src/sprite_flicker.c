@@ -0,0 +1,146 @@
+/**
+ * @file sprite_flicker.c
+ * @brief Implements the per-band sprite counting and the rotating drop order.
+ */
+#include "sprite_flicker.h"
+#include "error_handler.h" // For reporting a full table
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_SPRITE_FLICKER "sprite_flicker"
+
+#define SPRITE_FLICKER_BANDS (224 / SPRITE_FLICKER_BAND_LINES)
+#define SPRITE_FLICKER_TOTAL_LIMIT 80 // Hardware sprites in H40
+#define SPRITE_FLICKER_OFF_SCREEN 0xFF
+
+static Sprite* sprites[SPRITE_FLICKER_MAX];
+static u8 first_band[SPRITE_FLICKER_MAX];  // SPRITE_FLICKER_OFF_SCREEN if not on screen
+static u8 last_band[SPRITE_FLICKER_MAX];
+static u8 hw_count[SPRITE_FLICKER_MAX];    // Hardware sprites per line it covers
+static u8 shown[SPRITE_FLICKER_MAX];       // Visibility last set, to skip repeated calls
+static u16 count = 0;
+static u16 start = 0;                       // Where the next keep/drop walk begins
+static u8 enabled = TRUE;
+
+static u16 demand[SPRITE_FLICKER_BANDS];    // Hardware sprites asked for, per band
+static u8 used[SPRITE_FLICKER_BANDS];       // Hardware sprites kept, per band
+static SpriteFlickerStats stats;
+
+static void _sprite_flicker_show(u16 i, u8 visible) {
+    if (shown[i] == visible) return;
+    shown[i] = visible;
+    SPR_setVisibility(sprites[i], visible ? VISIBLE : HIDDEN);
+}
+
+void sprite_flicker_init() {
+    count = 0;
+    start = 0;
+    enabled = TRUE;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void sprite_flicker_add(Sprite* sprite) {
+    if (count >= SPRITE_FLICKER_MAX) {
+        error_handler_display_error(MODULE_NAME_SPRITE_FLICKER, __func__, __LINE__, "Too many sprites!");
+        return;
+    }
+    sprites[count] = sprite;
+    shown[count] = 0xFF; // Unknown: set on the next update
+    count++;
+}
+
+void sprite_flicker_remove(Sprite* sprite) {
+    for (u16 i = 0; i < count; i++) {
+        if (sprites[i] != sprite) continue;
+        count--;
+        sprites[i] = sprites[count];
+        shown[i] = shown[count];
+        if (start >= count) start = 0;
+        return;
+    }
+}
+
+void sprite_flicker_set_enabled(u8 value) {
+    enabled = value;
+}
+
+void sprite_flicker_update() {
+    u16 total = 0;
+    u16 over = 0;
+    stats.frames++;
+
+    // Pass 1: what each sprite covers, and the demand per band.
+    memset(demand, 0, sizeof(demand));
+    for (u16 i = 0; i < count; i++) {
+        const Sprite* sprite = sprites[i];
+        s16 x = SPR_getPositionX(sprite);
+        s16 y = SPR_getPositionY(sprite);
+        const AnimationFrame* frame = sprite->frame;
+        if (frame == NULL || x >= 320 || y >= 224 || x + frame->w <= 0 || y + frame->h <= 0) {
+            first_band[i] = SPRITE_FLICKER_OFF_SCREEN;
+            continue;
+        }
+        s16 top = (y < 0) ? 0 : y;
+        s16 bottom = y + frame->h - 1;
+        if (bottom > 223) bottom = 223;
+        first_band[i] = top / SPRITE_FLICKER_BAND_LINES;
+        last_band[i] = bottom / SPRITE_FLICKER_BAND_LINES;
+        hw_count[i] = (frame->w + 31) >> 5;
+        for (u16 b = first_band[i]; b <= last_band[i]; b++) demand[b] += hw_count[i];
+        total += hw_count[i];
+    }
+    for (u16 b = 0; b < SPRITE_FLICKER_BANDS; b++) {
+        if (demand[b] > SPRITE_FLICKER_LINE_LIMIT) over++;
+        if (demand[b] > stats.peak_band) stats.peak_band = demand[b];
+    }
+    stats.last_bands = over;
+    stats.last_hidden = 0;
+
+    if (over == 0 && total <= SPRITE_FLICKER_TOTAL_LIMIT) {
+        for (u16 i = 0; i < count; i++) _sprite_flicker_show(i, first_band[i] != SPRITE_FLICKER_OFF_SCREEN);
+        return;
+    }
+    stats.overflow_frames++;
+    if (!enabled) {
+        for (u16 i = 0; i < count; i++) _sprite_flicker_show(i, first_band[i] != SPRITE_FLICKER_OFF_SCREEN);
+        return;
+    }
+
+    // Pass 2: keep sprites in rotated order while their bands have room.
+    u16 kept_total = 0;
+    u16 first_dropped = SPRITE_FLICKER_MAX;
+    memset(used, 0, sizeof(used));
+    for (u16 n = 0, i = start; n < count; n++, i++) {
+        if (i >= count) i = 0;
+        if (first_band[i] == SPRITE_FLICKER_OFF_SCREEN) {
+            _sprite_flicker_show(i, FALSE);
+            continue;
+        }
+        u8 fits = (kept_total + hw_count[i] <= SPRITE_FLICKER_TOTAL_LIMIT);
+        for (u16 b = first_band[i]; fits && b <= last_band[i]; b++) {
+            if (used[b] + hw_count[i] > SPRITE_FLICKER_LINE_LIMIT) fits = FALSE;
+        }
+        if (fits) {
+            for (u16 b = first_band[i]; b <= last_band[i]; b++) used[b] += hw_count[i];
+            kept_total += hw_count[i];
+        } else {
+            stats.last_hidden++;
+            if (first_dropped == SPRITE_FLICKER_MAX) first_dropped = i;
+        }
+        _sprite_flicker_show(i, fits);
+    }
+    stats.hidden_total += stats.last_hidden;
+    if (first_dropped != SPRITE_FLICKER_MAX) start = first_dropped;
+}
+
+const SpriteFlickerStats* sprite_flicker_get_stats() {
+    return &stats;
+}
+
+void sprite_flicker_dump_klog() {
+    char line_buf[112];
+    sprintf(line_buf, "FLICKER frames=%lu overflow_frames=%lu hidden_total=%lu last_bands=%u last_hidden=%u peak_band=%u",
+            stats.frames, stats.overflow_frames, stats.hidden_total, stats.last_bands, stats.last_hidden,
+            stats.peak_band);
+    KLog(line_buf);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file sprite_sort.c
+ * @brief Implements the incremental Y sort: an insertion sort over last frame's order.
+ *
+ * `sprites[r]` is the sprite at rank r (0 in front), `keys[r]` its key and
+ * `depths[r]` the depth last given to it through SPR_setDepth() (-1 before
+ * the first). The three arrays move together.
+ */
+#include "sprite_sort.h"
+#include "hv_timer.h"      // For timing the update
+#include "error_handler.h" // For reporting a full table
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_SPRITE_SORT "sprite_sort"
+
+static Sprite* sprites[SPRITE_SORT_MAX];
+static s16 keys[SPRITE_SORT_MAX];
+static s16 depths[SPRITE_SORT_MAX];
+static u16 count = 0;
+static SpriteSortStats stats;
+
+void sprite_sort_init() {
+    count = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void sprite_sort_add(Sprite* sprite) {
+    if (count >= SPRITE_SORT_MAX) {
+        error_handler_display_error(MODULE_NAME_SPRITE_SORT, __func__, __LINE__, "Too many sprites!");
+        return;
+    }
+    sprites[count] = sprite;
+    keys[count] = -0x8000; // Behind everything until the next update sorts it in
+    depths[count] = -1;
+    count++;
+}
+
+void sprite_sort_remove(Sprite* sprite) {
+    for (u16 i = 0; i < count; i++) {
+        if (sprites[i] != sprite) continue;
+        // Shift the rest up: the array stays sorted, and their ranks drop by one.
+        count--;
+        for (u16 j = i; j < count; j++) {
+            sprites[j] = sprites[j + 1];
+            keys[j] = keys[j + 1];
+            depths[j] = depths[j + 1];
+        }
+        return;
+    }
+}
+
+void sprite_sort_invalidate() {
+    for (u16 i = 0; i < count; i++) depths[i] = -1;
+}
+
+void sprite_sort_update() {
+    u32 start = hv_timer_now();
+    u16 moves = 0;
+    u16 depth_calls = 0;
+
+    // New keys: the bottom edge, so the sprite whose feet are lower is in front.
+    for (u16 i = 0; i < count; i++) {
+        const Sprite* sprite = sprites[i];
+        s16 h = (sprite->frame != NULL) ? sprite->frame->h : 0;
+        keys[i] = SPR_getPositionY(sprite) + h;
+    }
+
+    // Insertion sort, largest key first. Sprites that did not cross anyone
+    // cost one comparison.
+    for (u16 i = 1; i < count; i++) {
+        s16 key = keys[i];
+        if (keys[i - 1] >= key) continue;
+        Sprite* sprite = sprites[i];
+        s16 depth = depths[i];
+        u16 j = i;
+        do {
+            sprites[j] = sprites[j - 1];
+            keys[j] = keys[j - 1];
+            depths[j] = depths[j - 1];
+            j--;
+            moves++;
+        } while (j > 0 && keys[j - 1] < key);
+        sprites[j] = sprite;
+        keys[j] = key;
+        depths[j] = depth;
+    }
+
+    // Depth = rank. The engine re-sorts a sprite when its depth changes, so
+    // once every changed rank is written its list is in rank order; sprites
+    // that kept their rank are not touched.
+    for (u16 r = 0; r < count; r++) {
+        if (depths[r] == (s16)r) continue;
+        depths[r] = r;
+        SPR_setDepth(sprites[r], r);
+        depth_calls++;
+    }
+
+    stats.updates++;
+    stats.last_moves = moves;
+    stats.last_depth = depth_calls;
+    stats.moves_total += moves;
+    stats.depth_total += depth_calls;
+    stats.last_lines = hv_timer_now() - start;
+    if (stats.last_lines > stats.peak_lines) stats.peak_lines = stats.last_lines;
+}
+
+const SpriteSortStats* sprite_sort_get_stats() {
+    return &stats;
+}
+
+void sprite_sort_dump_klog() {
+    char line_buf[112];
+    sprintf(line_buf, "YSORT updates=%lu moves_total=%lu depth_total=%lu last_moves=%u last_depth=%u peak_lines=%u",
+            stats.updates, stats.moves_total, stats.depth_total, stats.last_moves, stats.last_depth, stats.peak_lines);
+    KLog(line_buf);
+}
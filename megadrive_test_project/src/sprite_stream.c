@@ -0,0 +1,180 @@
+/**
+ * @file sprite_stream.c
+ * @brief Implements the frame cache: slot lookup, LRU eviction and budgeted uploads.
+ *
+ * Slot s covers tiles `base + s * slot_tiles` onwards. `slot_frame[s]` is the
+ * frame it holds (NULL if none), `slot_refs[s]` the registered sprites
+ * pointing at it and `slot_use[s]` the update that last bound or released it.
+ * Registered sprite i is bound to `bound_slot[i]` holding `bound_frame[i]`.
+ */
+#include "sprite_stream.h"
+#include "vram_alloc.h"    // For the cache's tile range
+#include "dma_scheduler.h" // For queuing frame uploads
+#include "error_handler.h" // For reporting full tables and unusable frames
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_SPRITE_STREAM "sprite_stream"
+
+#define SPRITE_STREAM_NO_SLOT 0xFF
+
+static const AnimationFrame* slot_frame[SPRITE_STREAM_MAX_SLOTS]; // Also the VRAM allocator key
+static u16 slot_refs[SPRITE_STREAM_MAX_SLOTS];
+static u32 slot_use[SPRITE_STREAM_MAX_SLOTS];
+static Sprite* sprites[SPRITE_STREAM_MAX_SPRITES];
+static const AnimationFrame* bound_frame[SPRITE_STREAM_MAX_SPRITES];
+static u8 bound_slot[SPRITE_STREAM_MAX_SPRITES];
+static u16 count = 0;
+static u16 base = VRAM_ALLOC_FAILED; // First tile of the cache; VRAM_ALLOC_FAILED when not initialized
+static u16 budget = SPRITE_STREAM_DEFAULT_BUDGET;
+static u32 tick = 0;
+static SpriteStreamStats stats;
+
+// Gives the sprite back to the engine's VRAM allocation and upload.
+static void _sprite_stream_unbind(u16 i) {
+    if (bound_slot[i] != SPRITE_STREAM_NO_SLOT) {
+        slot_refs[bound_slot[i]]--;
+        slot_use[bound_slot[i]] = tick;
+    }
+    SPR_setVRAMTileIndex(sprites[i], -1);
+    SPR_setAutoTileUpload(sprites[i], TRUE);
+}
+
+// Slot holding `frame`, or else the slot to load it into: a free one, or the
+// least recently used one without references other than the caller's `own`
+// slot. SPRITE_STREAM_NO_SLOT if none.
+static u8 _sprite_stream_find_slot(const AnimationFrame* frame, u8 own) {
+    u8 victim = SPRITE_STREAM_NO_SLOT;
+    for (u16 s = 0; s < stats.slots; s++) {
+        if (slot_frame[s] == frame) return s;
+        if (slot_refs[s] != (s == own ? 1 : 0)) continue;
+        if (victim == SPRITE_STREAM_NO_SLOT ||
+            (slot_frame[victim] != NULL && (slot_frame[s] == NULL || slot_use[s] < slot_use[victim]))) {
+            victim = s;
+        }
+    }
+    return victim;
+}
+
+u8 sprite_stream_init(u16 slots, u16 slot_tiles) {
+    sprite_stream_end();
+    memset(&stats, 0, sizeof(stats));
+    if (slots > SPRITE_STREAM_MAX_SLOTS) {
+        error_handler_display_error(MODULE_NAME_SPRITE_STREAM, __func__, __LINE__, "Too many slots!");
+        return FALSE;
+    }
+    // The tiles may still be resident from an earlier run, but the slots are
+    // not, so the cache starts empty either way.
+    base = vram_alloc_acquire(slot_frame, slots * slot_tiles, NULL);
+    if (base == VRAM_ALLOC_FAILED) return FALSE;
+    memset(slot_frame, 0, sizeof(slot_frame));
+    memset(slot_refs, 0, sizeof(slot_refs));
+    memset(slot_use, 0, sizeof(slot_use));
+    budget = SPRITE_STREAM_DEFAULT_BUDGET;
+    tick = 0;
+    stats.slots = slots;
+    stats.slot_tiles = slot_tiles;
+    return TRUE;
+}
+
+void sprite_stream_end() {
+    for (u16 i = 0; i < count; i++) _sprite_stream_unbind(i);
+    count = 0;
+    stats.sprites = 0;
+    if (base != VRAM_ALLOC_FAILED) vram_alloc_release(slot_frame);
+    base = VRAM_ALLOC_FAILED;
+}
+
+void sprite_stream_add(Sprite* sprite) {
+    if (count >= SPRITE_STREAM_MAX_SPRITES) {
+        error_handler_display_error(MODULE_NAME_SPRITE_STREAM, __func__, __LINE__, "Too many sprites!");
+        return;
+    }
+    sprites[count] = sprite;
+    bound_frame[count] = NULL;
+    bound_slot[count] = SPRITE_STREAM_NO_SLOT;
+    count++;
+    stats.sprites = count;
+}
+
+void sprite_stream_remove(Sprite* sprite) {
+    for (u16 i = 0; i < count; i++) {
+        if (sprites[i] != sprite) continue;
+        _sprite_stream_unbind(i);
+        count--;
+        sprites[i] = sprites[count];
+        bound_frame[i] = bound_frame[count];
+        bound_slot[i] = bound_slot[count];
+        stats.sprites = count;
+        return;
+    }
+}
+
+void sprite_stream_set_budget(u16 tiles) {
+    budget = tiles;
+}
+
+void sprite_stream_update() {
+    if (base == VRAM_ALLOC_FAILED) return;
+    u16 tiles = 0;
+    tick++;
+
+    for (u16 i = 0; i < count; i++) {
+        Sprite* sprite = sprites[i];
+        const AnimationFrame* frame = sprite->frame;
+        if (frame == bound_frame[i] || frame == NULL) continue;
+
+        u8 s = _sprite_stream_find_slot(frame, bound_slot[i]);
+        u16 num = frame->tileset->numTile;
+        if (s != SPRITE_STREAM_NO_SLOT && slot_frame[s] == frame) {
+            stats.hits++;
+            stats.tiles_skipped += num;
+        } else {
+            if (num > stats.slot_tiles || frame->tileset->compression != COMPRESSION_NONE) {
+                error_handler_display_error(MODULE_NAME_SPRITE_STREAM, __func__, __LINE__, "Frame cannot be streamed!");
+                bound_frame[i] = frame; // Report it once
+                continue;
+            }
+            // Sprite priority transfers are never split, so the budget is kept here.
+            if (s == SPRITE_STREAM_NO_SLOT || tiles + num > budget ||
+                !dma_scheduler_queue_tiles(DMA_PRIORITY_SPRITES, frame->tileset->tiles, base + s * stats.slot_tiles,
+                                           num)) {
+                stats.deferred++;
+                continue;
+            }
+            if (slot_frame[s] != NULL) stats.evictions++;
+            else stats.slots_used++;
+            slot_frame[s] = frame;
+            stats.misses++;
+            stats.tiles_uploaded += num;
+            tiles += num;
+        }
+
+        if (bound_slot[i] == SPRITE_STREAM_NO_SLOT) {
+            SPR_setAutoTileUpload(sprite, FALSE);
+        } else {
+            slot_refs[bound_slot[i]]--;
+            slot_use[bound_slot[i]] = tick;
+        }
+        slot_refs[s]++;
+        slot_use[s] = tick;
+        bound_slot[i] = s;
+        bound_frame[i] = frame;
+        SPR_setVRAMTileIndex(sprite, base + s * stats.slot_tiles);
+    }
+    stats.last_tiles = tiles;
+}
+
+const SpriteStreamStats* sprite_stream_get_stats() {
+    return &stats;
+}
+
+void sprite_stream_dump_klog() {
+    char line_buf[144];
+    sprintf(line_buf,
+            "SPRSTREAM sprites=%u slots=%u slot_tiles=%u used=%u hits=%lu misses=%lu evictions=%lu deferred=%lu "
+            "uploaded=%lu skipped=%lu",
+            stats.sprites, stats.slots, stats.slot_tiles, stats.slots_used, stats.hits, stats.misses, stats.evictions,
+            stats.deferred, stats.tiles_uploaded, stats.tiles_skipped);
+    KLog(line_buf);
+}
@@ -1,6 +1,7 @@
 #include "test_fades.h"
 #include "genesis.h"     // For VDP_ functions, SYS_getTime, etc.
 #include "transitions.h" // For store_current_palettes, transition_fade_out/in
+#include "palette_manager.h" // For palette_manager_set_palette()
 #include "input.h"       // For input_is_just_pressed (though exit is handled in main.c for this test)
 
 // --- Variables and Enum for Fade Test (Moved from main.c) ---
@@ -21,7 +22,7 @@ void test_fades_init() {
     fade_test_palette[2] = RGB24_TO_VDPCOLOR(0x00FF00); // Green
     fade_test_palette[3] = RGB24_TO_VDPCOLOR(0x0000FF); // Blue
     for(int i=4; i<16; ++i) fade_test_palette[i] = fade_test_palette[0]; // Fill rest
-    VDP_setPalette(PAL0, fade_test_palette);
+    palette_manager_set_palette(PAL0, fade_test_palette);
 
     // Draw some colored text/elements to showcase the fade
     VDP_setTextPalette(PAL0);
@@ -66,6 +67,8 @@ void test_fades_update() {
             VDP_drawText("Fade Test Complete. Press Start.", 2, 26);
             // No automatic transition from here, user exits with Start (handled in main.c)
             break;
+        default:
+            break;
     }
     // The main loop's switch handles Start press to exit to menu
 }
@@ -1,7 +1,7 @@
 #include "test_music.h"
 #include "music.h"       // Our new music module
 #include "input.h"
-#include "resources.h"   // For music_track_res_id
+#include "resources.h"   // For music_track_res
 #include <string.h>      // For KLog or sprintf
 
 static u8 music_playing = FALSE;
@@ -33,7 +33,7 @@ void music_test_update() {
     // Removed: u16 changed_input_state = current_input_state & ~prev_input_state;
 
     if (input_is_just_pressed(BUTTON_A)) { // Was changed_input_state & BUTTON_A
-        music_start(music_track_res_id); // music_track_res_id from resources.h
+        music_start(music_track_res); // music_track_res from resources.h
         music_playing = TRUE;
     }
     if (input_is_just_pressed(BUTTON_B)) { // Was changed_input_state & BUTTON_B
@@ -1,5 +1,8 @@
 #include "test_palette_cycle.h"
 #include "input.h"
+#include "vram_alloc.h" // For vram_alloc_acquire()
+#include "palette_manager.h" // For the shadowed palette reads and writes
+#include "tilemap_blit.h" // For drawing the rows as row transfers
 #include <genesis.h> // For VDP functions, u16, etc.
 #include <string.h>  // For memcpy
 
@@ -17,6 +20,11 @@ static const u16 cycle_colors[NUM_CYCLE_COLORS] = {
     RGB24_TO_VDPCOLOR(0x0000FF)  // Blue
 };
 
+// Fill byte of each solid tile (two pixels of color index 1, 2 or 3). Also the
+// tiles' key in the VRAM allocator.
+static const u8 cycle_tile_fills[NUM_CYCLE_COLORS] = { 0x11, 0x22, 0x33 };
+
+static u16 cycle_tile_index = TILE_USER_INDEX; // First of the three tiles, from the VRAM allocator
 static u16 base_palette0[16];          // To store the initial state of PAL0
 static s16 current_cycle_step = 0;     // Which color in cycle_colors is active for CYCLE_IDX_1
 static u16 cycle_timer = 0;
@@ -27,7 +35,7 @@ void palette_cycle_test_init() {
     VDP_clearPlane(BG_B, TRUE);
 
     // Store current PAL0, then set up our base for this test
-    VDP_getPalette(PAL0, base_palette0);
+    palette_manager_get_palette(PAL0, base_palette0);
 
     u16 temp_pal0[16];
     memcpy(temp_pal0, base_palette0, sizeof(base_palette0)); // Start with a copy of original PAL0
@@ -38,7 +46,7 @@ void palette_cycle_test_init() {
     temp_pal0[CYCLE_IDX_3] = cycle_colors[2];
     temp_pal0[15] = RGB24_TO_VDPCOLOR(0xFFFFFF); // Ensure color 15 is white for default text
 
-    VDP_setPalette(PAL0, temp_pal0);
+    palette_manager_set_palette(PAL0, temp_pal0);
 
     VDP_setTextPalette(PAL0); // Use PAL0 for text
 
@@ -47,17 +55,26 @@ void palette_cycle_test_init() {
     // For 4bpp tiles (default), each byte defines two pixels.
     // 0x11 means both pixels use color index 1 from the palette.
     // 0x22 means both pixels use color index 2, etc.
-    VDP_fillTileData(0x11, TILE_USER_INDEX + 0, 1, FALSE); // Tile for PAL0[CYCLE_IDX_1]
-    VDP_fillTileData(0x22, TILE_USER_INDEX + 1, 1, FALSE); // Tile for PAL0[CYCLE_IDX_2]
-    VDP_fillTileData(0x33, TILE_USER_INDEX + 2, 1, FALSE); // Tile for PAL0[CYCLE_IDX_3]
-    VDP_waitDMACompletion(); // Ensure tile data is written before drawing
+    // The tiles stay resident after the test exits, so a later visit skips the fill.
+    u8 resident;
+    cycle_tile_index = vram_alloc_acquire(cycle_tile_fills, NUM_CYCLE_COLORS, &resident);
+    if (!resident) {
+        for (u16 i = 0; i < NUM_CYCLE_COLORS; i++) {
+            VDP_fillTileData(cycle_tile_fills[i], cycle_tile_index + i, 1, FALSE); // Tile for PAL0[CYCLE_IDX_1 + i]
+        }
+        VDP_waitDMACompletion(); // Ensure tile data is written before drawing
+    }
 
-    // Draw rows of these solid color tiles
+    // Draw rows of these solid color tiles, one transfer per row; the rows
+    // between them are skipped.
     // TILE_ATTR_FULL(palette_num, priority, v_flip, h_flip, tile_vram_index)
     // We use PAL0 for these tiles.
-    for(int i=0; i<10; ++i) VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, TILE_USER_INDEX + 0), 5+i, 8);
-    for(int i=0; i<10; ++i) VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, TILE_USER_INDEX + 1), 5+i, 10);
-    for(int i=0; i<10; ++i) VDP_setTileMapXY(BG_A, TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, TILE_USER_INDEX + 2), 5+i, 12);
+    if (tilemap_blit_begin(10, 5)) {
+        for (u16 i = 0; i < NUM_CYCLE_COLORS; i++) {
+            tilemap_blit_fill(0, i * 2, 10, 1, TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, cycle_tile_index + i));
+        }
+        tilemap_blit_push(BG_A, 5, 8, CPU);
+    }
     
     VDP_drawText("Cycling PAL0 indices 1,2,3", 2, 2);
     VDP_drawText("Row 1 uses PAL0[1]", 18, 8);
@@ -79,16 +96,17 @@ void palette_cycle_test_update() {
         // Color at PAL0[CYCLE_IDX_1] gets current_step color
         // Color at PAL0[CYCLE_IDX_2] gets next color in cycle_colors
         // Color at PAL0[CYCLE_IDX_3] gets next-next color in cycle_colors
-        VDP_setPaletteColor(CYCLE_IDX_1, cycle_colors[(current_cycle_step + 0) % NUM_CYCLE_COLORS]);
-        VDP_setPaletteColor(CYCLE_IDX_2, cycle_colors[(current_cycle_step + 1) % NUM_CYCLE_COLORS]);
-        VDP_setPaletteColor(CYCLE_IDX_3, cycle_colors[(current_cycle_step + 2) % NUM_CYCLE_COLORS]);
+        palette_manager_set_color(CYCLE_IDX_1, cycle_colors[(current_cycle_step + 0) % NUM_CYCLE_COLORS]);
+        palette_manager_set_color(CYCLE_IDX_2, cycle_colors[(current_cycle_step + 1) % NUM_CYCLE_COLORS]);
+        palette_manager_set_color(CYCLE_IDX_3, cycle_colors[(current_cycle_step + 2) % NUM_CYCLE_COLORS]);
     }
     // Exit condition (Start button press) is handled in main.c's game loop
 }
 
 void palette_cycle_test_on_exit() {
     // Restore original PAL0
-    VDP_setPalette(PAL0, base_palette0);
+    palette_manager_set_palette(PAL0, base_palette0);
+    vram_alloc_release(cycle_tile_fills); // The tiles stay resident until the space is needed
     // Other cleanup (like clearing specific tiles or text) can be done here if needed,
     // but main.c's return_to_menu() already clears the planes.
 }
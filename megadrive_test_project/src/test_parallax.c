@@ -0,0 +1,141 @@
+#include "test_parallax.h"
+#include "parallax.h"      // For the per-line scroll bands
+#include "scroll_engine.h" // For streaming the map into BG_A
+#include "maps.h"          // For scrolling_map, compiled from res/maps.res
+#include "input.h"
+#include "resources.h"     // For my_tileset, tileset_img
+#include "dma_scheduler.h"
+#include "hv_timer.h"      // For converting the table cost to cycles
+#include "vram_alloc.h"    // For vram_alloc_acquire_tileset()
+#include "palette_manager.h" // For the dimmed background palette
+#include "vdp_cache.h"     // For the vertical scroll values
+#include <genesis.h>
+#include <string.h>        // For sprintf
+
+// The map from the scrolling demo is shown on BG_A, in front, and BG_B holds a
+// distant landscape split into line bands: drifting clouds, two ranges of
+// hills and a ground whose speed ramps up line by line towards the camera's.
+// Text goes on the window plane (the top rows), which does not scroll.
+
+#define PARALLAX_SPEED 2   // Camera pixels per frame
+#define PARALLAX_HUD_ROWS 5 // Window rows at the top of the screen
+
+// Tiles of tileset.png: 0 empty, 1 solid, 2 smiley, 3 diagonal cross
+#define TILE_SOLID 1
+#define TILE_SMILEY 2
+#define TILE_CROSS 3
+
+// The map scrolls with the camera over the whole screen.
+static const ParallaxBand map_bands[] = {
+    { 0, 224, 0x100, 0, 0 },
+};
+
+// Far to near. Speeds are 8.8: 0x40 moves a quarter pixel per camera pixel.
+static const ParallaxBand landscape_bands[] = {
+    {   0, 64, 0x20, 0, 0x30 }, // Clouds: slow, drifting left on their own
+    {  64, 32, 0x40, 0, 0 },    // Far hills
+    {  96, 64, 0x60, 0, 0 },    // Near hills
+    { 160, 64, 0x80, 2, 0 },    // Ground: 1/2 at the horizon to ~1 at the bottom
+};
+
+static s32 camera_x = 0;
+static s32 camera_y = 0;
+static u16 map_tile_index = TILE_USER_INDEX; // First tile of my_tileset, from the VRAM allocator
+
+// Draws the 64-tile-wide landscape on BG_B with PAL1. Each row repeats across
+// the plane width, so the bands can wrap freely.
+static void _parallax_test_draw_landscape() {
+    u16 row[64];
+    for (u16 y = 0; y < 28; y++) {
+        for (u16 x = 0; x < 64; x++) {
+            u16 tile = 0;
+            if (y < 8) {
+                // Clouds: a few 4x2 clusters
+                if ((y == 2 || y == 3) && (x % 16) < 4) tile = TILE_CROSS;
+                if ((y == 5 || y == 6) && ((x + 9) % 21) < 3) tile = TILE_CROSS;
+            } else if (y < 12) {
+                // Far hills: peaks every 16 tiles
+                s16 d = (s16)(x % 16) - 8;
+                if (d < 0) d = -d;
+                if (y - 8 >= d / 2) tile = TILE_SMILEY;
+            } else if (y < 20) {
+                // Near hills: wider, solid
+                s16 d = (s16)((x + 5) % 24) - 12;
+                if (d < 0) d = -d;
+                if (y - 12 >= d / 2) tile = TILE_SOLID;
+            } else {
+                // Ground: stripes every 4 tiles, so the speed ramp shows
+                tile = ((x / 4) & 1) ? TILE_CROSS : TILE_SOLID;
+            }
+            row[x] = tile ? TILE_ATTR_FULL(PAL1, FALSE, FALSE, FALSE, map_tile_index + tile) : 0;
+        }
+        VDP_setTileMapData(VDP_BG_B, row, y * 64, 64, CPU);
+    }
+}
+
+void parallax_test_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    VDP_clearPlane(WINDOW, TRUE);
+    VDP_setPlaneSize(64, 32, FALSE);
+
+    map_tile_index = vram_alloc_acquire_tileset(&my_tileset);
+    dma_scheduler_drain(); // The map below uses the tiles
+    palette_manager_set_palette(PAL0, tileset_img.palette->data);
+
+    // The landscape gets the same colors at half brightness, to look distant.
+    u16 dimmed[16];
+    for (u16 i = 0; i < 16; i++) dimmed[i] = (tileset_img.palette->data[i] >> 1) & 0x0666;
+    palette_manager_set_palette(PAL1, dimmed);
+
+    camera_x = 0;
+    camera_y = 0;
+    scroll_engine_init(BG_A, &scrolling_map, map_tile_index, camera_x, camera_y);
+    _parallax_test_draw_landscape();
+
+    parallax_init(HSCROLL_LINE);
+    parallax_set_bands(BG_A, map_bands, sizeof(map_bands) / sizeof(map_bands[0]));
+    parallax_set_bands(BG_B, landscape_bands, sizeof(landscape_bands) / sizeof(landscape_bands[0]));
+
+    VDP_setWindowVPos(FALSE, PARALLAX_HUD_ROWS);
+    VDP_setTextPalette(PAL0);
+    VDP_drawTextBG(WINDOW, "Parallax Demo. Use D-Pad.", 2, 1);
+    VDP_drawTextBG(WINDOW, "Press Start to Exit.", 2, 2);
+}
+
+void parallax_test_update() {
+    if (input_is_held(BUTTON_LEFT)) camera_x -= PARALLAX_SPEED;
+    if (input_is_held(BUTTON_RIGHT)) camera_x += PARALLAX_SPEED;
+    if (input_is_held(BUTTON_UP)) camera_y -= PARALLAX_SPEED;
+    if (input_is_held(BUTTON_DOWN)) camera_y += PARALLAX_SPEED;
+
+    // The engine streams the map and clamps the camera. Its horizontal scroll
+    // value is only latched while the line table is in use; the map band
+    // below applies the same camera instead.
+    scroll_engine_set_camera(camera_x, camera_y);
+    camera_x = scroll_engine_get_x();
+    camera_y = scroll_engine_get_y();
+    parallax_update(camera_x);
+
+    const ParallaxStats* stats = parallax_get_stats();
+    char text[40];
+    sprintf(text, "Tables: %3u lines (%5lu cycles)", stats->last_lines, hv_timer_lines_to_cycles(stats->last_lines));
+    VDP_drawTextBG(WINDOW, text, 2, 3);
+}
+
+void parallax_test_on_exit() {
+    parallax_dump_klog();
+    parallax_end();
+    VDP_setWindowVPos(FALSE, 0);
+
+    // Let queued edges and tables land before the planes are cleared.
+    dma_scheduler_drain();
+    vdp_cache_set_hscroll(BG_A, 0);
+    vdp_cache_set_vscroll(BG_A, 0);
+
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    VDP_clearPlane(WINDOW, TRUE);
+
+    vram_alloc_release(&my_tileset);
+}
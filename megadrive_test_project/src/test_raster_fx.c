@@ -0,0 +1,131 @@
+#include "test_raster_fx.h"
+#include "raster_fx.h"       // For the mid-frame changes
+#include "input.h"
+#include "resources.h"       // For my_tileset, tileset_img
+#include "dma_scheduler.h"
+#include "vram_alloc.h"      // For vram_alloc_acquire_tileset()
+#include "palette_manager.h" // For the palette restored on exit
+#include <genesis.h>
+#include <string.h>          // For sprintf
+
+// A sky gradient on the backdrop above a water line, where PAL0 switches to a
+// blue-tinted copy and BG_A starts to wobble vertically. Every change is an
+// H-int entry; the list is rebuilt every frame as the water line moves.
+
+#define RASTER_BACKDROP 48      // CRAM entry shown as the backdrop (PAL3[0])
+#define RASTER_SKY_STEP 16      // Lines per sky color
+#define RASTER_WAVE_STEP 8      // Lines per wobble band
+#define RASTER_WATER_MIN 64     // Keeps the text above the water
+#define RASTER_WATER_MAX 200
+#define RASTER_FRAME_CYCLES 127800UL // 68000 cycles per NTSC frame
+
+// Tiles of tileset.png: 0 empty, 1 solid, 2 smiley, 3 diagonal cross
+#define TILE_SMILEY 2
+#define TILE_CROSS 3
+
+// Vertical offsets of the wobble bands, in pixels.
+static const s16 wave[8] = { 0, 1, 2, 1, 0, -1, -2, -1 };
+
+static RasterFxEntry entries[RASTER_FX_MAX_ENTRIES];
+static u16 water_palette[16];
+static u16 saved_backdrop_color = 0;
+static u16 water_line = 128;
+static u16 phase = 0;
+static u16 map_tile_index = TILE_USER_INDEX; // First tile of my_tileset, from the VRAM allocator
+
+static void _raster_fx_test_add(u16* count, u16 line, u16 action, u16 target, u16 value, const u16* data) {
+    RasterFxEntry* entry = &entries[(*count)++];
+    entry->line = line;
+    entry->action = action;
+    entry->target = target;
+    entry->value = value;
+    entry->data = data;
+}
+
+static void _raster_fx_test_build() {
+    u16 count = 0;
+
+    // Top of the frame: first sky color, normal palette, BG_A unscrolled.
+    _raster_fx_test_add(&count, 0, RASTER_FX_BACKDROP, 0, RASTER_BACKDROP, NULL);
+    _raster_fx_test_add(&count, 0, RASTER_FX_PALETTE, PAL0, 0, tileset_img.palette->data);
+    _raster_fx_test_add(&count, 0, RASTER_FX_VSCROLL, BG_A, 0, NULL);
+
+    // Sky: dark blue at the top, lighter towards the horizon.
+    for (u16 line = 0, i = 0; line < water_line; line += RASTER_SKY_STEP, i++) {
+        u16 green = (i > 14) ? 14 : (i & 0xE);
+        u16 red = (i / 2) & 0xE;
+        _raster_fx_test_add(&count, line, RASTER_FX_COLOR, RASTER_BACKDROP, 0x0800 | (green << 4) | red, NULL);
+    }
+
+    // Water: deep blue backdrop, tinted palette, wobbling bands below.
+    _raster_fx_test_add(&count, water_line, RASTER_FX_COLOR, RASTER_BACKDROP, 0x0A40, NULL);
+    _raster_fx_test_add(&count, water_line, RASTER_FX_PALETTE, PAL0, 0, water_palette);
+    for (u16 line = water_line, i = 0; line < 224; line += RASTER_WAVE_STEP, i++) {
+        _raster_fx_test_add(&count, line, RASTER_FX_VSCROLL, BG_A, wave[(i + phase) & 7], NULL);
+    }
+
+    raster_fx_set(entries, count);
+}
+
+void raster_fx_test_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+
+    map_tile_index = vram_alloc_acquire_tileset(&my_tileset);
+    dma_scheduler_drain(); // The pattern below uses the tiles
+    palette_manager_set_palette(PAL0, tileset_img.palette->data);
+
+    // The palette under water: half brightness with blue added.
+    for (u16 i = 0; i < 16; i++) water_palette[i] = ((tileset_img.palette->data[i] >> 1) & 0x0666) | 0x0800;
+    water_palette[0] = tileset_img.palette->data[0];
+
+    // A sparse pattern over the whole plane, so the backdrop shows through.
+    u16 row[64];
+    for (u16 y = 0; y < 32; y++) {
+        for (u16 x = 0; x < 64; x++) {
+            u16 tile = 0;
+            if (y >= 7 && ((x + y) % 4) == 0) tile = ((x / 4) & 1) ? TILE_CROSS : TILE_SMILEY;
+            row[x] = tile ? TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, map_tile_index + tile) : 0;
+        }
+        VDP_setTileMapData(VDP_BG_A, row, y * 64, 64, CPU);
+    }
+
+    saved_backdrop_color = palette_manager_get_color(RASTER_BACKDROP);
+    water_line = 128;
+    phase = 0;
+    _raster_fx_test_build();
+
+    SYS_disableInts(); // Port writes between fires (see raster_fx.h)
+    VDP_drawTextBG(BG_B, "Raster Effects. Up/Down: water.", 2, 1);
+    VDP_drawTextBG(BG_B, "Press Start to Exit.", 2, 2);
+    SYS_enableInts();
+}
+
+void raster_fx_test_update() {
+    if (input_is_held(BUTTON_UP) && water_line > RASTER_WATER_MIN) water_line--;
+    if (input_is_held(BUTTON_DOWN) && water_line < RASTER_WATER_MAX) water_line++;
+    phase = (vtimer >> 3) & 7;
+    _raster_fx_test_build();
+
+    const RasterFxStats* stats = raster_fx_get_stats();
+    u32 permille = (stats->frame_cycles * 1000) / RASTER_FRAME_CYCLES;
+    char text[40];
+    SYS_disableInts();
+    sprintf(text, "Fires %2u, peak %4u cycles", stats->fires, stats->peak_cycles);
+    VDP_drawTextBG(BG_B, text, 2, 4);
+    sprintf(text, "Frame %5lu cycles (%lu.%lu%%)", stats->frame_cycles, permille / 10, permille % 10);
+    VDP_drawTextBG(BG_B, text, 2, 5);
+    SYS_enableInts();
+}
+
+void raster_fx_test_on_exit() {
+    raster_fx_dump_klog();
+    raster_fx_stop();
+    VDP_setBackgroundColor(0); // A register, with no shadow; the H-int is off now
+    palette_manager_set_color(RASTER_BACKDROP, saved_backdrop_color);
+
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+
+    vram_alloc_release(&my_tileset);
+}
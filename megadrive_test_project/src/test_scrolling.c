@@ -1,35 +1,58 @@
 #include "test_scrolling.h"
-#include "scrolling_map_data.h" // Our new map data
+#include "maps.h"        // For scrolling_map, compiled from res/maps.res
 #include "input.h"
 #include "resources.h" // For my_tileset
+#include "dma_scheduler.h"
+#include "scroll_engine.h" // For streaming the map into the plane
+#include "hv_timer.h" // For timing the column decoder
+#include "vram_alloc.h" // For vram_alloc_acquire_tileset()
+#include "palette_manager.h" // For palette_manager_set_palette()
+#include "vdp_cache.h" // For the scroll values written during VBlank
+#include "camera.h"    // For following the player over the map
+#include "entity_pool.h" // For the player and the actors
 #include <string.h>    // For KLog or sprintf if used for debug text
 
-static s16 scroll_x_px = 0;
-static s16 scroll_y_px = 0;
+static s32 scroll_x_px = 0;
+static s32 scroll_y_px = 0;
+static u16 map_tile_index = TILE_USER_INDEX; // First tile of my_tileset, from the VRAM allocator
+static u16 player_entity = ENTITY_POOL_NONE;
 #define SCROLL_SPEED 2 // pixels per frame
+#define SCROLL_COLUMN_TILES 29 // Tiles in one streamed column (224 / 8 + 1)
+#define SCROLL_ACTORS 63 // Entities wandering the map besides the player
+
+// The map (SCROLLING_MAP_WIDTH x SCROLLING_MAP_HEIGHT tiles) is larger than the
+// 64x32 plane; the scroll engine streams it into BG_B as the camera moves and
+// clamps the camera to the map. The text stays on BG_A, which does not scroll.
+// The D-Pad walks a player over the map; the camera follows it with a dead zone
+// and a look-ahead, and the actors elsewhere on the map are culled.
+
+// Times metatile_decode_column() over the first 64 columns of the map, one
+// screen-high column being what the scroll engine decodes for each 8 pixels of
+// horizontal movement, and shows the average.
+static void _scrolling_test_time_column_decode() {
+    u16 column[SCROLL_COLUMN_TILES];
+    char text[40];
+
+    u32 start = hv_timer_now();
+    for (u16 x = 0; x < 64; x++) {
+        metatile_decode_column(&scrolling_map, x, 0, SCROLL_COLUMN_TILES, column, map_tile_index);
+    }
+    u32 cycles = hv_timer_lines_to_cycles(hv_timer_now() - start) / 64;
 
-// Max scroll values depend on map size and screen size
-// Screen: 320x224 pixels (40x28 tiles)
-// Map: SCROLLING_MAP_WIDTH * 8 x SCROLLING_MAP_HEIGHT * 8 pixels
-// Max scroll X = (Map Width in pixels) - (Screen Width in pixels)
-// Max scroll Y = (Map Height in pixels) - (Screen Height in pixels)
-#define MAX_SCROLL_X ((SCROLLING_MAP_WIDTH * 8) - 320)
-#define MAX_SCROLL_Y ((SCROLLING_MAP_HEIGHT * 8) - 224)
-
+    sprintf(text, "Column decode: %lu cycles", cycles);
+    VDP_drawText(text, 2, 6);
+    sprintf(text, "METATILE column_tiles=%u cycles=%lu", SCROLL_COLUMN_TILES, cycles);
+    KLog(text);
+}
 
 void scrolling_test_init() {
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE); // Clear other plane too
 
-    // Set plane size for BG_A to accommodate the large map
-    // SGDK plane sizes: 32, 64, 128 tiles.
-    // Our map is 64x32 tiles. This fits a 64x32 plane.
-    // For SGDK, actual plane width/height arguments are in tiles: (width_tiles, height_tiles)
-    // The VDP_setPlaneSize function takes these tile counts.
-    // SGDK will select the smallest VDP plane size that can contain these dimensions.
-    // e.g., if map is 64x32 tiles, it will use a 64x32 VRAM plane.
-    // If map is 40x30, it might use a 64x32 VRAM plane.
-    VDP_setPlaneSize(BG_A, SCROLLING_MAP_WIDTH, SCROLLING_MAP_HEIGHT, FALSE);
+    // Plane size: SGDK plane sizes are 32, 64 or 128 tiles per side.
+    // The map is far larger than any plane, so the plane only has to hold the
+    // screen plus one partly visible tile each way (41x29 tiles); 64x32 does.
+    VDP_setPlaneSize(64, 32, FALSE); // Applies to both BG_A and BG_B
 
     // Load the tileset (my_tileset from resources.res, using tileset.png)
     // This assumes my_tileset uses PAL0, or we need to load its palette.
@@ -38,77 +61,96 @@ void scrolling_test_init() {
     // For now, assuming my_tileset.palette is available and loaded to PAL0 by a previous step
     // or that this test should explicitly load it.
     // The `load_simple_tileset()` from graphics.c does:
-    //   VDP_loadTileSet(&my_tileset, TILE_USER_INDEX, DMA);
-    //   VDP_setPalette(PAL0, my_tileset.palette->data);
+    //   vram_alloc_acquire_tileset(&my_tileset);
+    //   palette_manager_set_palette(PAL0, tileset_img.palette->data);
     // We should do the same here, or rely on it being done if this test is part of a larger system.
-    // For a self-contained test, let's load it.
-    VDP_loadTileSet(&my_tileset, TILE_USER_INDEX, DMA);
-    VDP_setPalette(PAL0, my_tileset.palette->data);
-
+    // For a self-contained test, let's load it. The tilemap test shares the same
+    // range, so the upload is skipped if either test ran recently.
+    map_tile_index = vram_alloc_acquire_tileset(&my_tileset);
+    dma_scheduler_drain(); // The map below uses the tiles
+    palette_manager_set_palette(PAL0, tileset_img.palette->data); // TileSets carry no palette; use the IMAGE of the same PNG
 
-    // Draw the large map onto BG_A
-    // VDP_setTileMapData efficiently copies tile data for the entire map.
-    // Arguments: plane, source_tilemap_data, dest_x_tile_plane, dest_y_tile_plane,
-    //            width_tiles, height_tiles, source_map_is_same_width_as_plane, transfer_method
-    VDP_setTileMapData(BG_A, (const u16*)scrolling_map_data, 0, 0, SCROLLING_MAP_WIDTH, SCROLLING_MAP_HEIGHT, TRUE, DMA);
-    // The TRUE above is for plan_width_is_tilemap_width which is true here since we sized the plane to the map.
 
-    // Set initial scroll position
+    // Show the map on BG_B with the camera at the top-left corner.
+    // The map is stored as 16x16 metatiles whose entries already hold PAL0; the
+    // engine decodes the visible part now and later only the edges that scroll
+    // into view, moving the tile numbers to the allocated range as it goes.
     scroll_x_px = 0;
     scroll_y_px = 0;
-    VDP_setHorizontalScroll(BG_A, scroll_x_px);
-    VDP_setVerticalScroll(BG_A, scroll_y_px);
+    scroll_engine_init(BG_B, &scrolling_map, map_tile_index, scroll_x_px, scroll_y_px);
+
+    // The player and the actors live in world coordinates, over the whole map.
+    s32 world_w = SCROLLING_MAP_WIDTH * 8;
+    s32 world_h = SCROLLING_MAP_HEIGHT * 8;
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+    entity_pool_init();
+    entity_pool_set_bounds(0, 0, world_w - 16, world_h - 16);
+    camera_init(world_w, world_h);
+    camera_set_dead_zone(120, 80, 184, 128);
+    camera_set_look_ahead(48, 1);
+    player_entity = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), 152, 104, 0, 0);
+    for (u16 i = 0; i < SCROLL_ACTORS; i++) {
+        u16 id = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, FALSE, FALSE, FALSE), (i * 331) % (world_w - 16),
+                                   (i * 97) % (world_h - 16), ((i & 1) ? 1 : -1) * (0x40 + (i % 4) * 0x20),
+                                   ((i & 2) ? 1 : -1) * (0x40 + (i % 3) * 0x20));
+        if (id != ENTITY_POOL_NONE) entity_pool_set_anim_speed(id, 8 + (i % 8));
+    }
 
     VDP_setTextPalette(PAL0); // Text will use PAL0 (same as map for now)
-    VDP_drawText("Scrolling Demo. Use D-Pad.", 2, 2);
+    VDP_drawText("Scrolling Demo. D-Pad walks.", 2, 2);
     VDP_drawText("Press Start to Exit.", 2, 3);
+
+    _scrolling_test_time_column_decode();
 }
 
 void scrolling_test_update() {
-    if (input_is_dpad_left_pressed()) {
-        scroll_x_px -= SCROLL_SPEED;
-        if (scroll_x_px < 0) scroll_x_px = 0;
-    }
-    if (input_is_dpad_right_pressed()) {
-        scroll_x_px += SCROLL_SPEED;
-        if (scroll_x_px > MAX_SCROLL_X) scroll_x_px = MAX_SCROLL_X;
-    }
-    if (input_is_dpad_up_pressed()) {
-        scroll_y_px -= SCROLL_SPEED;
-        if (scroll_y_px < 0) scroll_y_px = 0;
-    }
-    if (input_is_dpad_down_pressed()) {
-        scroll_y_px += SCROLL_SPEED;
-        if (scroll_y_px > MAX_SCROLL_Y) scroll_y_px = MAX_SCROLL_Y;
-    }
-
-    VDP_setHorizontalScroll(BG_A, scroll_x_px);
-    VDP_setVerticalScroll(BG_A, scroll_y_px);
+    s16 vx = 0, vy = 0;
+    if (input_is_held(BUTTON_LEFT)) vx -= SCROLL_SPEED;
+    if (input_is_held(BUTTON_RIGHT)) vx += SCROLL_SPEED;
+    if (input_is_held(BUTTON_UP)) vy -= SCROLL_SPEED;
+    if (input_is_held(BUTTON_DOWN)) vy += SCROLL_SPEED;
+
+    // Move the player, then the camera after it. The pool places the sprites
+    // with this frame's camera on the next update, so sprites and planes both
+    // lag one frame behind the player and stay in step with each other.
+    entity_pool_set_velocity(player_entity, vx << 8, vy << 8);
+    entity_pool_update();
+    camera_follow(entity_pool_get_x(player_entity), entity_pool_get_y(player_entity), vx, vy);
+
+    // Queues the tiles that come into view; they and the new scroll values are
+    // written during VBlank. The engine clamps the camera to the map, as the camera does.
+    scroll_engine_set_camera(camera_get_x(), camera_get_y());
+    scroll_x_px = scroll_engine_get_x();
+    scroll_y_px = scroll_engine_get_y();
+    SPR_update();
 
     // Display scroll coordinates (optional, for debugging)
     char coord_text[30];
-    sprintf(coord_text, "X:%4d Y:%3d", scroll_x_px, scroll_y_px); // Padded for consistent clear
-    VDP_clearText(2, 5, 20); // Clear previous text based on max length of coord_text
+    sprintf(coord_text, "X:%4ld Y:%3ld culled:%2u", scroll_x_px, scroll_y_px, entity_pool_get_stats()->culled);
+    VDP_clearText(2, 5, 24); // Clear previous text based on max length of coord_text
     VDP_drawText(coord_text, 2, 5);
 }
 
 void scrolling_test_on_exit() {
-    // Reset plane size to a common default (e.g., 64x32 or 32x32) if it was changed.
-    // The menu system and other tests might expect a certain plane size.
-    // SGDK's default is often 64x32 for BG_A/BG_B after SGDK_init.
-    // If SCROLLING_MAP_WIDTH/HEIGHT are different from this, reset.
-    // For now, we used SCROLLING_MAP_WIDTH (64) and SCROLLING_MAP_HEIGHT (32),
-    // so it might already be the default or a common size.
-    // If a different test needs a smaller plane, it should set it in its init.
-    // Best practice is to explicitly reset if unsure or if it differs from a known common state.
-    // VDP_setPlaneSize(BG_A, 64, 32, FALSE); // Example reset to 64x32
+    entity_pool_dump_klog();
+    entity_pool_clear(); // main.c's return_to_menu() then calls SPR_end()
+    // The plane size set in init (64x32) is SGDK's default, so it is left as is.
+
+    // Edges queued this frame are written at the next flush; let them land
+    // first, or they would reappear on the cleared plane.
+    dma_scheduler_drain();
 
     // Clear scroll registers
-    VDP_setHorizontalScroll(BG_A, 0);
-    VDP_setVerticalScroll(BG_A, 0);
+    vdp_cache_set_hscroll(BG_B, 0);
+    vdp_cache_set_vscroll(BG_B, 0);
 
-    // Clear the plane so the map doesn't persist into the menu
+    // Clear the planes so the map and text don't persist into the menu
     VDP_clearPlane(BG_A, TRUE);
-    // Palette will be reset by menu_init's VDP_setPaletteColor(0, ...) for background
+    VDP_clearPlane(BG_B, TRUE);
+
+    // The tiles stay resident in VRAM until the allocator needs the space.
+    vram_alloc_release(&my_tileset);
+    // Palette will be reset by menu_init's palette_manager_set_color(0, ...) for background
     // and VDP_setTextPalette().
 }
@@ -1,14 +1,14 @@
 #include "test_sprite_demo.h"
 #include "graphics.h"    // For setup_sprites() and update_sprites_example()
-#include "sound.h"       // For init_sound_system() (if setup_sprites doesn't call it)
 #include "input.h"       // For input_is_just_pressed() and BUTTON_START
 #include "transitions.h" // For store_current_palettes(), transition_fade_out_to_black(), transition_fade_in_from_black()
+#include "palette_manager.h" // For the background color
 // #include "main.h" // Not needed if main.c handles the exit trigger
 
 void test_sprite_demo_init() {
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE);
-    VDP_setPaletteColor(0, RGB24_TO_VDPCOLOR(0x000040)); // Background color for sprite demo
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000040)); // Background color for sprite demo
     
     // setup_sprites() from graphics.c initializes sprites, loads palettes,
     // and previously also called init_sound_system() and input_init().
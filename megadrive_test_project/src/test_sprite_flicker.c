@@ -0,0 +1,77 @@
+#include "test_sprite_flicker.h"
+#include "sprite_flicker.h"  // The code under test
+#include "entity_pool.h"     // For moving the sprites
+#include "input.h"
+#include "resources.h"       // For spr_player
+#include "palette_manager.h" // For the background and sprite colors
+#include <genesis.h>
+#include <string.h>          // For sprintf
+
+#define FLICKER_STRIP_SPRITES 32 // In the strip: 32 per line against a limit of 20
+#define FLICKER_ROAMING_SPRITES 8
+#define FLICKER_STRIP_Y 104      // Strip entities bounce between this and 8 lines lower
+
+static u8 flicker_enabled = TRUE;
+
+static void _flicker_test_draw_status() {
+    char line_buf[41];
+    const SpriteFlickerStats* stats = sprite_flicker_get_stats();
+
+    VDP_drawText(flicker_enabled ? "Flicker: ON " : "Flicker: OFF", 1, 4);
+    sprintf(line_buf, "Bands over: %2u  Hidden: %2u", stats->last_bands, stats->last_hidden);
+    VDP_drawText(line_buf, 1, 5);
+    sprintf(line_buf, "Overflow frames: %lu", stats->overflow_frames);
+    VDP_drawText(line_buf, 1, 6);
+}
+
+void test_sprite_flicker_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000040));
+    VDP_setTextPalette(PAL0);
+
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+    entity_pool_init();
+    sprite_flicker_init();
+    flicker_enabled = TRUE;
+
+    // The pool's bounds are shared, so the strip entities stay in it by moving
+    // horizontally only; the roaming ones start elsewhere and bounce around.
+    entity_pool_set_bounds(0, 56, 320 - 16, 200 - 16);
+    for (u16 i = 0; i < FLICKER_STRIP_SPRITES + FLICKER_ROAMING_SPRITES; i++) {
+        u16 id;
+        if (i < FLICKER_STRIP_SPRITES) {
+            s16 vx = ((i & 1) ? 1 : -1) * (0x80 + (i % 4) * 0x40);
+            id = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), i * 9,
+                                   FLICKER_STRIP_Y + (i % 3) * 4, vx, 0);
+        } else {
+            id = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), (i * 53) % 300, 56 + (i * 19) % 120,
+                                   (i & 1) ? 0x100 : -0x100, (i & 2) ? 0xC0 : -0xC0);
+        }
+        entity_pool_set_anim_speed(id, 10 + (i % 6));
+        sprite_flicker_add(entity_pool_get_sprite(id));
+    }
+
+    VDP_drawText("Sprite Flicker - Start to Exit", 1, 2);
+    VDP_drawText("A: toggle flicker", 1, 26);
+    _flicker_test_draw_status();
+}
+
+void test_sprite_flicker_update() {
+    if (input_is_just_pressed(BUTTON_A)) {
+        flicker_enabled = !flicker_enabled;
+        sprite_flicker_set_enabled(flicker_enabled);
+    }
+
+    entity_pool_update();
+    sprite_flicker_update();
+    SPR_update();
+    _flicker_test_draw_status();
+}
+
+void test_sprite_flicker_on_exit() {
+    sprite_flicker_dump_klog();
+    sprite_flicker_init();
+    entity_pool_clear();
+}
@@ -0,0 +1,104 @@
+#include "test_sprite_stream.h"
+#include "sprite_stream.h"   // The code under test
+#include "entity_pool.h"     // For moving and animating the sprites
+#include "input.h"
+#include "resources.h"       // For spr_player
+#include "palette_manager.h" // For the background and sprite colors
+#include <genesis.h>
+#include <string.h>          // For sprintf
+
+#define STREAM_WALKERS 40
+#define STREAM_SLOTS 8       // Frame slots; spr_player needs 2, the rest stay free for other definitions
+// Tight cache: fewer slots than spr_player's frames, so the one streamed walker
+// has to reload its own slot on every frame change.
+#define STREAM_TIGHT_SLOTS 1
+#define STREAM_TIGHT_WALKERS 1
+
+static u16 walker_ids[STREAM_WALKERS];
+static u8 streaming = TRUE;
+static u8 tight = FALSE;
+
+static u16 _stream_test_walkers() {
+    return tight ? STREAM_TIGHT_WALKERS : STREAM_WALKERS;
+}
+
+static void _stream_test_set_streaming(u8 value) {
+    streaming = value;
+    for (u16 i = 0; i < _stream_test_walkers(); i++) {
+        Sprite* sprite = entity_pool_get_sprite(walker_ids[i]);
+        if (value) sprite_stream_add(sprite);
+        else sprite_stream_remove(sprite);
+    }
+}
+
+static void _stream_test_set_tight(u8 value) {
+    // Re-initializing gives every walker back to the engine and empties the cache.
+    tight = value;
+    // The cache's range stays resident under the same allocator key, so the
+    // tight cache spreads the same tiles over fewer, larger slots.
+    u16 tiles = STREAM_SLOTS * spr_player.maxNumTile;
+    if (tight) sprite_stream_init(STREAM_TIGHT_SLOTS, tiles / STREAM_TIGHT_SLOTS);
+    else sprite_stream_init(STREAM_SLOTS, spr_player.maxNumTile);
+    if (streaming) _stream_test_set_streaming(TRUE);
+}
+
+static void _stream_test_draw_status() {
+    char line_buf[41];
+    const SpriteStreamStats* stats = sprite_stream_get_stats();
+
+    VDP_drawText(streaming ? "Streaming: ON " : "Streaming: OFF", 1, 4);
+    VDP_drawText(tight ? "Tight cache" : "           ", 20, 4);
+    sprintf(line_buf, "Cache: %2u/%2u slots, %3u tiles", stats->slots_used, stats->slots,
+            stats->slots * stats->slot_tiles);
+    VDP_drawText(line_buf, 1, 5);
+    sprintf(line_buf, "Engine VRAM free: %3u tiles", SPR_getFreeVRAM());
+    VDP_drawText(line_buf, 1, 6);
+    sprintf(line_buf, "Hits %5lu  Misses %3lu  Evict %3lu", stats->hits, stats->misses, stats->evictions);
+    VDP_drawText(line_buf, 1, 7);
+    sprintf(line_buf, "Uploaded %4lu  Skipped %5lu", stats->tiles_uploaded, stats->tiles_skipped);
+    VDP_drawText(line_buf, 1, 8);
+}
+
+void test_sprite_stream_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x002000));
+    VDP_setTextPalette(PAL0);
+
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+    entity_pool_init();
+    tight = FALSE;
+    sprite_stream_init(STREAM_SLOTS, spr_player.maxNumTile);
+
+    // Walkers bounce around below the text, each on its own animation speed so
+    // they change frame on different frames.
+    entity_pool_set_bounds(0, 80, 320 - 16, 216 - 16);
+    for (u16 i = 0; i < STREAM_WALKERS; i++) {
+        walker_ids[i] = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), (i * 37) % 300,
+                                          80 + (i * 23) % 120, ((i & 1) ? 1 : -1) * (0x60 + (i % 5) * 0x20),
+                                          ((i & 2) ? 1 : -1) * (0x40 + (i % 3) * 0x20));
+        entity_pool_set_anim_speed(walker_ids[i], 6 + (i % 11));
+    }
+    _stream_test_set_streaming(TRUE);
+
+    VDP_drawText("Sprite Streaming - Start to Exit", 1, 2);
+    VDP_drawText("A: toggle streaming  B: tight cache", 1, 26);
+    _stream_test_draw_status();
+}
+
+void test_sprite_stream_update() {
+    if (input_is_just_pressed(BUTTON_A)) _stream_test_set_streaming(!streaming);
+    if (input_is_just_pressed(BUTTON_B)) _stream_test_set_tight(!tight);
+
+    entity_pool_update();
+    sprite_stream_update();
+    SPR_update();
+    _stream_test_draw_status();
+}
+
+void test_sprite_stream_on_exit() {
+    sprite_stream_dump_klog();
+    sprite_stream_end(); // Before the pool releases the sprites
+    entity_pool_clear();
+}
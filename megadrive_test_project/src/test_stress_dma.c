@@ -0,0 +1,153 @@
+#include "test_stress_dma.h"
+#include "hv_timer.h" // For measuring each transfer in scanlines
+#include "input.h"
+#include "vram_alloc.h" // For vram_alloc_acquire()
+#include "palette_manager.h" // For the tile colors
+#include "tilemap_blit.h" // For the RAM-built rectangle method
+#include <genesis.h>
+#include <string.h>   // For sprintf
+
+#define STRESS_DMA_W 40                            // Screen width in tiles (H40)
+#define STRESS_DMA_H 28                            // Screen height in tiles (V28)
+#define STRESS_DMA_WORDS (STRESS_DMA_W * STRESS_DMA_H) // Words written per sample
+#define STRESS_DMA_FILL_TILES (STRESS_DMA_WORDS / 16)  // Same amount as tile data (16 words per tile)
+#define STRESS_DMA_SAMPLES 32                      // Frames measured per method
+#define STRESS_DMA_TILE_COUNT (2 + STRESS_DMA_FILL_TILES) // Two solid tiles, then the DMA fill's scratch tiles
+#define STRESS_DMA_TABLE_Y 5
+
+typedef enum {
+    STRESS_DMA_SET_TILE_XY,  // One VDP_setTileMapXY() call per tilemap entry
+    STRESS_DMA_SET_MAP_DATA, // One VDP_setTileMapData() DMA per screen row
+    STRESS_DMA_BLIT,         // Screen built with tilemap_blit, pushed by CPU one row at a time
+    STRESS_DMA_FILL,         // One DMA fill (VDP_fillTileData)
+    STRESS_DMA_METHOD_COUNT
+} StressDmaMethod;
+
+static const char* const method_names[STRESS_DMA_METHOD_COUNT] = {
+    "setTileMapXY",
+    "setTileMapData",
+    "tilemap_blit",
+    "DMA fill"
+};
+
+static u16 row_buffer[STRESS_DMA_W];
+static u32 method_lines[STRESS_DMA_METHOD_COUNT]; // Scanlines summed over the samples
+static StressDmaMethod current_method = STRESS_DMA_SET_TILE_XY;
+static u16 sample_count = 0;
+static u8 finished = FALSE;
+static u16 saved_colors[2]; // PAL0 colors 1 and 2, restored on exit
+// First of STRESS_DMA_TILE_COUNT tiles from the VRAM allocator: two solid tiles the
+// tilemap writes alternate between, then the scratch tiles the DMA fill writes to.
+static u16 stress_tile = TILE_USER_INDEX;
+
+static void _stress_dma_draw_result(StressDmaMethod method) {
+    char line_buf[64];
+    u32 avg_lines = method_lines[method] / STRESS_DMA_SAMPLES;
+    // Words that fit into one whole frame at this rate (if nothing else ran).
+    u32 words_per_frame = ((u32)STRESS_DMA_WORDS * hv_timer_lines_per_frame()) / (avg_lines ? avg_lines : 1);
+
+    sprintf(line_buf, "%-15s %5lu %7lu", method_names[method], avg_lines, words_per_frame);
+    VDP_drawText(line_buf, 1, STRESS_DMA_TABLE_Y + 1 + method);
+
+    sprintf(line_buf, "STRESS dma method=%s lines=%lu words_per_frame=%lu", method_names[method], avg_lines,
+            words_per_frame);
+    KLog(line_buf);
+}
+
+static void _stress_dma_start() {
+    memset(method_lines, 0, sizeof(method_lines));
+    current_method = STRESS_DMA_SET_TILE_XY;
+    sample_count = 0;
+    finished = FALSE;
+
+    for (u16 y = STRESS_DMA_TABLE_Y + 1; y < STRESS_DMA_TABLE_Y + 1 + STRESS_DMA_METHOD_COUNT; y++) {
+        VDP_clearText(0, y, 40);
+    }
+    VDP_clearText(0, 26, 40);
+    VDP_drawText("Measuring...", 1, 26);
+}
+
+// Writes STRESS_DMA_WORDS words with one method.
+static void _stress_dma_run(StressDmaMethod method, u16 tile) {
+    switch (method) {
+        case STRESS_DMA_SET_TILE_XY:
+            for (u16 y = 0; y < STRESS_DMA_H; y++) {
+                for (u16 x = 0; x < STRESS_DMA_W; x++) VDP_setTileMapXY(BG_B, tile, x, y);
+            }
+            break;
+        case STRESS_DMA_SET_MAP_DATA: {
+            u16 plane_width = VDP_getPlaneWidth();
+            for (u16 y = 0; y < STRESS_DMA_H; y++) {
+                VDP_setTileMapData(VDP_BG_B, row_buffer, y * plane_width, STRESS_DMA_W, DMA);
+            }
+            break;
+        }
+        case STRESS_DMA_BLIT:
+            // Building the rectangle is part of the cost, as for the per-cell loop.
+            if (tilemap_blit_begin(STRESS_DMA_W, STRESS_DMA_H)) {
+                tilemap_blit_fill(0, 0, STRESS_DMA_W, STRESS_DMA_H, tile);
+                tilemap_blit_push(BG_B, 0, 0, CPU);
+            }
+            break;
+        case STRESS_DMA_FILL:
+            VDP_fillTileData(tile & 1 ? 0x11 : 0x22, stress_tile + 2, STRESS_DMA_FILL_TILES, TRUE);
+            break;
+        default:
+            break;
+    }
+}
+
+void test_stress_dma_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    VDP_setTextPalette(PAL0);
+
+    // Two dim solid tiles, so the text on BG_A stays readable over BG_B.
+    saved_colors[0] = palette_manager_get_color(1);
+    saved_colors[1] = palette_manager_get_color(2);
+    palette_manager_set_color(1, RGB24_TO_VDPCOLOR(0x400000));
+    palette_manager_set_color(2, RGB24_TO_VDPCOLOR(0x004000));
+    // The range is keyed on the sample buffer; nothing else uses it.
+    u8 resident;
+    stress_tile = vram_alloc_acquire(row_buffer, STRESS_DMA_TILE_COUNT, &resident);
+    if (!resident) {
+        VDP_fillTileData(0x11, stress_tile, 1, TRUE);
+        VDP_fillTileData(0x22, stress_tile + 1, 1, TRUE);
+    }
+
+    VDP_drawText("VDP Transfer Stress - Start to Exit", 1, 2);
+    VDP_drawText("METHOD          LINES WORDS/FRAME", 1, STRESS_DMA_TABLE_Y);
+    _stress_dma_start();
+}
+
+void test_stress_dma_update() {
+    if (finished) {
+        if (input_is_just_pressed(BUTTON_A)) _stress_dma_start();
+        return;
+    }
+
+    // Alternate the tile every frame so every sample writes new values.
+    u16 tile = TILE_ATTR_FULL(PAL0, FALSE, FALSE, FALSE, stress_tile + (sample_count & 1));
+    for (u16 x = 0; x < STRESS_DMA_W; x++) row_buffer[x] = tile;
+
+    u32 start = hv_timer_now();
+    _stress_dma_run(current_method, tile);
+    VDP_waitDMACompletion();
+    method_lines[current_method] += hv_timer_now() - start;
+
+    if (++sample_count < STRESS_DMA_SAMPLES) return;
+
+    _stress_dma_draw_result(current_method);
+    sample_count = 0;
+    if (++current_method >= STRESS_DMA_METHOD_COUNT) {
+        finished = TRUE;
+        VDP_clearText(0, 26, 40);
+        VDP_drawText("A: measure again", 1, 26);
+    }
+}
+
+void test_stress_dma_on_exit() {
+    palette_manager_set_color(1, saved_colors[0]);
+    palette_manager_set_color(2, saved_colors[1]);
+    vram_alloc_release(row_buffer);
+}
@@ -0,0 +1,113 @@
+#include "test_stress_entities.h"
+#include "entity_pool.h"     // The code under test
+#include "resources.h"       // For spr_player
+#include "hv_timer.h"        // For converting the update cost to cycles
+#include "palette_manager.h" // For the background and sprite colors
+#include <genesis.h>
+#include <string.h>          // For sprintf
+
+#define STRESS_ENT_STEP 8           // Entities added per window
+#define STRESS_ENT_WINDOW_FRAMES 8  // Frames each entity count runs before the next step
+#define STRESS_ENT_SPRITES 64       // Entities with a sprite; the others are logic only
+#define STRESS_ENT_FRAME_CYCLES 127800UL // 68000 cycles per NTSC frame
+#define STRESS_ENT_MIN_Y 56            // Below the status text
+#define STRESS_ENT_MAX_Y (200 - 16)    // Above the help text
+
+static u16 spawned = 0;          // Entities spawned so far, for spreading them out
+static u16 churn_id = 0;         // Despawned and respawned every frame
+static u16 window_frame = 0;
+static u32 window_lines = 0;     // Scanlines spent in entity_pool_update() this window
+static u32 cycles_per_entity = 0; // Of the last completed window, in 1/10 cycles
+static u8 finished = FALSE;
+
+// Spawns one entity, spread over the screen with its own direction and speed.
+static u16 _stress_entities_spawn(u8 with_sprite) {
+    u16 i = spawned++;
+    s16 x = (i * 37) % (320 - 16);
+    s16 y = STRESS_ENT_MIN_Y + (i * 23) % (STRESS_ENT_MAX_Y - STRESS_ENT_MIN_Y);
+    s16 vx = ((i & 1) ? 1 : -1) * (0x80 + (i % 5) * 0x40);
+    s16 vy = ((i & 2) ? 1 : -1) * (0x80 + (i % 3) * 0x40);
+    const SpriteDefinition* def = with_sprite ? &spr_player : NULL;
+    u16 id = entity_pool_spawn(def, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), x, y, vx, vy);
+    if (id != ENTITY_POOL_NONE) entity_pool_set_anim_speed(id, 8 + (i % 8));
+    return id;
+}
+
+static void _stress_entities_draw_status() {
+    char line_buf[41];
+
+    sprintf(line_buf, "Entities: %3u  Update: %3u ln", entity_pool_count(), entity_pool_get_stats()->last_lines);
+    VDP_clearText(1, 4, 38);
+    VDP_drawText(line_buf, 1, 4);
+    if (cycles_per_entity == 0) return;
+
+    sprintf(line_buf, "Per entity: %lu.%lu cycles", cycles_per_entity / 10, cycles_per_entity % 10);
+    VDP_clearText(1, 5, 38);
+    VDP_drawText(line_buf, 1, 5);
+    sprintf(line_buf, "Fits %lu per frame", (STRESS_ENT_FRAME_CYCLES * 10) / cycles_per_entity);
+    VDP_clearText(1, 6, 38);
+    VDP_drawText(line_buf, 1, 6);
+}
+
+void test_stress_entities_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000040));
+    VDP_setTextPalette(PAL0);
+
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+    entity_pool_init();
+    entity_pool_set_bounds(0, STRESS_ENT_MIN_Y, 320 - 16, STRESS_ENT_MAX_Y);
+
+    spawned = 0;
+    window_frame = 0;
+    window_lines = 0;
+    cycles_per_entity = 0;
+    finished = FALSE;
+    for (u16 i = 0; i < STRESS_ENT_STEP; i++) _stress_entities_spawn(TRUE);
+    churn_id = 0;
+
+    VDP_drawText("Entity Stress - Start to Exit", 1, 2);
+    VDP_drawText("Adds 8 entities every 8 frames", 1, 26);
+    _stress_entities_draw_status();
+}
+
+void test_stress_entities_update() {
+    // Exercise the free list: one entity goes and a new one takes its id (the
+    // list is LIFO), so ids stay 0..count-1 and the churn walks through them.
+    entity_pool_despawn(churn_id);
+    _stress_entities_spawn(churn_id < STRESS_ENT_SPRITES);
+    if (++churn_id >= entity_pool_count()) churn_id = 0;
+
+    entity_pool_update();
+    SPR_update();
+
+    if (finished) return;
+    window_lines += entity_pool_get_stats()->last_lines;
+    if (++window_frame < STRESS_ENT_WINDOW_FRAMES) return;
+
+    // Cost per entity over the window, in tenths of a cycle (a scanline is ~488).
+    u32 entity_frames = (u32)entity_pool_count() * STRESS_ENT_WINDOW_FRAMES;
+    cycles_per_entity = (hv_timer_lines_to_cycles(window_lines) * 10) / entity_frames;
+
+    if (entity_pool_count() + STRESS_ENT_STEP > ENTITY_POOL_MAX) {
+        char line_buf[96];
+        finished = TRUE;
+        sprintf(line_buf, "STRESS entities count=%u update_lines=%lu cycles_per_entity=%lu.%lu per_frame=%lu",
+                entity_pool_count(), window_lines / STRESS_ENT_WINDOW_FRAMES, cycles_per_entity / 10,
+                cycles_per_entity % 10,
+                cycles_per_entity ? (STRESS_ENT_FRAME_CYCLES * 10) / cycles_per_entity : 0);
+        KLog(line_buf);
+    } else {
+        for (u16 i = 0; i < STRESS_ENT_STEP; i++) _stress_entities_spawn(entity_pool_count() < STRESS_ENT_SPRITES);
+    }
+    _stress_entities_draw_status();
+    window_frame = 0;
+    window_lines = 0;
+}
+
+void test_stress_entities_on_exit() {
+    entity_pool_dump_klog();
+    entity_pool_clear();
+}
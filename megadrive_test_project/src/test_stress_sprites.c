@@ -0,0 +1,126 @@
+#include "test_stress_sprites.h"
+#include "resources.h" // For spr_player
+#include "hv_timer.h"  // For measuring the update in scanlines
+#include "palette_manager.h" // For the background and sprite colors
+#include <genesis.h>
+#include <string.h>    // For sprintf
+
+#define STRESS_SPR_MAX 80          // Sprites the VDP can display in H40 mode
+#define STRESS_SPR_WINDOW_FRAMES 8 // Frames each sprite count runs before the next is added
+#define STRESS_SPR_MAX_X (320 - 16)
+#define STRESS_SPR_MAX_Y (224 - 16)
+
+static Sprite* sprites[STRESS_SPR_MAX];
+static s16 sprite_x[STRESS_SPR_MAX];
+static s16 sprite_y[STRESS_SPR_MAX];
+static s16 sprite_dx[STRESS_SPR_MAX];
+static s16 sprite_dy[STRESS_SPR_MAX];
+static u16 sprite_count = 0;
+
+static u32 last_vtimer = 0;     // vtimer at the previous update, to spot dropped frames
+static u16 window_frame = 0;    // Frames run at the current sprite count
+static u16 window_lag = 0;      // Dropped frames at the current sprite count
+static u32 window_lines = 0;    // Scanlines spent in the current window
+static u16 last_avg_lines = 0;  // Average update cost of the last completed window
+static u16 capacity = 0;        // 0 while ramping, then the sustained sprite count
+
+// Returns FALSE if the sprite engine has no room for another sprite.
+static u8 _stress_sprites_add() {
+    u16 i = sprite_count;
+    // Spread the sprites over the screen with different directions.
+    sprite_x[i] = (i * 37) % STRESS_SPR_MAX_X;
+    sprite_y[i] = 24 + (i * 23) % (STRESS_SPR_MAX_Y - 24);
+    sprite_dx[i] = (i & 1) ? 1 : -1;
+    sprite_dy[i] = (i & 2) ? 1 : -1;
+    sprites[i] = SPR_addSprite(&spr_player, sprite_x[i], sprite_y[i], TILE_ATTR(PAL1, TRUE, FALSE, FALSE));
+    if (sprites[i] == NULL) return FALSE;
+    sprite_count++;
+    return TRUE;
+}
+
+static void _stress_sprites_draw_status() {
+    char line_buf[41];
+
+    sprintf(line_buf, "Sprites: %2u  Update: %3u ln", sprite_count, last_avg_lines);
+    VDP_clearText(1, 4, 38);
+    VDP_drawText(line_buf, 1, 4);
+
+    if (capacity != 0) {
+        sprintf(line_buf, "Sustained: %u sprites/frame", capacity);
+        VDP_drawText(line_buf, 1, 6);
+        if (capacity == STRESS_SPR_MAX) VDP_drawText("(VDP sprite limit reached)", 1, 7);
+    }
+}
+
+static void _stress_sprites_finish(u16 sustained_count) {
+    char line_buf[64];
+
+    capacity = sustained_count;
+    sprintf(line_buf, "STRESS sprites capacity=%u update_lines=%u", capacity, last_avg_lines);
+    KLog(line_buf);
+    _stress_sprites_draw_status();
+}
+
+void test_stress_sprites_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000040));
+    VDP_setTextPalette(PAL0);
+
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+
+    sprite_count = 0;
+    window_frame = 0;
+    window_lag = 0;
+    window_lines = 0;
+    last_avg_lines = 0;
+    capacity = 0;
+    _stress_sprites_add();
+    last_vtimer = vtimer;
+
+    VDP_drawText("Sprite Stress - Start to Exit", 1, 2);
+    VDP_drawText("Adds a sprite until a frame drops", 1, 26);
+    _stress_sprites_draw_status();
+}
+
+void test_stress_sprites_update() {
+    // More than one VBlank since the last update means the last frame was dropped.
+    if (vtimer - last_vtimer > 1) window_lag++;
+    last_vtimer = vtimer;
+
+    u32 start = hv_timer_now();
+    for (u16 i = 0; i < sprite_count; i++) {
+        sprite_x[i] += sprite_dx[i];
+        sprite_y[i] += sprite_dy[i];
+        if (sprite_x[i] <= 0 || sprite_x[i] >= STRESS_SPR_MAX_X) sprite_dx[i] = -sprite_dx[i];
+        if (sprite_y[i] <= 0 || sprite_y[i] >= STRESS_SPR_MAX_Y) sprite_dy[i] = -sprite_dy[i];
+        SPR_setPosition(sprites[i], sprite_x[i], sprite_y[i]);
+    }
+    SPR_update();
+    u32 elapsed = hv_timer_now() - start;
+
+    if (capacity != 0) return; // Ramp finished; keep running at the sustained count
+
+    window_lines += elapsed;
+    if (++window_frame < STRESS_SPR_WINDOW_FRAMES) return;
+
+    last_avg_lines = window_lines / STRESS_SPR_WINDOW_FRAMES;
+    if (window_lag > 0 && sprite_count > 1) {
+        // This count dropped frames: back off to the last one that did not.
+        SPR_releaseSprite(sprites[--sprite_count]);
+        _stress_sprites_finish(sprite_count);
+    } else if (sprite_count >= STRESS_SPR_MAX || !_stress_sprites_add()) {
+        _stress_sprites_finish(sprite_count);
+    } else {
+        _stress_sprites_draw_status();
+    }
+    window_frame = 0;
+    window_lag = 0;
+    window_lines = 0;
+}
+
+void test_stress_sprites_on_exit() {
+    // main.c's return_to_menu() calls SPR_end(), which releases every sprite.
+    sprite_count = 0;
+}
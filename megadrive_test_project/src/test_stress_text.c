@@ -0,0 +1,87 @@
+#include "test_stress_text.h"
+#include "hv_timer.h" // For measuring the redraw in scanlines
+#include <genesis.h>
+#include <string.h>   // For sprintf
+
+#define STRESS_TEXT_FIRST_ROW 4   // Rows 0-1 belong to the debug overlays, 2 to the title
+#define STRESS_TEXT_ROWS 20       // Rows redrawn every frame
+#define STRESS_TEXT_COLS 40
+#define STRESS_TEXT_CHARS (STRESS_TEXT_ROWS * STRESS_TEXT_COLS)
+#define STRESS_TEXT_SAMPLES 32    // Frames averaged per status update
+
+static char screen_rows[STRESS_TEXT_ROWS][STRESS_TEXT_COLS + 1];
+static u16 phase = 0;          // Shifts the characters every frame so each redraw changes the screen
+static u32 sample_lines = 0;   // Scanlines summed over the current samples
+static u16 sample_count = 0;
+static u32 last_vtimer = 0;    // vtimer at the previous update, to spot dropped frames
+static u32 lag_frames = 0;
+static u8 reported = FALSE;    // The KLog line is written once per visit
+
+static void _stress_text_fill_rows() {
+    for (u16 y = 0; y < STRESS_TEXT_ROWS; y++) {
+        for (u16 x = 0; x < STRESS_TEXT_COLS; x++) {
+            screen_rows[y][x] = '!' + ((x + y + phase) % 90); // Printable ASCII '!' to 'z'
+        }
+        screen_rows[y][STRESS_TEXT_COLS] = '\0';
+    }
+}
+
+static void _stress_text_report(u32 avg_lines) {
+    char line_buf[64];
+    // Characters that fit into one whole frame at this rate (if nothing else ran).
+    u32 chars_per_frame = ((u32)STRESS_TEXT_CHARS * hv_timer_lines_per_frame()) / (avg_lines ? avg_lines : 1);
+
+    sprintf(line_buf, "%u chars: %lu ln, %lu chars/frame", STRESS_TEXT_CHARS, avg_lines, chars_per_frame);
+    VDP_clearText(0, 25, 40);
+    VDP_drawText(line_buf, 1, 25);
+    sprintf(line_buf, "Dropped frames: %lu", lag_frames);
+    VDP_clearText(0, 26, 40);
+    VDP_drawText(line_buf, 1, 26);
+
+    if (!reported) {
+        sprintf(line_buf, "STRESS text lines=%lu chars_per_frame=%lu", avg_lines, chars_per_frame);
+        KLog(line_buf);
+        reported = TRUE;
+    }
+}
+
+void test_stress_text_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    VDP_setTextPalette(PAL0);
+
+    phase = 0;
+    sample_lines = 0;
+    sample_count = 0;
+    lag_frames = 0;
+    reported = FALSE;
+    last_vtimer = vtimer;
+
+    VDP_drawText("Text Stress - Start to Exit", 1, 2);
+    VDP_drawText("Measuring...", 1, 25);
+}
+
+void test_stress_text_update() {
+    // More than one VBlank since the last update means the last frame was dropped.
+    if (vtimer - last_vtimer > 1) lag_frames += vtimer - last_vtimer - 1;
+    last_vtimer = vtimer;
+
+    phase++;
+    _stress_text_fill_rows();
+
+    u32 start = hv_timer_now();
+    for (u16 y = 0; y < STRESS_TEXT_ROWS; y++) {
+        VDP_drawText(screen_rows[y], 0, STRESS_TEXT_FIRST_ROW + y);
+    }
+    sample_lines += hv_timer_now() - start;
+
+    if (++sample_count < STRESS_TEXT_SAMPLES) return;
+
+    _stress_text_report(sample_lines / STRESS_TEXT_SAMPLES);
+    sample_lines = 0;
+    sample_count = 0;
+}
+
+void test_stress_text_on_exit() {
+    // Nothing specific; main.c's return_to_menu() clears the planes.
+}
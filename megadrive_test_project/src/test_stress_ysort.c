@@ -0,0 +1,136 @@
+#include "test_stress_ysort.h"
+#include "sprite_sort.h"     // The code under test
+#include "entity_pool.h"     // For moving the sprites
+#include "resources.h"       // For spr_player
+#include "hv_timer.h"        // For measuring the sorts
+#include "palette_manager.h" // For the background and sprite colors
+#include <genesis.h>
+#include <string.h>          // For sprintf
+
+#define YSORT_PHASE_FRAMES 60 // Frames measured per sort and sprite count
+#define YSORT_STEPS 3
+
+static const u16 step_counts[YSORT_STEPS] = { 20, 40, 80 };
+
+static Sprite* registered[SPRITE_SORT_MAX]; // In spawn order, for the full sort
+static u16 num_registered = 0;
+static u16 step = 0;
+static u8 full_phase = FALSE;   // FALSE: incremental, TRUE: full sort
+static u16 phase_frame = 0;
+static u32 phase_lines = 0;
+static u32 incremental_cycles = 0; // Average of the current step's incremental phase
+
+// Full sort for comparison: Shell sort of every sprite by key from the
+// registration order, then every depth rewritten.
+static void _ysort_full_sort() {
+    static Sprite* order[SPRITE_SORT_MAX];
+    static s16 keys[SPRITE_SORT_MAX];
+    static const u16 gaps[] = { 23, 10, 4, 1 };
+
+    for (u16 i = 0; i < num_registered; i++) {
+        order[i] = registered[i];
+        keys[i] = SPR_getPositionY(order[i]) + order[i]->frame->h;
+    }
+    for (u16 g = 0; g < sizeof(gaps) / sizeof(gaps[0]); g++) {
+        u16 gap = gaps[g];
+        for (u16 i = gap; i < num_registered; i++) {
+            Sprite* sprite = order[i];
+            s16 key = keys[i];
+            u16 j = i;
+            while (j >= gap && keys[j - gap] < key) {
+                order[j] = order[j - gap];
+                keys[j] = keys[j - gap];
+                j -= gap;
+            }
+            order[j] = sprite;
+            keys[j] = key;
+        }
+    }
+    for (u16 i = 0; i < num_registered; i++) SPR_setDepth(order[i], i);
+}
+
+static void _ysort_spawn_up_to(u16 target) {
+    while (num_registered < target) {
+        u16 i = num_registered;
+        u16 id = entity_pool_spawn(&spr_player, TILE_ATTR(PAL1, TRUE, FALSE, FALSE), (i * 37) % 300, 56 + (i * 29) % 128,
+                                   ((i & 1) ? 1 : -1) * (0x60 + (i % 5) * 0x30), ((i & 2) ? 1 : -1) * (0x40 + (i % 3) * 0x30));
+        if (id == ENTITY_POOL_NONE) return;
+        Sprite* sprite = entity_pool_get_sprite(id);
+        if (sprite == NULL) return;
+        registered[num_registered++] = sprite;
+        sprite_sort_add(sprite);
+    }
+}
+
+static void _ysort_draw_header() {
+    VDP_drawText("Y-Sort Stress - Start to Exit", 1, 2);
+    VDP_drawText("SPRITES  INCREMENTAL   FULL SORT", 1, 3);
+}
+
+void test_stress_ysort_init() {
+    VDP_clearPlane(BG_A, TRUE);
+    VDP_clearPlane(BG_B, TRUE);
+    palette_manager_set_color(0, RGB24_TO_VDPCOLOR(0x000040));
+    VDP_setTextPalette(PAL0);
+
+    SPR_init();
+    palette_manager_set_palette(PAL1, spr_player.palette->data);
+    entity_pool_init();
+    entity_pool_set_bounds(0, 56, 320 - 16, 224 - 16);
+    sprite_sort_init();
+
+    num_registered = 0;
+    step = 0;
+    full_phase = FALSE;
+    phase_frame = 0;
+    phase_lines = 0;
+    _ysort_spawn_up_to(step_counts[0]);
+    _ysort_draw_header();
+}
+
+void test_stress_ysort_update() {
+    entity_pool_update();
+
+    u32 start = hv_timer_now();
+    if (full_phase) _ysort_full_sort();
+    else sprite_sort_update();
+    u32 elapsed = hv_timer_now() - start;
+    SPR_update();
+
+    if (!full_phase) {
+        const SpriteSortStats* stats = sprite_sort_get_stats();
+        char text[41];
+        sprintf(text, "Moves %3u  depth calls %3u", stats->last_moves, stats->last_depth);
+        VDP_drawText(text, 1, 8);
+    }
+    if (step >= YSORT_STEPS) return; // Done; keep running the incremental sort
+
+    // The first frame of a phase re-sorts from another order; leave it out.
+    if (phase_frame++ > 0) phase_lines += elapsed;
+    if (phase_frame <= YSORT_PHASE_FRAMES) return;
+
+    u32 cycles = hv_timer_lines_to_cycles(phase_lines) / YSORT_PHASE_FRAMES;
+    char line_buf[64];
+    if (!full_phase) {
+        incremental_cycles = cycles;
+        full_phase = TRUE;
+    } else {
+        sprintf(line_buf, "%7u %8lu cyc %8lu cyc", step_counts[step], incremental_cycles, cycles);
+        VDP_drawText(line_buf, 1, 4 + step);
+        sprintf(line_buf, "STRESS ysort sprites=%u incremental_cycles=%lu full_cycles=%lu", step_counts[step],
+                incremental_cycles, cycles);
+        KLog(line_buf);
+
+        full_phase = FALSE;
+        sprite_sort_invalidate(); // The full sort set depths behind its back
+        if (++step < YSORT_STEPS) _ysort_spawn_up_to(step_counts[step]);
+    }
+    phase_frame = 0;
+    phase_lines = 0;
+}
+
+void test_stress_ysort_on_exit() {
+    sprite_sort_dump_klog();
+    sprite_sort_init();
+    entity_pool_clear();
+}
@@ -1,5 +1,5 @@
 #include "test_tilemap.h"
-#include "graphics.h" // For load_simple_tileset(), display_simple_tilemap()
+#include "graphics.h" // For load_simple_tileset(), display_simple_tilemap(), release_simple_tileset()
 #include "input.h"    // For input_is_just_pressed() and BUTTON_START (if exit handled here)
 // #include "main.h" // If calling a main_return_to_menu() function directly
 
@@ -26,6 +26,7 @@ void test_tilemap_update() {
 void test_tilemap_on_exit() {
     // Specific cleanup for the tilemap test before returning to menu.
     // VDP_clearPlane(BG_A, TRUE) is called by main.c's return_to_menu(),
-    // so it's not strictly needed here unless there are other specific resources.
-    // For now, this can be empty.
+    // so it's not strictly needed here.
+    // The tileset stays resident in VRAM, so re-entering this test skips the upload.
+    release_simple_tileset();
 }
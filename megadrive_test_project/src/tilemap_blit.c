@@ -0,0 +1,81 @@
+/**
+ * @file tilemap_blit.c
+ * @brief Implements the RAM-built, row-pushed tilemap rectangles.
+ */
+#include "tilemap_blit.h"
+#include "error_handler.h" // For reporting invalid rectangles and planes
+
+// Module name for error reporting
+#define MODULE_NAME_TILEMAP_BLIT "tilemap_blit"
+
+static u16 cells[TILEMAP_BLIT_MAX_CELLS];
+static u16 blit_w = 0;
+static u16 blit_h = 0;
+
+u8 tilemap_blit_begin(u16 w, u16 h) {
+    if (w == 0 || h == 0 || (u32)w * h > TILEMAP_BLIT_MAX_CELLS) {
+        error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Invalid rectangle size!");
+        blit_w = 0;
+        blit_h = 0;
+        return FALSE;
+    }
+    blit_w = w;
+    blit_h = h;
+    for (u16 i = 0; i < w * h; i++) cells[i] = TILEMAP_BLIT_SKIP;
+    return TRUE;
+}
+
+void tilemap_blit_set(u16 x, u16 y, u16 tile) {
+    if (x >= blit_w || y >= blit_h) {
+        error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Cell out of rectangle!");
+        return;
+    }
+    cells[y * blit_w + x] = tile;
+}
+
+void tilemap_blit_fill(u16 x, u16 y, u16 w, u16 h, u16 tile) {
+    if (x + w > blit_w || y + h > blit_h) {
+        error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Area out of rectangle!");
+        return;
+    }
+    for (u16 j = 0; j < h; j++) {
+        u16* row = &cells[(y + j) * blit_w + x];
+        for (u16 i = 0; i < w; i++) row[i] = tile;
+    }
+}
+
+u16 tilemap_blit_plane_address(VDPPlane plane) {
+    if (plane == BG_A) return VDP_BG_A;
+    if (plane == BG_B) return VDP_BG_B;
+    error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Invalid plane!");
+    return 0;
+}
+
+void tilemap_blit_push(VDPPlane plane, u16 x, u16 y, TransferMethod tm) {
+    u16 plane_addr = tilemap_blit_plane_address(plane);
+    if (plane_addr == 0) return;
+    if (tm != CPU && tm != DMA) {
+        error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Only CPU or DMA transfers!");
+        return;
+    }
+    u16 plane_width = VDP_getPlaneWidth();
+    // A row must not run past the plane's right edge: VRAM continues with the next row there.
+    if (x + blit_w > plane_width || y + blit_h > VDP_getPlaneHeight()) {
+        error_handler_display_error(MODULE_NAME_TILEMAP_BLIT, __func__, __LINE__, "Rectangle out of plane!");
+        return;
+    }
+
+    for (u16 j = 0; j < blit_h; j++) {
+        const u16* row = &cells[j * blit_w];
+        u16 i = 0;
+        while (i < blit_w) {
+            if (row[i] == TILEMAP_BLIT_SKIP) {
+                i++;
+                continue;
+            }
+            u16 run_start = i;
+            while (i < blit_w && row[i] != TILEMAP_BLIT_SKIP) i++;
+            VDP_setTileMapData(plane_addr, &row[run_start], (y + j) * plane_width + x + run_start, i - run_start, tm);
+        }
+    }
+}
@@ -3,12 +3,13 @@
  * @brief Implements screen transition effects.
  *
  * This module provides functions for fading the screen out to black and
- * fading back in from black. It uses SGDK's built-in VDP (Video Display Processor)
- * functions for palette manipulation to achieve these effects.
+ * fading back in from black. It fades the palette manager's shadow palette
+ * (see `palette_manager.h`), one batched CRAM upload per frame.
  * Palettes PAL0 and PAL1 are currently stored and restored.
  */
 #include "transitions.h"
-#include <string.h> // For memcpy, used in constructing the full palette for VDP_fadeInAll
+#include "palette_manager.h" // For the shadow palette the fades read and write
+#include <string.h> // For memcpy, used in constructing the full target palette for the fade-in
 
 /**
  * @brief Stored VDP hardware palette 0 (16 colors).
@@ -21,37 +22,37 @@ static u16 stored_palette0[16];
  */
 static u16 stored_palette1[16];
 // static const u16 palette_black_single[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-// The above is not strictly needed because VDP_fadeOutAll() handles fading to black,
-// and VDP_fadeInAll() can construct the target palette dynamically.
+// The above is not strictly needed because transition_fade_out_to_black() uses an all-black
+// target, and transition_fade_in_from_black() constructs the target palette dynamically.
 
 /**
  * @brief Stores the current VDP palettes (PAL0 and PAL1) into static arrays.
  *
- * This function reads the color values from hardware palettes PAL0 and PAL1
- * using `VDP_getPalette()` and saves them into `stored_palette0` and
+ * This function reads the color values of palettes PAL0 and PAL1 from the RAM shadow
+ * using `palette_manager_get_palette()` and saves them into `stored_palette0` and
  * `stored_palette1` respectively. This is essential for correctly restoring
  * these palettes during a fade-in transition.
  *
  * If the application also uses PAL2 and PAL3 and these need to be preserved
- * across fade transitions that affect all palettes (like `VDP_fadeOutAll`),
+ * across fade transitions that affect all palettes (like `transition_fade_out_to_black()`),
  * then `stored_palette2` and `stored_palette3` arrays should be added and
  * populated here as well.
  */
 void store_current_palettes() {
-    VDP_getPalette(PAL0, stored_palette0); // Get PAL0 colors
-    VDP_getPalette(PAL1, stored_palette1); // Get PAL1 colors
+    palette_manager_get_palette(PAL0, stored_palette0); // Get PAL0 colors
+    palette_manager_get_palette(PAL1, stored_palette1); // Get PAL1 colors
     // If PAL2 and PAL3 were also in use and needed preservation:
-    // VDP_getPalette(PAL2, stored_palette2);
-    // VDP_getPalette(PAL3, stored_palette3);
+    // palette_manager_get_palette(PAL2, stored_palette2);
+    // palette_manager_get_palette(PAL3, stored_palette3);
 }
 
 /**
  * @brief Fades the entire screen (all 4 VDP palettes) out to black.
  *
- * This function utilizes SGDK's `VDP_fadeOutAll()` function, which smoothly
+ * This function utilizes `palette_manager_fade_to()`, which smoothly
  * transitions all 64 VDP color entries (PAL0, PAL1, PAL2, and PAL3) to
- * black (color index 0x000). After initiating the fade, it calls `VDP_waitVSync()`
- * to pause execution until the fade effect has visually completed on the screen.
+ * black (color index 0x000). It blocks until the fade effect has visually
+ * completed on the screen.
  *
  * It's generally expected that `store_current_palettes()` has been called
  * sometime before this function if a subsequent fade-in to the original palettes
@@ -69,19 +70,19 @@ void transition_fade_out_to_black(u16 speed_frames) {
     // `store_current_palettes()` here, or clearly document it as a prerequisite.
     // store_current_palettes();
 
-    VDP_fadeOutAll(speed_frames); // SGDK function to fade all palettes to black
-    VDP_waitVSync();              // Wait for the VSync to ensure the fade is complete
+    static const u16 black_palette[PALETTE_MANAGER_COLORS] = {0};
+    palette_manager_fade_to(black_palette, speed_frames); // Fade all palettes to black (blocking)
 }
 
 /**
  * @brief Fades the screen in from black to the previously stored palettes.
  *
- * This function uses SGDK's `VDP_fadeInAll()` to transition the screen colors
+ * This function uses `palette_manager_fade_to()` to transition the screen colors
  * from black to a target palette. The target palette is constructed using the
  * color data previously saved by `store_current_palettes()` (i.e., `stored_palette0`
  * and `stored_palette1`).
  *
- * `VDP_fadeInAll` requires a single array of 64 colors representing the target state
+ * `palette_manager_fade_to()` requires a single array of 64 colors representing the target state
  * for all four hardware palettes (PAL0-PAL3). This function prepares such an array:
  * - `stored_palette0` is copied to the first 16 entries.
  * - `stored_palette1` is copied to the next 16 entries.
@@ -89,8 +90,7 @@ void transition_fade_out_to_black(u16 speed_frames) {
  *   assuming they are not used or should remain black after the fade-in. If PAL2/PAL3
  *   were also stored by `store_current_palettes()`, their data should be copied here instead.
  *
- * After initiating the fade, `VDP_waitVSync()` is called to ensure the fade-in
- * effect completes visually.
+ * The fade blocks until the fade-in effect completes visually.
  *
  * @param speed_frames The duration of the fade-in effect, in video frames.
  *                     Similar to `transition_fade_out_to_black`, higher values mean
@@ -100,7 +100,7 @@ void transition_fade_in_from_black(u16 speed_frames) {
     // Assumes stored_palette0 and stored_palette1 contain the desired target palettes
     // for PAL0 and PAL1 respectively.
 
-    // VDP_fadeInAll requires a single 64-color palette source array.
+    // palette_manager_fade_to requires a single 64-color palette source array.
     // We construct this array here.
     static u16 full_target_palette[64]; // Declared static for safety, though could be local
                                        // if not used in an asynchronous context (which it isn't here).
@@ -119,6 +119,5 @@ void transition_fade_in_from_black(u16 speed_frames) {
     }
 
     // Perform the fade-in operation using the constructed full palette
-    VDP_fadeInAll(speed_frames, full_target_palette);
-    VDP_waitVSync(); // Wait for VSync to ensure the fade is complete
+    palette_manager_fade_to(full_target_palette, speed_frames); // Blocking fade
 }
@@ -0,0 +1,121 @@
+/**
+ * @file vdp_cache.c
+ * @brief Implements the cached, VBlank-committed scroll values.
+ */
+#include "vdp_cache.h"
+#include "error_handler.h" // For reporting an invalid plane or mode
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_VDP_CACHE "vdp_cache"
+
+/** @brief Scroll registers, indexed like `planes`. */
+typedef struct {
+    s16 hscroll[2];
+    s16 vscroll[2];
+} VdpCacheState;
+
+static const VDPPlane planes[2] = { BG_A, BG_B };
+
+static VdpCacheState requested;  // Latched by the setters
+static VdpCacheState written;    // What the VDP holds after the last commit
+static u16 requested_mode = HSCROLL_PLANE;
+static u16 written_mode = HSCROLL_PLANE;
+static u8 write_all = FALSE;     // Commit every value, whatever `written` says
+static VdpCacheStats stats;
+
+// Index into VdpCacheState for a plane, or -1 (reported) for anything but BG_A and BG_B.
+static s16 _vdp_cache_slot(VDPPlane plane, const char* func, u16 line) {
+    if (plane == BG_A) return 0;
+    if (plane == BG_B) return 1;
+    error_handler_display_error(MODULE_NAME_VDP_CACHE, func, line, "Invalid plane!");
+    return -1;
+}
+
+// Latches `value` into `*slot`, unless it is already the requested value.
+static void _vdp_cache_set(s16* slot, s16 value) {
+    stats.requested++;
+    if (*slot == value) {
+        stats.dropped++;
+        return;
+    }
+    *slot = value;
+}
+
+// VBlank process callback: writes whatever changed since the last commit.
+static void _vdp_cache_commit() {
+    u8 write_hscroll = write_all;
+    if (write_all || requested_mode != written_mode) {
+        VDP_setScrollingMode(requested_mode, VSCROLL_PLANE);
+        // Back in plane mode, entry 0 of the table holds whatever a line table left there.
+        if (written_mode != HSCROLL_PLANE) write_hscroll = TRUE;
+        written_mode = requested_mode;
+        stats.committed++;
+    }
+    for (u16 i = 0; i < 2; i++) {
+        // In the line and tile modes the table is filled by its owner.
+        if (written_mode == HSCROLL_PLANE && (write_hscroll || requested.hscroll[i] != written.hscroll[i])) {
+            VDP_setHorizontalScroll(planes[i], requested.hscroll[i]);
+            written.hscroll[i] = requested.hscroll[i];
+            stats.committed++;
+        }
+        if (write_all || requested.vscroll[i] != written.vscroll[i]) {
+            VDP_setVerticalScroll(planes[i], requested.vscroll[i]);
+            written.vscroll[i] = requested.vscroll[i];
+            stats.committed++;
+        }
+    }
+    write_all = FALSE;
+}
+
+void vdp_cache_init() {
+    memset(&requested, 0, sizeof(requested));
+    memset(&written, 0, sizeof(written));
+    memset(&stats, 0, sizeof(stats));
+    requested_mode = HSCROLL_PLANE;
+    written_mode = HSCROLL_PLANE;
+    write_all = TRUE; // The VDP's actual values are unknown until written once
+    SYS_setVBlankCallback(_vdp_cache_commit);
+}
+
+void vdp_cache_set_hscroll_mode(u16 mode) {
+    if (mode != HSCROLL_PLANE && mode != HSCROLL_TILE && mode != HSCROLL_LINE) {
+        error_handler_display_error(MODULE_NAME_VDP_CACHE, __func__, __LINE__, "Invalid scroll mode!");
+        return;
+    }
+    requested_mode = mode;
+}
+
+u16 vdp_cache_get_hscroll_mode() {
+    return requested_mode;
+}
+
+void vdp_cache_set_hscroll(VDPPlane plane, s16 value) {
+    s16 slot = _vdp_cache_slot(plane, __func__, __LINE__);
+    if (slot >= 0) _vdp_cache_set(&requested.hscroll[slot], value);
+}
+
+void vdp_cache_set_vscroll(VDPPlane plane, s16 value) {
+    s16 slot = _vdp_cache_slot(plane, __func__, __LINE__);
+    if (slot >= 0) _vdp_cache_set(&requested.vscroll[slot], value);
+}
+
+s16 vdp_cache_get_hscroll(VDPPlane plane) {
+    s16 slot = _vdp_cache_slot(plane, __func__, __LINE__);
+    return (slot >= 0) ? requested.hscroll[slot] : 0;
+}
+
+s16 vdp_cache_get_vscroll(VDPPlane plane) {
+    s16 slot = _vdp_cache_slot(plane, __func__, __LINE__);
+    return (slot >= 0) ? requested.vscroll[slot] : 0;
+}
+
+const VdpCacheStats* vdp_cache_get_stats() {
+    return &stats;
+}
+
+void vdp_cache_dump_klog() {
+    char line_buf[80];
+    sprintf(line_buf, "VDPC requested=%lu dropped=%lu committed=%lu", stats.requested, stats.dropped, stats.committed);
+    KLog(line_buf);
+}
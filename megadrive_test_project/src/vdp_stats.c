@@ -0,0 +1,198 @@
+/**
+ * @file vdp_stats.c
+ * @brief Implements per-module VDP traffic accounting.
+ *
+ * The hot path (`vdp_stats_add()`) only bumps the counters of the caller's
+ * slot; module names are derived once, when a file makes its first VDP call.
+ * Everything else happens once per frame in `vdp_stats_end_frame()`.
+ */
+#include "vdp_stats.h"
+
+#if VDP_STATS_ENABLED
+
+#include "input.h"         // For the overlay toggle button
+#include "error_handler.h" // For reporting a bad module index
+#include <string.h>        // For memset, sprintf
+
+// The overlay's own text must not be counted, so call the real SGDK functions here.
+#undef VDP_drawText
+#undef VDP_clearText
+
+// Module name for error reporting
+#define MODULE_NAME_VDP_STATS "vdp_stats"
+
+/** @brief Text row used by the overlay, right below the profiler's. */
+#define VDP_STATS_OVERLAY_ROW 1
+/** @brief The overlay is redrawn every N frames to keep its own VDP cost low. */
+#define VDP_STATS_OVERLAY_INTERVAL 10
+/** @brief Longest module name kept, e.g. "dialogue" for dialogue_engine.c. */
+#define VDP_STATS_NAME_LENGTH 8
+
+static VdpStatsModule modules[VDP_STATS_MAX_MODULES];
+static char module_names[VDP_STATS_MAX_MODULES][VDP_STATS_NAME_LENGTH + 1];
+static u16 module_count = 0;
+static u32 frame_count = 0;
+static u16 last_queue_bytes = 0;
+static u8 overlay_visible = FALSE;
+static u16 overlay_timer = 0;
+
+void vdp_stats_init() {
+    memset(modules, 0, sizeof(modules));
+    module_count = 0;
+    frame_count = 0;
+    last_queue_bytes = 0;
+    overlay_visible = FALSE;
+    overlay_timer = 0;
+}
+
+// "src/dialogue_engine.c" -> "dialogue"
+static const char* _vdp_stats_make_name(u16 index, const char* file) {
+    const char* base = file;
+    for (const char* p = file; *p != '\0'; p++) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    u16 length = 0;
+    while (base[length] != '\0' && base[length] != '.' && length < VDP_STATS_NAME_LENGTH) {
+        module_names[index][length] = base[length];
+        length++;
+    }
+    module_names[index][length] = '\0';
+    return module_names[index];
+}
+
+// Each source file has its own slot variable, so this runs once per file. Files
+// past the table share the last slot; reporting them would re-enter the wrappers.
+static u8 _vdp_stats_register(const char* file) {
+    if (module_count >= VDP_STATS_MAX_MODULES - 1) {
+        if (module_count < VDP_STATS_MAX_MODULES) {
+            modules[module_count].name = _vdp_stats_make_name(module_count, "other");
+            module_count++;
+        }
+        return VDP_STATS_MAX_MODULES - 1;
+    }
+    modules[module_count].name = _vdp_stats_make_name(module_count, file);
+    return module_count++;
+}
+
+void vdp_stats_add(u8* module_slot, const char* file, VdpStatsTarget target, u32 words, TransferMethod tm) {
+    if (*module_slot == VDP_STATS_UNREGISTERED) {
+        *module_slot = _vdp_stats_register(file);
+        if (*module_slot == VDP_STATS_UNREGISTERED) return;
+    }
+
+    VdpStatsCounters* frame = &modules[*module_slot].frame;
+    frame->calls++;
+    switch (target) {
+        case VDP_STATS_VRAM: frame->vram_words += words; break;
+        case VDP_STATS_CRAM: frame->cram_words += words; break;
+        case VDP_STATS_VSRAM: frame->vsram_words += words; break;
+        default: break;
+    }
+    if (tm == DMA_QUEUE || tm == DMA_QUEUE_COPY) frame->dma_bytes += words * 2;
+}
+
+static u32 _vdp_stats_words(const VdpStatsCounters* counters) {
+    return counters->vram_words + counters->cram_words + counters->vsram_words;
+}
+
+static void _vdp_stats_draw_overlay() {
+    VdpStatsCounters sum;
+    const char* top_name = "-";
+    u32 top_words = 0;
+    char line_buf[41];
+
+    memset(&sum, 0, sizeof(sum));
+    for (u16 i = 0; i < module_count; i++) {
+        const VdpStatsCounters* last = &modules[i].last;
+        sum.calls += last->calls;
+        sum.vram_words += last->vram_words;
+        sum.cram_words += last->cram_words;
+        sum.vsram_words += last->vsram_words;
+        if (_vdp_stats_words(last) > top_words) {
+            top_words = _vdp_stats_words(last);
+            top_name = modules[i].name;
+        }
+    }
+
+    // e.g. "VDP n 12 V  480 C  3 S 1 Q 1024 menu"
+    sprintf(line_buf, "VDP n%3lu V%5lu C%3lu S%2lu Q%5u %s", sum.calls, sum.vram_words, sum.cram_words,
+            sum.vsram_words, last_queue_bytes, top_name);
+    // Drawn during active display, maybe under raster effects: keep the
+    // H-int out of the port writes (see raster_fx.h).
+    SYS_disableInts();
+    VDP_clearText(0, VDP_STATS_OVERLAY_ROW, 40);
+    VDP_drawText(line_buf, 0, VDP_STATS_OVERLAY_ROW);
+    SYS_enableInts();
+}
+
+void vdp_stats_end_frame() {
+    last_queue_bytes = DMA_getQueueTransferSize();
+
+    for (u16 i = 0; i < module_count; i++) {
+        VdpStatsModule* module = &modules[i];
+        module->last = module->frame;
+        module->total.calls += module->frame.calls;
+        module->total.vram_words += module->frame.vram_words;
+        module->total.cram_words += module->frame.cram_words;
+        module->total.vsram_words += module->frame.vsram_words;
+        module->total.dma_bytes += module->frame.dma_bytes;
+        if (_vdp_stats_words(&module->frame) > _vdp_stats_words(&module->peak)) module->peak = module->frame;
+        memset(&module->frame, 0, sizeof(module->frame));
+    }
+    frame_count++;
+
+    if (input_is_just_pressed(VDP_STATS_OVERLAY_BUTTON)) {
+        overlay_visible = !overlay_visible;
+        overlay_timer = 0;
+        if (!overlay_visible) {
+            SYS_disableInts(); // As in _vdp_stats_draw_overlay()
+            VDP_clearText(0, VDP_STATS_OVERLAY_ROW, 40);
+            SYS_enableInts();
+        }
+        vdp_stats_dump_klog();
+    }
+
+    if (overlay_visible) {
+        if (overlay_timer == 0) _vdp_stats_draw_overlay();
+        overlay_timer = (overlay_timer + 1) % VDP_STATS_OVERLAY_INTERVAL;
+    }
+}
+
+u16 vdp_stats_get_module_count() {
+    return module_count;
+}
+
+const VdpStatsModule* vdp_stats_get_module(u16 index) {
+    if (index >= module_count) {
+        error_handler_display_error(MODULE_NAME_VDP_STATS, __func__, __LINE__, "Module index out of range!");
+        return NULL;
+    }
+    return &modules[index];
+}
+
+u32 vdp_stats_get_frame_count() {
+    return frame_count;
+}
+
+u16 vdp_stats_get_last_queue_bytes() {
+    return last_queue_bytes;
+}
+
+void vdp_stats_dump_klog() {
+    char line_buf[100];
+
+    // Totals since startup (divide by frames for per-frame averages), then the worst frame.
+    sprintf(line_buf, "VDPS_BEGIN frames=%lu", frame_count);
+    KLog(line_buf);
+    for (u16 i = 0; i < module_count; i++) {
+        const VdpStatsModule* module = &modules[i];
+        sprintf(line_buf, "VDPS %s calls=%lu vram=%lu cram=%lu vsram=%lu dmaq=%lu peak_words=%lu peak_calls=%lu",
+                module->name, module->total.calls, module->total.vram_words, module->total.cram_words,
+                module->total.vsram_words, module->total.dma_bytes, _vdp_stats_words(&module->peak),
+                module->peak.calls);
+        KLog(line_buf);
+    }
+    KLog("VDPS_END");
+}
+
+#endif // VDP_STATS_ENABLED
@@ -0,0 +1,195 @@
+/**
+ * @file vram_alloc.c
+ * @brief Implements the ref-counted VRAM tile allocator.
+ *
+ * The ranges are kept in an array sorted by tile index, so the free blocks are
+ * the gaps between neighbours. Allocation is first-fit over those gaps.
+ */
+#include "vram_alloc.h"
+#include "dma_scheduler.h" // For dma_scheduler_load_tileset()
+#include "watermark.h"     // For WATERMARK_TILES()
+#include "error_handler.h" // For reporting failed requests
+#include <string.h>        // For memset, memmove, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_VRAM_ALLOC "vram_alloc"
+
+static VramAllocEntry entries[VRAM_ALLOC_MAX_ENTRIES];
+static u16 entry_count = 0;
+static u32 use_counter = 0;  // Advances on every acquire and release; orders entries for LRU
+static VramAllocStats stats;
+
+static s16 _vram_alloc_find(const void* key) {
+    for (u16 i = 0; i < entry_count; i++) {
+        if (entries[i].key == key) return i;
+    }
+    return -1;
+}
+
+// First free block of at least `num` tiles; returns its first tile index or VRAM_ALLOC_FAILED.
+static u16 _vram_alloc_find_gap(u16 num) {
+    u16 gap_start = VRAM_ALLOC_FIRST_INDEX;
+
+    for (u16 i = 0; i < entry_count; i++) {
+        if (entries[i].index - gap_start >= num) return gap_start;
+        gap_start = entries[i].index + entries[i].num;
+    }
+    return (VRAM_ALLOC_END_INDEX - gap_start >= num) ? gap_start : VRAM_ALLOC_FAILED;
+}
+
+static void _vram_alloc_remove(u16 i) {
+    memmove(&entries[i], &entries[i + 1], (entry_count - i - 1) * sizeof(VramAllocEntry));
+    entry_count--;
+}
+
+// Evicts the least recently used unreferenced range. Returns FALSE if every range is held.
+static u8 _vram_alloc_evict_lru() {
+    s16 victim = -1;
+
+    for (u16 i = 0; i < entry_count; i++) {
+        if (entries[i].refs != 0) continue;
+        if (victim < 0 || entries[i].last_use < entries[victim].last_use) victim = i;
+    }
+    if (victim < 0) return FALSE;
+
+    _vram_alloc_remove(victim);
+    stats.evictions++;
+    return TRUE;
+}
+
+static void _vram_alloc_insert(const void* key, u16 index, u16 num) {
+    u16 pos = 0;
+    while (pos < entry_count && entries[pos].index < index) pos++;
+    memmove(&entries[pos + 1], &entries[pos], (entry_count - pos) * sizeof(VramAllocEntry));
+    entry_count++;
+
+    VramAllocEntry* entry = &entries[pos];
+    entry->key = key;
+    entry->index = index;
+    entry->num = num;
+    entry->refs = 1;
+    entry->last_use = ++use_counter;
+}
+
+void vram_alloc_init() {
+    memset(entries, 0, sizeof(entries));
+    entry_count = 0;
+    use_counter = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+u16 vram_alloc_acquire(const void* key, u16 num, u8* resident) {
+    if (resident) *resident = FALSE;
+    if (key == NULL || num == 0) {
+        error_handler_display_error(MODULE_NAME_VRAM_ALLOC, __func__, __LINE__, "Invalid request!");
+        return VRAM_ALLOC_FAILED;
+    }
+
+    s16 found = _vram_alloc_find(key);
+    if (found >= 0) {
+        VramAllocEntry* entry = &entries[found];
+        if (entry->num != num) {
+            error_handler_display_error(MODULE_NAME_VRAM_ALLOC, __func__, __LINE__, "Size differs from resident!");
+            return VRAM_ALLOC_FAILED;
+        }
+        entry->refs++;
+        entry->last_use = ++use_counter;
+        stats.hits++;
+        if (resident) *resident = TRUE;
+        WATERMARK_TILES(entry->index, num); // The state still uses these tiles
+        return entry->index;
+    }
+
+    stats.misses++;
+    u16 index = _vram_alloc_find_gap(num);
+    // Make room: evict unreferenced ranges, oldest first, until a block is large enough.
+    while (index == VRAM_ALLOC_FAILED || entry_count >= VRAM_ALLOC_MAX_ENTRIES) {
+        if (!_vram_alloc_evict_lru()) {
+            stats.failures++;
+            error_handler_display_error(MODULE_NAME_VRAM_ALLOC, __func__, __LINE__, "VRAM full!");
+            return VRAM_ALLOC_FAILED;
+        }
+        index = _vram_alloc_find_gap(num);
+    }
+
+    _vram_alloc_insert(key, index, num);
+    WATERMARK_TILES(index, num);
+    return index;
+}
+
+u16 vram_alloc_acquire_tileset(const TileSet* tileset) {
+    u8 resident;
+    u16 index = vram_alloc_acquire(tileset, tileset->numTile, &resident);
+
+    if (index == VRAM_ALLOC_FAILED) return index;
+    if (resident) {
+        stats.tiles_skipped += tileset->numTile;
+    } else {
+        dma_scheduler_load_tileset(tileset, index);
+        stats.tiles_uploaded += tileset->numTile;
+    }
+    return index;
+}
+
+void vram_alloc_release(const void* key) {
+    s16 found = _vram_alloc_find(key);
+    if (found < 0 || entries[found].refs == 0) {
+        error_handler_display_error(MODULE_NAME_VRAM_ALLOC, __func__, __LINE__, "Release without acquire!");
+        return;
+    }
+    entries[found].refs--;
+    entries[found].last_use = ++use_counter;
+}
+
+u16 vram_alloc_get_entry_count() {
+    return entry_count;
+}
+
+const VramAllocEntry* vram_alloc_get_entry(u16 i) {
+    return (i < entry_count) ? &entries[i] : NULL;
+}
+
+const VramAllocStats* vram_alloc_get_stats() {
+    u16 gap_start = VRAM_ALLOC_FIRST_INDEX;
+
+    stats.total_tiles = VRAM_ALLOC_END_INDEX - VRAM_ALLOC_FIRST_INDEX;
+    stats.used_tiles = 0;
+    stats.referenced_tiles = 0;
+    stats.largest_free = 0;
+    stats.free_blocks = 0;
+    stats.entries = entry_count;
+
+    // Walk the gaps between the sorted ranges, plus the one after the last range.
+    for (u16 i = 0; i <= entry_count; i++) {
+        u16 gap_end = (i < entry_count) ? entries[i].index : VRAM_ALLOC_END_INDEX;
+        u16 gap = gap_end - gap_start;
+        if (gap != 0) {
+            stats.free_blocks++;
+            if (gap > stats.largest_free) stats.largest_free = gap;
+        }
+        if (i == entry_count) break;
+
+        stats.used_tiles += entries[i].num;
+        if (entries[i].refs != 0) stats.referenced_tiles += entries[i].num;
+        gap_start = entries[i].index + entries[i].num;
+    }
+
+    stats.free_tiles = stats.total_tiles - stats.used_tiles;
+    stats.fragmentation = stats.free_tiles ? (u16)(((u32)(stats.free_tiles - stats.largest_free) * 100) / stats.free_tiles) : 0;
+    return &stats;
+}
+
+void vram_alloc_dump_klog() {
+    char line_buf[160];
+    const VramAllocStats* s = vram_alloc_get_stats();
+
+    sprintf(line_buf, "VRAM total=%u used=%u referenced=%u free=%u largest_free=%u free_blocks=%u frag=%u "
+            "ranges=%u hits=%lu misses=%lu evictions=%lu uploaded=%lu skipped=%lu failures=%u", s->total_tiles,
+            s->used_tiles, s->referenced_tiles, s->free_tiles, s->largest_free, s->free_blocks, s->fragmentation,
+            s->entries, s->hits, s->misses, s->evictions, s->tiles_uploaded, s->tiles_skipped, s->failures);
+    KLog(line_buf);
+    for (u16 i = 0; i < entry_count; i++) {
+        sprintf(line_buf, "VRAM_RANGE index=%u tiles=%u refs=%u", entries[i].index, entries[i].num, entries[i].refs);
+        KLog(line_buf);
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file watermark.c
+ * @brief Implements the runtime memory high-water marks.
+ */
+#include "watermark.h"
+
+#if WATERMARK_ENABLED
+
+#include "error_handler.h" // For reporting an invalid state
+#include <string.h>        // For memset, sprintf
+
+// Module name for error reporting
+#define MODULE_NAME_WATERMARK "watermark"
+
+/** @brief Byte written over the painted stack. */
+#define WATERMARK_STACK_PATTERN 0xA5
+/** @brief Bytes left unpainted right below watermark_init()'s own frame (memset's frame lives there). */
+#define WATERMARK_STACK_MARGIN 128
+
+static u8* stack_low = NULL;   // Lowest painted byte
+static u8* stack_high = NULL;  // One past the highest painted byte
+static u16 min_free = 0xFFFF;
+static u16 frame_max_tile = 0; // Highest tile uploaded this frame (0 = none)
+static u16 state_max_tile[WATERMARK_MAX_STATES];
+static const char* const* names = NULL;
+static u16 state_count = 0;
+
+void watermark_init(const char* const* state_names, u16 count) {
+    if (count > WATERMARK_MAX_STATES) {
+        error_handler_display_error(MODULE_NAME_WATERMARK, __func__, __LINE__, "Too many states!");
+        return;
+    }
+    names = state_names;
+    state_count = count;
+    memset(state_max_tile, 0, sizeof(state_max_tile));
+    frame_max_tile = 0;
+    min_free = MEM_getFree();
+
+    // The frame address is close enough to the stack pointer: the stack grows
+    // down from here, so everything below it is unused.
+    stack_high = (u8*)__builtin_frame_address(0) - WATERMARK_STACK_MARGIN;
+    stack_low = stack_high - WATERMARK_STACK_BYTES;
+    memset(stack_low, WATERMARK_STACK_PATTERN, WATERMARK_STACK_BYTES);
+}
+
+void watermark_note_tiles(u16 first_index, u16 count) {
+    if (count == 0) return;
+    u16 last = first_index + count - 1;
+    if (last > frame_max_tile) frame_max_tile = last;
+}
+
+void watermark_end_frame(u16 state) {
+    u16 free = MEM_getFree();
+    if (free < min_free) min_free = free;
+
+    if (state >= state_count) {
+        error_handler_display_error(MODULE_NAME_WATERMARK, __func__, __LINE__, "State out of range!");
+        return;
+    }
+    if (frame_max_tile > state_max_tile[state]) state_max_tile[state] = frame_max_tile;
+    frame_max_tile = 0;
+}
+
+u16 watermark_get_stack_used() {
+    if (stack_low == NULL) return 0;
+    // Scan up from the bottom: the first overwritten byte is the deepest the stack reached.
+    const u8* p = stack_low;
+    while (p < stack_high && *p == WATERMARK_STACK_PATTERN) p++;
+    if (p == stack_high) return 0;
+    return (stack_high - p) + WATERMARK_STACK_MARGIN;
+}
+
+u16 watermark_get_min_free() {
+    return min_free;
+}
+
+u16 watermark_get_state_count() {
+    return state_count;
+}
+
+const char* watermark_get_state_name(u16 state) {
+    return (state < state_count) ? names[state] : "?";
+}
+
+u16 watermark_get_state_max_tile(u16 state) {
+    return (state < state_count) ? state_max_tile[state] : 0;
+}
+
+void watermark_dump_klog() {
+    char line_buf[80];
+    u16 used = watermark_get_stack_used();
+
+    // "+" marks a stack that used every painted byte and may have gone deeper.
+    sprintf(line_buf, "WM stack_used=%u%s stack_painted=%u heap_free_min=%u heap_free_now=%u", used,
+            (used >= WATERMARK_STACK_BYTES + WATERMARK_STACK_MARGIN) ? "+" : "",
+            WATERMARK_STACK_BYTES + WATERMARK_STACK_MARGIN, min_free, MEM_getFree());
+    KLog(line_buf);
+    for (u16 i = 0; i < state_count; i++) {
+        if (state_max_tile[i] == 0) continue;
+        sprintf(line_buf, "WM_TILES state=%s max_tile=%u limit=%u", names[i], state_max_tile[i],
+                TILE_FONT_INDEX - 1);
+        KLog(line_buf);
+    }
+}
+
+#endif // WATERMARK_ENABLED
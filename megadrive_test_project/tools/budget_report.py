@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""Report ROM and RAM usage per object, per resource and per module from a link map.
+
+Every ROM link writes a GNU ld map file next to the ROM (out/rom.map). This
+tool reads the map's "Linker script and memory map" section and sums the input
+sections of every object file into:
+
+    ROM   .text / .rodata (code and constants) plus the load image of .data
+    RAM   .data (initialized variables) and .bss / COMMON (zeroed variables)
+
+It then prints the totals against the hardware limits, the largest ROM users
+per object, the ROM used by each resource declared in resources.res, and the
+static RAM used by each module. SGDK library members are shown as
+`libmd.a(member.o)`.
+
+Resource sizes are found from the symbols the map lists for resources.o: each
+symbol extends to the next symbol (or the end of its section) and is charged
+to the resource whose name it contains. Bytes that match no resource name are
+reported as unattributed.
+
+Usage:
+    budget_report.py --map out/rom.map --res res/resources.res [--top 20]
+    budget_report.py --map out/rom.map --rom-limit 0x100000   # 1MB cartridge
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_ROM_LIMIT = 0x400000  # 4MB, the largest cartridge without a mapper
+DEFAULT_RAM_LIMIT = 0x10000   # 64KB of 68000 work RAM
+
+MAP_START = "Linker script and memory map"
+OUTPUT_SECTION_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+INPUT_SECTION_RE = re.compile(r"^ (\.\S+|COMMON)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+INPUT_SECTION_NAME_RE = re.compile(r"^ (\.\S+|COMMON)\s*$")
+WRAPPED_INPUT_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)\s*$")
+RESOURCE_RE = re.compile(r"^\s*([A-Z_0-9]+)\s+(\w+)\s")
+
+
+def classify(output_section):
+    """Returns 'rom', 'data' or 'bss' for an output section name, or None to ignore it."""
+    if output_section.startswith((".text", ".rodata", ".init", ".fini", ".ctors", ".dtors")):
+        return "rom"
+    if output_section.startswith(".data"):
+        return "data"
+    if output_section.startswith((".bss", "COMMON")):
+        return "bss"
+    return None
+
+
+def parse_map(lines):
+    """Returns a list of input sections and a list of symbols from a GNU ld map.
+
+    Input sections are dicts with kind, address, size and object; symbols are
+    (address, name) tuples.
+    """
+    sections = []
+    symbols = []
+    in_map = False
+    kind = None
+    pending_name = None
+
+    for raw_line in lines:
+        line = raw_line.rstrip("\n")
+        if not in_map:
+            in_map = line.startswith(MAP_START)
+            continue
+
+        match = OUTPUT_SECTION_RE.match(line)
+        if match:
+            kind = classify(match.group(1))
+            pending_name = None
+            continue
+        if line.startswith(".") and line.strip().startswith("."):
+            # Output section whose address is on the next line (long name).
+            kind = classify(line.split()[0])
+            pending_name = None
+            continue
+
+        match = INPUT_SECTION_RE.match(line)
+        if match:
+            name, address, size, obj = match.groups()
+            pending_name = None
+        else:
+            match = INPUT_SECTION_NAME_RE.match(line)
+            if match:
+                pending_name = match.group(1)
+                continue
+            match = WRAPPED_INPUT_RE.match(line) if pending_name else None
+            if match:
+                name = pending_name
+                address, size, obj = match.groups()
+                pending_name = None
+            else:
+                match = SYMBOL_RE.match(line)
+                if match and "=" not in line and kind is not None:
+                    symbols.append((int(match.group(1), 16), match.group(2)))
+                continue
+
+        section_kind = "bss" if name == "COMMON" else kind
+        if section_kind is None or int(size, 16) == 0:
+            continue
+        sections.append({
+            "kind": section_kind,
+            "name": name,
+            "address": int(address, 16),
+            "size": int(size, 16),
+            "object": obj.strip(),
+        })
+    return sections, symbols
+
+
+def object_label(path):
+    """Shortens an object path: obj/main.o -> main.o, /x/libmd.a(vdp.o) -> libmd.a(vdp.o)."""
+    if "(" in path and path.endswith(")"):
+        archive, member = path[:-1].split("(", 1)
+        return "%s(%s)" % (os.path.basename(archive), member)
+    return os.path.basename(path)
+
+
+def sum_by_object(sections):
+    """Returns {object_label: {'rom': n, 'data': n, 'bss': n}}."""
+    totals = {}
+    for section in sections:
+        entry = totals.setdefault(object_label(section["object"]), {"rom": 0, "data": 0, "bss": 0})
+        entry[section["kind"]] += section["size"]
+    return totals
+
+
+def parse_resources(lines):
+    """Returns a list of (type, name) from a rescomp .res file."""
+    resources = []
+    for line in lines:
+        if line.lstrip().startswith("#"):
+            continue
+        match = RESOURCE_RE.match(line)
+        if match:
+            resources.append((match.group(1), match.group(2)))
+    return resources
+
+
+def resource_sizes(sections, symbols, resources):
+    """Charges the ROM bytes of resources.o to the resources declared in the .res file.
+
+    Returns ({resource_name: bytes}, unattributed_bytes).
+    """
+    sizes = {name: 0 for _, name in resources}
+    unattributed = 0
+    names = sorted((name for _, name in resources), key=len, reverse=True)  # Longest match first
+    symbols = sorted(symbols)
+
+    for section in sections:
+        if object_label(section["object"]) != "resources.o" or section["kind"] == "bss":
+            continue
+        start = section["address"]
+        end = start + section["size"]
+        inside = [(address, name) for address, name in symbols if start <= address < end]
+        covered = start
+        for index, (address, name) in enumerate(inside):
+            if address > covered:
+                unattributed += address - covered  # Bytes before the first symbol
+            next_address = inside[index + 1][0] if index + 1 < len(inside) else end
+            owner = next((resource for resource in names if resource in name), None)
+            if owner is None:
+                unattributed += next_address - address
+            else:
+                sizes[owner] += next_address - address
+            covered = next_address
+        if covered < end:
+            unattributed += end - covered
+    return sizes, unattributed
+
+
+def percent(value, limit):
+    return 100.0 * value / limit if limit else 0.0
+
+
+def print_report(totals, resources, res_sizes, unattributed, rom_limit, ram_limit, top, out):
+    rom_code = sum(entry["rom"] for entry in totals.values())
+    data = sum(entry["data"] for entry in totals.values())
+    bss = sum(entry["bss"] for entry in totals.values())
+    rom_total = rom_code + data  # .data is copied from ROM at startup
+    ram_total = data + bss
+
+    out.write("ROM: %8d / %d bytes (%5.1f%%)  code+const %d, data image %d\n"
+              % (rom_total, rom_limit, percent(rom_total, rom_limit), rom_code, data))
+    out.write("RAM: %8d / %d bytes (%5.1f%%)  data %d, bss %d (static only; heap and stack use the rest)\n\n"
+              % (ram_total, ram_limit, percent(ram_total, ram_limit), data, bss))
+
+    out.write("ROM by object (top %d)%s  bytes   %%ROM\n" % (top, " " * 19))
+    by_rom = sorted(totals.items(), key=lambda item: item[1]["rom"] + item[1]["data"], reverse=True)
+    for label, entry in by_rom[:top]:
+        size = entry["rom"] + entry["data"]
+        if size == 0:
+            break
+        out.write("  %-38s %7d %6.2f\n" % (label, size, percent(size, rom_total)))
+    out.write("\n")
+
+    if resources:
+        out.write("ROM by resource (resources.res)%s  bytes   %%ROM\n" % (" " * 9))
+        for res_type, name in sorted(resources, key=lambda res: res_sizes.get(res[1], 0), reverse=True):
+            size = res_sizes.get(name, 0)
+            out.write("  %-24s %-13s %7d %6.2f\n" % (name, res_type, size, percent(size, rom_total)))
+        if unattributed:
+            out.write("  %-38s %7d %6.2f\n" % ("(unattributed resource data)", unattributed,
+                                               percent(unattributed, rom_total)))
+        out.write("\n")
+
+    out.write("Static RAM by module%s   data    bss  total\n" % (" " * 19))
+    by_ram = sorted(totals.items(), key=lambda item: item[1]["data"] + item[1]["bss"], reverse=True)
+    for label, entry in by_ram:
+        size = entry["data"] + entry["bss"]
+        if size == 0:
+            break
+        out.write("  %-38s %6d %6d %6d\n" % (label, entry["data"], entry["bss"], size))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--map", required=True, help="GNU ld map file written by the ROM link")
+    parser.add_argument("--res", help="rescomp resource file, for the per-resource table")
+    parser.add_argument("--top", type=int, default=20, help="number of objects in the ROM table")
+    parser.add_argument("--rom-limit", type=lambda value: int(value, 0), default=DEFAULT_ROM_LIMIT,
+                        help="cartridge size in bytes (default 4MB)")
+    parser.add_argument("--ram-limit", type=lambda value: int(value, 0), default=DEFAULT_RAM_LIMIT,
+                        help="work RAM size in bytes (default 64KB)")
+    args = parser.parse_args()
+
+    try:
+        with open(args.map) as map_file:
+            sections, symbols = parse_map(map_file)
+    except OSError as error:
+        sys.exit("budget_report: cannot read map file: %s" % error)
+    if not sections:
+        sys.exit("budget_report: no sections found in %s (is it a GNU ld map?)" % args.map)
+
+    resources = []
+    if args.res:
+        try:
+            with open(args.res) as res_file:
+                resources = parse_resources(res_file)
+        except OSError as error:
+            sys.exit("budget_report: cannot read resource file: %s" % error)
+
+    totals = sum_by_object(sections)
+    res_sizes, unattributed = resource_sizes(sections, symbols, resources)
+    print_report(totals, resources, res_sizes, unattributed, args.rom_limit, args.ram_limit, args.top,
+                 sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
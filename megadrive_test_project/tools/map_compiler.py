@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Compile tilemap sources into ready-to-write map assets, packed or as metatiles.
+
+Reads a map definition file (res/maps.res) whose lines look like rescomp's:
+
+    MAP name "file" PALETTE PRIORITY BASE COMPRESSION
+    METATILE name "file" PALETTE PRIORITY BASE BLOCK
+
+    name         C name of the generated MapAsset.
+    file         Map source, relative to the definition file: a CSV file (one
+                 row of tile numbers per line) or a Tiled .tmx map whose first
+                 layer is stored with CSV encoding.
+    PALETTE      PAL0 to PAL3.
+    PRIORITY     TRUE or FALSE.
+    BASE         Tile index added to every tile number (decimal or 0x...).
+    COMPRESSION  NONE, or WLZ for the word LZ format unpacked by map_asset.c.
+    BLOCK        16 or 32: metatile size in pixels.
+
+Each map cell becomes a full VDP tilemap entry, TILE_ATTR_FULL(palette,
+priority, vflip, hflip, base + tile), so loading a map needs no per-cell work
+beyond unpacking. Tiled's horizontal and vertical flip flags are kept; its
+diagonal flag has no VDP equivalent and is rejected. Empty Tiled cells (gid 0)
+become tile 0.
+
+A MAP becomes a MapAsset (map_asset.h). A METATILE map is cut into 16x16 or
+32x32 pixel blocks; identical blocks are stored once in a dictionary of
+tilemap entries, and the map becomes one u8 block index per block, decoded a
+row or column at a time by metatile.c.
+
+Writes a C source with the data and a header declaring one asset per map, with
+NAME_WIDTH / NAME_HEIGHT macros (in tiles) for code that needs the size at
+compile time.
+
+WLZ stream (16-bit words, big-endian on the Mega Drive as any u16 array):
+    0x0000-0x7FFF  literal run: that many words follow and are copied as-is
+    0x8000-0xFFFF  match: copy ((token >> 10) & 0x1F) + 2 words starting
+                   (token & 0x3FF) + 1 words back in the output (may overlap)
+
+Usage:
+    map_compiler.py --res res/maps.res --header inc/maps.h --source src/maps.c
+"""
+
+import argparse
+import csv
+import os
+import re
+import shlex
+import sys
+import xml.etree.ElementTree as ElementTree
+
+TILE_INDEX_MASK = 0x7FF
+TILED_FLIP_H = 0x80000000
+TILED_FLIP_V = 0x40000000
+TILED_FLIP_D = 0x20000000
+
+WLZ_MIN_MATCH = 2
+WLZ_MAX_MATCH = 33      # 5-bit length field + WLZ_MIN_MATCH
+WLZ_WINDOW = 1024       # 10-bit offset field + 1
+WLZ_MAX_LITERALS = 0x7FFF
+
+COMPRESSIONS = ("NONE", "WLZ")
+BLOCK_SHIFTS = {"16": 1, "32": 2}  # Block size in pixels -> log2 of its side in tiles
+METATILE_MAX_BLOCKS = 256          # Block indices are u8
+NAME_RE = re.compile(r"^[A-Za-z_]\w*$")
+
+
+class MapError(Exception):
+    pass
+
+
+def parse_definitions(path):
+    """Returns a list of dicts (name, file, palette, priority, base, compression) from a .res file."""
+    maps = []
+    with open(path) as res_file:
+        for line_number, line in enumerate(res_file, 1):
+            stripped = line.strip()
+            if not stripped or stripped.startswith("#"):
+                continue
+            where = "%s:%d" % (path, line_number)
+            fields = shlex.split(stripped)
+            if fields[0] not in ("MAP", "METATILE"):
+                raise MapError("%s: unknown resource type %s" % (where, fields[0]))
+            if len(fields) != 7:
+                last = "COMPRESSION" if fields[0] == "MAP" else "BLOCK"
+                raise MapError("%s: expected %s name \"file\" PALETTE PRIORITY BASE %s" % (where, fields[0], last))
+            kind, name, file_name, palette, priority, base, last = fields
+            if not NAME_RE.match(name):
+                raise MapError("%s: invalid name %s" % (where, name))
+            if palette not in ("PAL0", "PAL1", "PAL2", "PAL3"):
+                raise MapError("%s: palette must be PAL0 to PAL3" % where)
+            if priority not in ("TRUE", "FALSE"):
+                raise MapError("%s: priority must be TRUE or FALSE" % where)
+            if kind == "MAP" and last not in COMPRESSIONS:
+                raise MapError("%s: compression must be one of %s" % (where, ", ".join(COMPRESSIONS)))
+            if kind == "METATILE" and last not in BLOCK_SHIFTS:
+                raise MapError("%s: block size must be 16 or 32" % where)
+            try:
+                base_index = int(base, 0)
+            except ValueError:
+                raise MapError("%s: invalid base %s" % (where, base))
+            maps.append({
+                "kind": kind,
+                "name": name,
+                "file": os.path.join(os.path.dirname(path), file_name),
+                "palette": int(palette[3]),
+                "priority": priority == "TRUE",
+                "base": base_index,
+                "compression": last if kind == "MAP" else None,
+                "block_shift": BLOCK_SHIFTS[last] if kind == "METATILE" else None,
+            })
+    return maps
+
+
+def read_csv(path):
+    """Returns the cells of a CSV map as rows of (tile, hflip, vflip)."""
+    rows = []
+    with open(path, newline="") as csv_file:
+        for record in csv.reader(csv_file):
+            values = [value.strip() for value in record if value.strip()]
+            if values:
+                rows.append([(int(value), False, False) for value in values])
+    return rows
+
+
+def read_tmx(path):
+    """Returns the cells of the first layer of a Tiled map as rows of (tile, hflip, vflip)."""
+    root = ElementTree.parse(path).getroot()
+    tileset = root.find("tileset")
+    first_gid = int(tileset.get("firstgid", "1")) if tileset is not None else 1
+    layer = root.find("layer")
+    if layer is None:
+        raise MapError("%s: no tile layer" % path)
+    data = layer.find("data")
+    if data is None or data.get("encoding") != "csv":
+        raise MapError("%s: the layer must use CSV encoding" % path)
+
+    width = int(layer.get("width"))
+    gids = [int(value) for value in data.text.replace("\n", "").split(",") if value.strip()]
+    cells = []
+    for gid in gids:
+        if gid & TILED_FLIP_D:
+            raise MapError("%s: diagonally flipped tiles cannot be drawn by the VDP" % path)
+        tile = gid & ~(TILED_FLIP_H | TILED_FLIP_V | TILED_FLIP_D)
+        cells.append((tile - first_gid if tile else 0, bool(gid & TILED_FLIP_H), bool(gid & TILED_FLIP_V)))
+    return [cells[i:i + width] for i in range(0, len(cells), width)]
+
+
+def bake(entry):
+    """Returns (width, height, words) for a map entry, every word a full tilemap entry."""
+    path = entry["file"]
+    rows = read_tmx(path) if path.endswith(".tmx") else read_csv(path)
+    if not rows:
+        raise MapError("%s: empty map" % path)
+    width = len(rows[0])
+    for y, row in enumerate(rows):
+        if len(row) != width:
+            raise MapError("%s: row %d has %d cells, expected %d" % (path, y, len(row), width))
+
+    words = []
+    for row in rows:
+        for tile, hflip, vflip in row:
+            index = entry["base"] + tile
+            if tile < 0 or index > TILE_INDEX_MASK:
+                raise MapError("%s: tile %d out of range with base %d" % (path, tile, entry["base"]))
+            words.append((entry["priority"] << 15) | (entry["palette"] << 13) | (vflip << 12) | (hflip << 11)
+                         | index)
+    return width, len(rows), words
+
+
+def wlz_pack(words):
+    """Packs words into a WLZ stream (greedy longest match)."""
+    out = []
+    literals = []
+
+    def flush_literals():
+        while literals:
+            run = literals[:WLZ_MAX_LITERALS]
+            del literals[:WLZ_MAX_LITERALS]
+            out.append(len(run))
+            out.extend(run)
+
+    pos = 0
+    while pos < len(words):
+        best_len = 0
+        best_offset = 0
+        for offset in range(1, min(pos, WLZ_WINDOW) + 1):
+            length = 0
+            while (length < WLZ_MAX_MATCH and pos + length < len(words)
+                   and words[pos + length] == words[pos - offset + length]):
+                length += 1
+            if length > best_len:
+                best_len, best_offset = length, offset
+                if length == WLZ_MAX_MATCH:
+                    break
+        if best_len >= WLZ_MIN_MATCH:
+            flush_literals()
+            out.append(0x8000 | ((best_len - WLZ_MIN_MATCH) << 10) | (best_offset - 1))
+            pos += best_len
+        else:
+            literals.append(words[pos])
+            pos += 1
+    flush_literals()
+    return out
+
+
+def wlz_unpack(stream, count):
+    """Reference unpacker, used to check every packed map before it is written."""
+    out = []
+    pos = 0
+    while len(out) < count:
+        token = stream[pos]
+        pos += 1
+        if token & 0x8000:
+            start = len(out) - ((token & 0x3FF) + 1)
+            for i in range(((token >> 10) & 0x1F) + WLZ_MIN_MATCH):
+                out.append(out[start + i])
+        else:
+            out.extend(stream[pos:pos + token])
+            pos += token
+    return out
+
+
+def cut_metatiles(width, height, words, block_shift, path):
+    """Returns (blocks, layout): the unique blocks (tuples of words, row-major) and one index per block."""
+    side = 1 << block_shift
+    if width % side or height % side:
+        raise MapError("%s: %dx%d tiles is not a multiple of the %dx%d tile block" % (path, width, height,
+                                                                                   side, side))
+    blocks = []
+    block_ids = {}
+    layout = []
+    for block_y in range(0, height, side):
+        for block_x in range(0, width, side):
+            block = tuple(words[(block_y + j) * width + block_x + i] for j in range(side) for i in range(side))
+            if block not in block_ids:
+                block_ids[block] = len(blocks)
+                blocks.append(block)
+            layout.append(block_ids[block])
+    if len(blocks) > METATILE_MAX_BLOCKS:
+        raise MapError("%s: %d unique blocks, at most %d fit u8 indices" % (path, len(blocks),
+                                                                            METATILE_MAX_BLOCKS))
+    return blocks, layout
+
+
+def format_values(values, value_format="0x%04X", indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(value_format % value for value in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def write_outputs(maps, res_path, header_path, source_path):
+    guard = os.path.basename(header_path).upper().replace(".", "_")
+    header = [
+        "// Generated by tools/map_compiler.py from %s. Do not edit." % res_path,
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include \"map_asset.h\"",
+        "#include \"metatile.h\"",
+        "",
+    ]
+    source = [
+        "// Generated by tools/map_compiler.py from %s. Do not edit." % res_path,
+        "#include \"%s\"" % os.path.basename(header_path),
+        "",
+    ]
+
+    for entry in maps:
+        width, height, words = bake(entry)
+        name = entry["name"]
+        header.append("#define %s_WIDTH %d" % (name.upper(), width))
+        header.append("#define %s_HEIGHT %d" % (name.upper(), height))
+
+        if entry["kind"] == "METATILE":
+            shift = entry["block_shift"]
+            blocks, layout = cut_metatiles(width, height, words, shift, entry["file"])
+            block_words = [word for block in blocks for word in block]
+            header.append("extern const MetatileMap %s; // %d blocks + %d indices: %d bytes, %d as plain words" % (
+                name, len(blocks), len(layout), len(block_words) * 2 + len(layout), len(words) * 2))
+            source.append("static const u16 %s_blocks[%d] = {" % (name, len(block_words)))
+            source.append(format_values(block_words))
+            source.append("};")
+            source.append("static const u8 %s_layout[%d] = {" % (name, len(layout)))
+            source.append(format_values(layout, "%3d", per_line=width >> shift))
+            source.append("};")
+            source.append("const MetatileMap %s = { %d, %d, %d, %d, %d, %s_blocks, %s_layout };" % (
+                name, width >> shift, height >> shift, shift, entry["base"], len(blocks), name, name))
+        else:
+            data = words
+            if entry["compression"] == "WLZ":
+                data = wlz_pack(words)
+                if wlz_unpack(data, len(words)) != words:
+                    raise MapError("%s: packing check failed" % entry["file"])
+            header.append("extern const MapAsset %s; // %s, %d -> %d words" % (name, entry["compression"],
+                                                                              len(words), len(data)))
+            source.append("static const u16 %s_data[%d] = {" % (name, len(data)))
+            source.append(format_values(data))
+            source.append("};")
+            source.append("const MapAsset %s = { %d, %d, %d, MAP_ASSET_%s, %d, %s_data };" % (
+                name, width, height, entry["base"], entry["compression"], len(data), name))
+        header.append("")
+        source.append("")
+
+    header.append("#endif // %s" % guard)
+    for path, lines in ((header_path, header), (source_path, source)):
+        with open(path, "w") as out_file:
+            out_file.write("\n".join(lines) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--res", required=True, help="map definition file")
+    parser.add_argument("--header", required=True, help="C header to write")
+    parser.add_argument("--source", required=True, help="C source to write")
+    args = parser.parse_args()
+
+    try:
+        maps = parse_definitions(args.res)
+        write_outputs(maps, args.res, args.header, args.source)
+    except (OSError, ValueError, ElementTree.ParseError, MapError) as error:
+        sys.exit("map_compiler: %s" % error)
+
+
+if __name__ == "__main__":
+    main()
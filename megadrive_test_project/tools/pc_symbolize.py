@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Resolve a PC-sampling histogram against ELF symbols and print a hot list.
+
+The ROM built by `make profile` writes its PC histogram to the emulator debug
+console (KLog) in blocks like:
+
+    PCS_BEGIN <bucket_shift> <total_samples> <out_of_range_samples>
+    PCS <bucket_start_address_hex> <count>
+    ...
+    PCS_END
+
+This tool reads the last complete block from a captured log, maps every bucket
+onto the functions it overlaps (using `nm -n -S` output, which `make profile`
+writes to out/rom.sym), and prints the functions sorted by sample count.
+
+Usage:
+    pc_symbolize.py --symbols out/rom.sym --log debug_log.txt [--top 30] [--csv]
+    pc_symbolize.py --elf out/rom.elf --nm m68k-elf-nm --log debug_log.txt
+"""
+
+import argparse
+import bisect
+import subprocess
+import sys
+
+# nm symbol types that denote code.
+CODE_SYMBOL_TYPES = set("tTwW")
+
+
+def parse_nm_output(lines):
+    """Returns a sorted list of (address, size, name) for code symbols.
+
+    Symbols without a size (common for hand-written assembly) extend to the
+    next symbol's address.
+    """
+    symbols = []
+    for line in lines:
+        fields = line.split()
+        if len(fields) == 4:
+            address, size, sym_type, name = fields
+            size = int(size, 16)
+        elif len(fields) == 3:
+            address, sym_type, name = fields
+            size = None
+        else:
+            continue
+        if sym_type not in CODE_SYMBOL_TYPES:
+            continue
+        symbols.append([int(address, 16), size, name])
+
+    symbols.sort(key=lambda entry: entry[0])
+    for index, entry in enumerate(symbols):
+        if entry[1] is None:
+            next_address = symbols[index + 1][0] if index + 1 < len(symbols) else entry[0] + 4
+            entry[1] = max(next_address - entry[0], 1)
+    return [tuple(entry) for entry in symbols]
+
+
+def load_symbols(args):
+    if args.symbols:
+        with open(args.symbols, "r", encoding="utf-8", errors="replace") as handle:
+            return parse_nm_output(handle)
+    output = subprocess.run([args.nm, "-n", "-S", args.elf], check=True,
+                            capture_output=True, text=True).stdout
+    return parse_nm_output(output.splitlines())
+
+
+def parse_last_histogram(lines):
+    """Returns (bucket_shift, total, out_of_range, {address: count}) from the last complete block."""
+    result = None
+    current = None
+    for raw_line in lines:
+        # Emulators often prefix debug output; locate our marker anywhere on the line.
+        for marker in ("PCS_BEGIN", "PCS_END", "PCS "):
+            position = raw_line.find(marker)
+            if position >= 0:
+                line = raw_line[position:].split()
+                break
+        else:
+            continue
+
+        if line[0] == "PCS_BEGIN":
+            current = (int(line[1]), int(line[2]), int(line[3]), {})
+        elif line[0] == "PCS_END":
+            if current is not None:
+                result = current
+            current = None
+        elif line[0] == "PCS" and current is not None:
+            current[3][int(line[1], 16)] = current[3].get(int(line[1], 16), 0) + int(line[2])
+    return result
+
+
+def attribute_samples(symbols, bucket_size, buckets):
+    """Spreads each bucket's samples over the functions it overlaps, by overlap size."""
+    starts = [symbol[0] for symbol in symbols]
+    per_function = {}
+    for bucket_start, count in buckets.items():
+        bucket_end = bucket_start + bucket_size
+        index = max(bisect.bisect_right(starts, bucket_start) - 1, 0)
+        overlaps = []
+        while index < len(symbols) and symbols[index][0] < bucket_end:
+            address, size, name = symbols[index]
+            overlap = min(bucket_end, address + size) - max(bucket_start, address)
+            if overlap > 0:
+                overlaps.append((name, overlap))
+            index += 1
+
+        if not overlaps:
+            per_function["<unknown>"] = per_function.get("<unknown>", 0.0) + count
+            continue
+        covered = sum(overlap for _, overlap in overlaps)
+        for name, overlap in overlaps:
+            per_function[name] = per_function.get(name, 0.0) + count * overlap / covered
+    return per_function
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--symbols", help="nm -n -S output for the profiled ELF")
+    source.add_argument("--elf", help="profiled ELF file (requires --nm)")
+    parser.add_argument("--nm", default="m68k-elf-nm", help="nm executable used with --elf")
+    parser.add_argument("--log", required=True, help="captured emulator debug log")
+    parser.add_argument("--top", type=int, default=30, help="number of functions to print")
+    parser.add_argument("--csv", action="store_true", help="print CSV instead of a table")
+    args = parser.parse_args()
+
+    with open(args.log, "r", encoding="utf-8", errors="replace") as handle:
+        histogram = parse_last_histogram(handle)
+    if histogram is None:
+        sys.exit("No complete PCS_BEGIN/PCS_END block found in %s" % args.log)
+
+    bucket_shift, total, out_of_range, buckets = histogram
+    per_function = attribute_samples(load_symbols(args), 1 << bucket_shift, buckets)
+    ranked = sorted(per_function.items(), key=lambda item: item[1], reverse=True)[:args.top]
+
+    if args.csv:
+        print("function,samples,percent")
+        for name, samples in ranked:
+            print("%s,%.1f,%.2f" % (name, samples, 100.0 * samples / max(total, 1)))
+        return
+
+    print("Samples: %d total, %d outside the sampled ROM span" % (total, out_of_range))
+    print("%8s %7s  %s" % ("samples", "percent", "function"))
+    for name, samples in ranked:
+        print("%8.1f %6.2f%%  %s" % (samples, 100.0 * samples / max(total, 1), name))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Run the benchmark ROM headlessly and turn its debug-port output into JSON.
+
+The ROM built by `make bench` walks through the test menu on its own and writes
+one line per benchmarked test to the emulator debug console (KLog):
+
+    BENCH_BEGIN tests=<n> lines_per_frame=<n>
+    BENCH test=<name> frames=<n> avg_lines=<n> max_lines=<n> lag=<n> dma_avg=<n> dma_max=<n> dma_deferred_max=<n>
+    ...
+    BENCH_END total_lag=<n>
+
+This tool either launches an emulator and captures its output, or parses a log
+saved from an earlier run, and writes the results as JSON.
+
+The emulator command is a template; `{rom}` and `{frames}` are substituted.
+It defaults to the BENCH_EMULATOR environment variable, or
+`blastem -b {frames} {rom}` if that is not set. The emulator must print KLog
+output to stdout or stderr.
+
+Usage:
+    run_bench.py --rom out/rom_bench.bin [--out bench.json]
+    run_bench.py --rom out/rom_bench.bin --emulator "my_emu --headless {rom}"
+    run_bench.py --log saved_debug_log.txt [--out bench.json]
+
+Exit status is non-zero if the run did not reach BENCH_END, so the tool can
+gate a CI job.
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+
+DEFAULT_EMULATOR = "blastem -b {frames} {rom}"
+# Enough frames for every test, its settle time and the menu navigation in between.
+DEFAULT_FRAMES = 14000
+
+
+def parse_fields(tokens):
+    """Parses `key=value` tokens into a dict, converting integer values."""
+    fields = {}
+    for token in tokens:
+        if "=" not in token:
+            continue
+        key, value = token.split("=", 1)
+        try:
+            fields[key] = int(value)
+        except ValueError:
+            fields[key] = value
+    return fields
+
+
+def parse_bench_log(lines):
+    """Returns (header, tests, footer) from the last BENCH_BEGIN block in `lines`.
+
+    `footer` is None if the block never reached BENCH_END.
+    """
+    header = None
+    tests = []
+    footer = None
+    for line in lines:
+        # Emulators often prefix debug output (e.g. "KDebug: "), so search for the tag.
+        for tag in ("BENCH_BEGIN", "BENCH_END", "BENCH "):
+            pos = line.find(tag)
+            if pos >= 0:
+                break
+        if pos < 0:
+            continue
+        tokens = line[pos:].split()
+        if tokens[0] == "BENCH_BEGIN":
+            header = parse_fields(tokens[1:])
+            tests = []
+            footer = None
+        elif tokens[0] == "BENCH_END":
+            footer = parse_fields(tokens[1:])
+        elif tokens[0] == "BENCH" and header is not None:
+            tests.append(parse_fields(tokens[1:]))
+    return header, tests, footer
+
+
+def run_emulator(command_template, rom, frames, timeout):
+    """Runs the emulator and returns its combined stdout/stderr lines."""
+    command = command_template.format(rom=rom, frames=frames)
+    try:
+        result = subprocess.run(shlex.split(command), stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True, timeout=timeout)
+        output = result.stdout
+    except subprocess.TimeoutExpired as e:
+        # Emulators without a frame limit are stopped by the timeout; keep what they printed.
+        output = e.stdout or ""
+        if isinstance(output, bytes):
+            output = output.decode("utf-8", "replace")
+    except OSError as e:
+        sys.exit("error: could not run '%s': %s" % (command, e))
+    return output.splitlines()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--rom", help="benchmark ROM to run (built by `make bench`)")
+    source.add_argument("--log", help="parse a saved debug log instead of running an emulator")
+    parser.add_argument("--emulator", default=os.environ.get("BENCH_EMULATOR", DEFAULT_EMULATOR),
+                        help="emulator command template with {rom} and {frames} (default: %(default)s)")
+    parser.add_argument("--frames", type=int, default=DEFAULT_FRAMES,
+                        help="frame limit passed to the emulator as {frames} (default: %(default)s)")
+    parser.add_argument("--timeout", type=int, default=300, help="seconds before the emulator is stopped")
+    parser.add_argument("--out", help="write the JSON report here instead of stdout")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, errors="replace") as f:
+            lines = f.read().splitlines()
+    else:
+        lines = run_emulator(args.emulator, args.rom, args.frames, args.timeout)
+
+    header, tests, footer = parse_bench_log(lines)
+    if header is None:
+        sys.exit("error: no BENCH_BEGIN line found; is the emulator printing KLog output?")
+
+    report = {
+        "lines_per_frame": header.get("lines_per_frame"),
+        "complete": footer is not None,
+        "total_lag": footer.get("total_lag") if footer else None,
+        "tests": tests,
+    }
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+    if footer is None:
+        sys.exit("error: benchmark did not finish (no BENCH_END after %d test(s))" % len(tests))
+
+
+if __name__ == "__main__":
+    main()